@@ -0,0 +1,111 @@
+// attack_bench.cpp
+// Kare saldırı sorgusu: GameManager::isSquareAttacked (kareden geriye bakış)
+// her rakip taş için isValidMove çağıran eski taramayla doğrulanır ve kıyaslanır.
+// Rastgele tahtalarda her dolu kare için sorulur; portallı ölçümde config'deki
+// portallar rastgele cooldown'larla kullanılır. Ardından isInCheck ayrıca ölçülür.
+// Kullanım: attack_bench [config.json] [tahta sayısı]
+#include "ChessBoard.hpp"
+#include "ConfigReader.hpp"
+#include "GameManager.hpp"
+#include "MoveValidator.hpp"
+#include "PortalSystem.hpp"
+#include <chrono>
+#include <iostream>
+#include <random>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const char* const kPieces[] = {"Pawn", "Knight", "Bishop", "Rook", "Queen", "King"};
+
+// Eski isInCheck: şah çeken her rakip taşın hamlesi üretilip hedefe bakılır
+bool scanAttacked(const MoveValidator& validator, const ChessBoard& board,
+                  const PortalSystem& portal_system, const Position& square, bool by_white) {
+  const auto& pieces = board.getPieces(by_white);
+  for (size_t i = 0; i < pieces.size(); ++i) {
+    const std::string& piece = board.typeName(pieces.types[i]);
+    std::string lower = validator.toLowerCase(piece);
+    if (lower != "queen" && lower != "rook" && lower != "bishop" && lower != "knight" &&
+        lower != "pawn") {
+      continue;
+    }
+    if (validator.isValidMove(piece, board.positionOf(pieces.squares[i]), square, by_white, board,
+                              portal_system)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void run(const std::string& label, int size, const std::vector<PortalConfig>& portals,
+         int boards, std::mt19937& rng) {
+  MoveValidator validator;
+  validator.setVerbose(false);
+
+  long long queries = 0, attacked = 0, mismatches = 0, checks = 0;
+  double scan_ns = 0, reverse_ns = 0, in_check_ns = 0;
+  for (int n = 0; n < boards; ++n) {
+    ChessBoard board(size);
+    board.setVerbose(false);
+    int density = 5 + static_cast<int>(rng() % 30);
+    for (int y = 0; y < size; ++y) {
+      for (int x = 0; x < size; ++x) {
+        if (static_cast<int>(rng() % 100) < density) {
+          board.placePiece(kPieces[rng() % 6], rng() % 2 == 0, x, y);
+        }
+      }
+    }
+    PortalSystem portal_system(portals);
+    portal_system.setVerbose(false);
+    std::vector<int> cooldowns = portal_system.getCooldownState();
+    for (int& cooldown : cooldowns) cooldown = static_cast<int>(rng() % 3);
+    portal_system.setCooldownState(cooldowns);
+    GameManager manager(board, validator, portal_system);
+
+    for (int y = 0; y < size; ++y) {
+      for (int x = 0; x < size; ++x) {
+        Position square{x, y};
+        const auto& target = board.getSquare(square);
+        if (target.is_empty()) continue;
+        auto t0 = Clock::now();
+        bool scanned = scanAttacked(validator, board, portal_system, square, !target.is_white);
+        auto t1 = Clock::now();
+        bool reverse = manager.isSquareAttacked(square, !target.is_white);
+        auto t2 = Clock::now();
+        ++queries;
+        if (scanned) ++attacked;
+        if (scanned != reverse) ++mismatches;
+        scan_ns += std::chrono::duration<double, std::nano>(t1 - t0).count();
+        reverse_ns += std::chrono::duration<double, std::nano>(t2 - t1).count();
+      }
+    }
+    auto t0 = Clock::now();
+    for (bool is_white : {true, false}) checks += manager.isInCheck(is_white);
+    in_check_ns += std::chrono::duration<double, std::nano>(Clock::now() - t0).count();
+  }
+  std::cout << label << " " << size << "x" << size << ": " << queries << " sorgu (" << attacked
+            << " saldırı altında), uyuşmazlık " << mismatches << "\n  tarama "
+            << scan_ns / queries << " ns, geriye bakış " << reverse_ns / queries
+            << " ns, hızlanma " << scan_ns / reverse_ns << "x; isInCheck "
+            << in_check_ns / (2.0 * boards) << " ns (" << checks << " şah)\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  std::string config_file = (argc > 1) ? argv[1] : "data/chess_pieces.json";
+  int boards = (argc > 2) ? std::stoi(argv[2]) : 2000;
+
+  ConfigReader config_reader;
+  if (!config_reader.loadFromFile(config_file)) {
+    std::cerr << "Yapılandırma dosyası yüklenemedi\n";
+    return 1;
+  }
+  std::mt19937 rng(50);
+  const auto& portals = config_reader.getConfig().portals;
+  run("portalsız", 8, {}, boards, rng);
+  run("portallı ", 8, portals, boards, rng);
+  run("portalsız", 16, {}, boards / 4, rng);
+  return 0;
+}
@@ -0,0 +1,152 @@
+// error_bench.cpp
+// Geçersiz hamlenin çok olduğu iş yükünde istisnalı ve hata kodlu API'yi
+// karşılaştırır:
+//   movePiece (try/catch)  <-> tryMovePiece
+//   getSquare (try/catch)  <-> tryGetSquare (tahta dışı kareler dahil)
+// Hamleler rastgele kare çiftleridir; çoğu boş kareden ya da kurala aykırıdır.
+// Geçerli hamleden sonra tahta iki modda da aynı şekilde geri yüklenir.
+// Kullanım: error_bench [config.json] [deneme sayısı]
+#include "ChessBoard.hpp"
+#include "ConfigReader.hpp"
+#include "GameManager.hpp"
+#include "MoveValidator.hpp"
+#include "PortalSystem.hpp"
+#include "Ruleset.hpp"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double nanosPer(Clock::time_point start, size_t count) {
+  return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / count;
+}
+
+struct Attempt {
+  Position from;
+  Position to;
+};
+
+struct Outcome {
+  double ns = 0;
+  size_t legal = 0;
+};
+
+template <typename Move>
+Outcome runMoves(const Ruleset& ruleset, const std::vector<Attempt>& attempts, Move&& move) {
+  ChessBoard initial = ruleset.createBoard("none");
+  initial.setVerbose(false);
+  PortalSystem initial_portals = ruleset.createPortals();
+  initial_portals.setVerbose(false);
+
+  ChessBoard board = initial;
+  PortalSystem portals = initial_portals;
+  MoveValidator validator;
+  validator.setVerbose(false);
+  GameManager manager(board, validator, portals);
+
+  Outcome outcome;
+  auto start = Clock::now();
+  for (const auto& attempt : attempts) {
+    if (move(board, validator, portals, manager, attempt)) {
+      ++outcome.legal;
+      board = initial;
+      portals = initial_portals;
+      manager.clearHistory();
+    }
+  }
+  outcome.ns = nanosPer(start, attempts.size());
+  return outcome;
+}
+
+void report(const char* label, double throwing, double plain) {
+  std::cout << std::left << std::setw(24) << label << std::right << std::fixed
+            << std::setprecision(1) << std::setw(12) << throwing << std::setw(14) << plain
+            << std::setw(11) << std::setprecision(2) << throwing / plain << "x\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  std::string config_file = (argc > 1) ? argv[1] : "data/chess_pieces.json";
+  size_t count = (argc > 2) ? std::stoul(argv[2]) : 200000;
+  ConfigReader config_reader;
+  if (!config_reader.loadFromFile(config_file)) {
+    std::cerr << "Yapılandırma dosyası yüklenemedi\n";
+    return 1;
+  }
+  std::shared_ptr<const Ruleset> ruleset = Ruleset::create(config_reader.getConfig());
+  const int size = ruleset->config.game_settings.board_size;
+
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> coordinate(0, size - 1);
+  std::vector<Attempt> attempts(count);
+  for (auto& attempt : attempts) {
+    attempt = {{coordinate(rng), coordinate(rng)}, {coordinate(rng), coordinate(rng)}};
+  }
+
+  Outcome throwing = runMoves(*ruleset, attempts,
+                              [](ChessBoard& board, MoveValidator& validator,
+                                 PortalSystem& portals, GameManager& manager, const Attempt& a) {
+                                try {
+                                  board.movePiece(a.from, a.to, validator, portals, manager,
+                                                  "Queen");
+                                  return true;
+                                } catch (const std::invalid_argument&) {
+                                  return false;
+                                }
+                              });
+  Outcome plain = runMoves(*ruleset, attempts,
+                           [](ChessBoard& board, MoveValidator& validator, PortalSystem& portals,
+                              GameManager& manager, const Attempt& a) {
+                             return board
+                                 .tryMovePiece(a.from, a.to, validator, portals, manager, "Queen")
+                                 .has_value();
+                           });
+  if (throwing.legal != plain.legal) {
+    std::cerr << "Uyuşmazlık: " << throwing.legal << " / " << plain.legal << " geçerli hamle\n";
+    return 1;
+  }
+
+  // Kareler tahtanın iki kare dışına kadar: yaklaşık yarısı tahta dışı
+  ChessBoard board = ruleset->createBoard("none");
+  std::uniform_int_distribution<int> wide(-2, size + 1);
+  std::vector<Position> probes(count);
+  for (auto& probe : probes) probe = {wide(rng), wide(rng)};
+
+  size_t occupied_throwing = 0, occupied_plain = 0, outside = 0;
+  auto start = Clock::now();
+  for (const auto& probe : probes) {
+    try {
+      occupied_throwing += !board.getSquare(probe).is_empty();
+    } catch (const std::out_of_range&) {
+      ++outside;
+    }
+  }
+  double square_throwing = nanosPer(start, count);
+  start = Clock::now();
+  for (const auto& probe : probes) {
+    auto square = board.tryGetSquare(probe);
+    if (square) occupied_plain += !(*square)->is_empty();
+  }
+  double square_plain = nanosPer(start, count);
+  if (occupied_throwing != occupied_plain) {
+    std::cerr << "Uyuşmazlık: kare sorguları farklı sonuç verdi\n";
+    return 1;
+  }
+
+  std::cout << count << " hamle denemesi (" << throwing.legal << " geçerli, %"
+            << std::fixed << std::setprecision(1) << 100.0 * (count - throwing.legal) / count
+            << " geçersiz); " << count << " kare sorgusu (%" << 100.0 * outside / count
+            << " tahta dışı)\n\n";
+  std::cout << std::left << std::setw(24) << "işlem" << std::right << std::setw(12)
+            << "istisna ns" << std::setw(14) << "hata kodu ns" << std::setw(12) << "hızlanma\n";
+  report("hamle (movePiece)", throwing.ns, plain.ns);
+  report("kare (getSquare)", square_throwing, square_plain);
+  return 0;
+}
@@ -0,0 +1,132 @@
+// eval_bench.cpp
+// Artımlı değerlendirme ile her sorguda tüm tahtayı taramayı kıyaslar.
+// Kullanım: eval_bench [config.json] [adım sayısı]
+#include "ChessBoard.hpp"
+#include "ConfigReader.hpp"
+#include "Evaluation.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+
+namespace {
+
+struct Step {
+  Position from;
+  Position to;
+};
+
+// Aynı rastgele taş taşıma dizisini iki ölçüme de vermek için önceden üret.
+// Hedef hep boş kare seçilir, böylece taş sayısı sabit kalır.
+std::vector<Step> makeSteps(ChessBoard board, int count) {
+  std::mt19937 rng(12345);
+  std::vector<Position> occupied;
+  for (int y = 0; y < board.getBoardSize(); ++y) {
+    for (int x = 0; x < board.getBoardSize(); ++x) {
+      if (!board.getSquare({x, y}).is_empty()) occupied.push_back({x, y});
+    }
+  }
+  std::uniform_int_distribution<int> coord(0, board.getBoardSize() - 1);
+  std::vector<Step> steps;
+  steps.reserve(count);
+  while (static_cast<int>(steps.size()) < count && !occupied.empty()) {
+    size_t pick = rng() % occupied.size();
+    Position to{coord(rng), coord(rng)};
+    if (!board.getSquare(to).is_empty()) continue;
+    Position from = occupied[pick];
+    occupied[pick] = to;
+    steps.push_back({from, to});
+    auto square = board.getSquare(from);
+    board.placePiece(square.piece, square.is_white, to.x, to.y);
+    board.placePiece("", false, from.x, from.y);
+  }
+  return steps;
+}
+
+void applyStep(ChessBoard& board, const Step& step) {
+  auto square = board.getSquare(step.from);
+  board.placePiece(square.piece, square.is_white, step.to.x, step.to.y);
+  board.placePiece("", false, step.from.x, step.from.y);
+}
+
+void runForSize(GameConfig config, int board_size, int step_count) {
+  config.game_settings.board_size = board_size;
+  // Boyuta uygun sentetik merkezleşme tablosu
+  std::vector<int> center_table;
+  for (int y = 0; y < board_size; ++y) {
+    for (int x = 0; x < board_size; ++x) {
+      int dx = std::min(x, board_size - 1 - x);
+      int dy = std::min(y, board_size - 1 - y);
+      center_table.push_back(2 * std::min(dx, dy) + y);
+    }
+  }
+  for (auto& piece : config.pieces) piece.evaluation.piece_square_table = center_table;
+  for (auto& piece : config.custom_pieces) piece.evaluation.piece_square_table = center_table;
+  config.evaluation.portal_entry_bonus = 15;
+  config.evaluation.portal_exit_bonus = 10;
+  auto evaluation = std::make_shared<Evaluation>(config);
+
+  ChessBoard start(board_size);
+  start.initializeBoard(config.pieces);
+  auto steps = makeSteps(start, step_count);
+
+  // Doğrulama: her adımda artımlı skor tam taramayla aynı olmalı
+  ChessBoard check = start;
+  check.attachEvaluation(evaluation);
+  for (const auto& step : steps) {
+    applyStep(check, step);
+    if (check.getEvaluation() != evaluation->fullScore(check)) {
+      std::cerr << "Uyuşmazlık: artımlı " << check.getEvaluation() << " tam "
+                << evaluation->fullScore(check) << "\n";
+      return;
+    }
+  }
+
+  using Clock = std::chrono::steady_clock;
+  long long sink = 0;
+
+  ChessBoard incremental = start;
+  incremental.attachEvaluation(evaluation);
+  auto t0 = Clock::now();
+  for (const auto& step : steps) {
+    applyStep(incremental, step);
+    sink += incremental.getEvaluation();
+  }
+  auto t1 = Clock::now();
+
+  ChessBoard rescan = start;
+  auto t2 = Clock::now();
+  for (const auto& step : steps) {
+    applyStep(rescan, step);
+    sink += evaluation->fullScore(rescan);
+  }
+  auto t3 = Clock::now();
+
+  double inc_ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / steps.size();
+  double full_ns = std::chrono::duration<double, std::nano>(t3 - t2).count() / steps.size();
+  std::cout << board_size << "x" << board_size << ": " << steps.size() << " adım, "
+            << "artımlı " << inc_ns << " ns/adım, tam tarama " << full_ns
+            << " ns/adım, hızlanma " << (full_ns / inc_ns) << "x"
+            << " (checksum " << sink << ")\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  std::string config_file = (argc > 1) ? argv[1] : "data/chess_pieces.json";
+  int step_count = (argc > 2) ? std::stoi(argv[2]) : 200000;
+
+  ConfigReader config_reader;
+  if (!config_reader.loadFromFile(config_file)) {
+    std::cerr << "Yapılandırma dosyası yüklenemedi\n";
+    return 1;
+  }
+
+  const GameConfig& config = config_reader.getConfig();
+  runForSize(config, config.game_settings.board_size, step_count);
+  for (int size : {16, 26}) {
+    if (size > config.game_settings.board_size) runForSize(config, size, step_count);
+  }
+  return 0;
+}
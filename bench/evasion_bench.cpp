@@ -0,0 +1,133 @@
+// evasion_bench.cpp
+// Şah altındaki pozisyonlarda yasal hamle üretimini (şah çekenler + açmazlar +
+// kaçış adayları) tüm sözde yasal hamleleri deneyen yöntemle doğrular ve kıyaslar.
+// Pozisyonlar rastgele tahtalardan seçilir; portallı ölçümde config'deki portallar
+// kullanılır. Kullanım: evasion_bench [config.json] [pozisyon sayısı]
+#include "ChessBoard.hpp"
+#include "ConfigReader.hpp"
+#include "GameManager.hpp"
+#include "MoveGenerator.hpp"
+#include "MoveValidator.hpp"
+#include "PortalSystem.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const char* const kPieces[] = {"Pawn", "Knight", "Bishop", "Rook", "Queen"};
+
+// Tüm sözde yasal hamleleri oynayıp şahı kontrol eden referans
+std::vector<CoordinateMove> bruteForceLegal(const MoveGenerator& generator,
+                                            const ChessBoard& board,
+                                            PortalSystem& portal_system, bool is_white) {
+  std::vector<CoordinateMove> legal;
+  std::vector<int> saved = portal_system.getCooldownState();
+  for (const auto& move : generator.pseudoLegalMoves(board, portal_system, is_white)) {
+    ChessBoard next = board;
+    next.setVerbose(false);
+    generator.makeMove(next, portal_system, move);
+    if (!generator.inCheck(next, portal_system, is_white)) legal.push_back(move);
+    portal_system.setCooldownState(saved);
+  }
+  return legal;
+}
+
+bool sameMoves(std::vector<CoordinateMove> a, std::vector<CoordinateMove> b) {
+  auto key = [](const CoordinateMove& m) {
+    return std::make_tuple(m.from.y, m.from.x, m.to.y, m.to.x, m.promotion);
+  };
+  auto less = [&](const CoordinateMove& x, const CoordinateMove& y) { return key(x) < key(y); };
+  std::sort(a.begin(), a.end(), less);
+  std::sort(b.begin(), b.end(), less);
+  return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [&](auto& x, auto& y) {
+           return key(x) == key(y);
+         });
+}
+
+void run(const std::string& label, int size, const std::vector<PortalConfig>& portals,
+         int wanted, std::mt19937& rng) {
+  MoveValidator validator;
+  validator.setVerbose(false);
+  MoveGenerator generator(validator);
+
+  int in_check = 0, tried = 0, mismatches = 0, mates = 0, quiet_checked = 0;
+  double fast_us = 0, brute_us = 0, mate_us = 0;
+  while (in_check < wanted && tried < wanted * 2000) {
+    ++tried;
+    ChessBoard board(size);
+    board.setVerbose(false);
+    int density = 5 + static_cast<int>(rng() % 20);
+    for (int y = 0; y < size; ++y) {
+      for (int x = 0; x < size; ++x) {
+        if (static_cast<int>(rng() % 100) < density) {
+          board.placePiece(kPieces[rng() % 5], rng() % 2 == 0, x, y);
+        }
+      }
+    }
+    board.placePiece("King", true, static_cast<int>(rng() % size), static_cast<int>(rng() % size));
+    board.placePiece("King", false, static_cast<int>(rng() % size), static_cast<int>(rng() % size));
+    PortalSystem portal_system(portals);
+    portal_system.setVerbose(false);
+    bool is_white = rng() % 2 == 0;
+
+    auto info = generator.analyzeChecks(board, portal_system, is_white);
+    if (info.inCheck() != generator.inCheck(board, portal_system, is_white)) ++mismatches;
+    if (generator.inCheck(board, portal_system, !is_white)) continue;
+    if (!info.inCheck()) {
+      // Şah altında olmayan pozisyonlarda açmaz kısayolunu da doğrula
+      if (quiet_checked < wanted) {
+        ++quiet_checked;
+        if (!sameMoves(generator.legalMoves(board, portal_system, is_white),
+                       bruteForceLegal(generator, board, portal_system, is_white))) {
+          ++mismatches;
+        }
+      }
+      continue;
+    }
+    ++in_check;
+
+    auto t0 = Clock::now();
+    auto fast = generator.legalMoves(board, portal_system, is_white);
+    auto t1 = Clock::now();
+    auto brute = bruteForceLegal(generator, board, portal_system, is_white);
+    auto t2 = Clock::now();
+    GameManager manager(board, validator, portal_system);
+    bool mate = manager.isCheckmate(is_white);
+    auto t3 = Clock::now();
+
+    if (!sameMoves(fast, brute) || mate != brute.empty()) ++mismatches;
+    if (mate) ++mates;
+    fast_us += std::chrono::duration<double, std::micro>(t1 - t0).count();
+    brute_us += std::chrono::duration<double, std::micro>(t2 - t1).count();
+    mate_us += std::chrono::duration<double, std::micro>(t3 - t2).count();
+  }
+  std::cout << label << " " << size << "x" << size << ": " << in_check
+            << " şah pozisyonu (" << mates << " mat), " << quiet_checked
+            << " şahsız pozisyon; uyuşmazlık " << mismatches
+            << "\n  kaçış üretimi " << fast_us / in_check << " us, tüm hamleleri deneme "
+            << brute_us / in_check << " us, hızlanma " << brute_us / fast_us
+            << "x; isCheckmate " << mate_us / in_check << " us\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  std::string config_file = (argc > 1) ? argv[1] : "data/chess_pieces.json";
+  int wanted = (argc > 2) ? std::stoi(argv[2]) : 300;
+
+  ConfigReader config_reader;
+  if (!config_reader.loadFromFile(config_file)) {
+    std::cerr << "Yapılandırma dosyası yüklenemedi\n";
+    return 1;
+  }
+  std::mt19937 rng(35);
+  const auto& portals = config_reader.getConfig().portals;
+  run("portalsız", 8, {}, wanted, rng);
+  run("portallı ", 8, portals, wanted, rng);
+  run("portalsız", 16, {}, wanted, rng);
+  return 0;
+}
@@ -0,0 +1,158 @@
+// gamedb_bench.cpp
+// Rastgele yasal hamlelerle oynanmış oyunları depoya yazar: her oyunda fsync
+// ile toplu fsync'i kıyaslar, mmap okuyucunun açılışını, indeks kurulumunu ve
+// "bu pozisyona ulaşan oyunlar" aramasını ölçer. Her (oyun, yarım
+// hamle) çiftinin aramada bulunduğu da doğrulanır.
+// Kullanım: gamedb_bench [config.json] [oyun sayısı] [geçici dizin]
+#include "ChessBoard.hpp"
+#include "ConfigReader.hpp"
+#include "GameDatabase.hpp"
+#include "MoveGenerator.hpp"
+#include "MoveValidator.hpp"
+#include "PortalSystem.hpp"
+#include "Zobrist.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <random>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double elapsedMs(Clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+constexpr int kMaxPlies = 60;
+constexpr size_t kSyncedGames = 200; // her oyunda fsync ölçümü için
+
+struct PlayedGame {
+  GameDatabase::GameRecord record;
+  std::vector<uint64_t> keys; // yarım hamle başına pozisyon anahtarı (son pozisyon dahil)
+};
+
+// İlk hamleler az sayıda açılıştan seçilir ki pozisyonlar oyunlar arasında paylaşılsın
+PlayedGame playGame(const GameConfig& config, const ChessBoard& initial,
+                    const MoveGenerator& generator, std::mt19937& rng) {
+  PlayedGame game;
+  game.record.config_hash = config.config_hash;
+  game.record.board_size = config.game_settings.board_size;
+  game.record.metadata = {{"Event", config.game_settings.name}, {"White", "random"},
+                          {"Black", "random"}};
+
+  ChessBoard board = initial;
+  PortalSystem portal_system(config.portals);
+  portal_system.setVerbose(false);
+  bool is_white = true;
+  for (int ply = 0; ply < kMaxPlies; ++ply) {
+    game.keys.push_back(zobrist::positionKey(board.getHash(), portal_system.stateHash(), is_white));
+    auto moves = generator.legalMoves(board, portal_system, is_white);
+    if (moves.empty()) {
+      bool mated = generator.inCheck(board, portal_system, is_white);
+      game.record.result = !mated ? GameDatabase::Result::Draw
+                           : is_white ? GameDatabase::Result::BlackWins
+                                      : GameDatabase::Result::WhiteWins;
+      return game;
+    }
+    size_t choices = ply < 4 ? std::min<size_t>(3, moves.size()) : moves.size();
+    const CoordinateMove& move = moves[rng() % choices];
+    generator.makeMove(board, portal_system, move);
+    game.record.moves.push_back(move);
+    is_white = !is_white;
+  }
+  game.keys.push_back(zobrist::positionKey(board.getHash(), portal_system.stateHash(), is_white));
+  return game;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  std::string config_file = (argc > 1) ? argv[1] : "data/chess_pieces.json";
+  size_t game_count = (argc > 2) ? std::stoul(argv[2]) : 2000;
+  std::string directory = (argc > 3) ? argv[3] : "/tmp";
+
+  ConfigReader config_reader;
+  if (!config_reader.loadFromFile(config_file)) {
+    std::cerr << "Yapılandırma dosyası yüklenemedi\n";
+    return 1;
+  }
+  const GameConfig& config = config_reader.getConfig();
+  std::vector<PieceConfig> all_pieces = config.pieces;
+  all_pieces.insert(all_pieces.end(), config.custom_pieces.begin(), config.custom_pieces.end());
+  ChessBoard initial(config.game_settings.board_size);
+  initial.initializeBoard(all_pieces);
+  initial.setVerbose(false);
+  MoveValidator validator;
+  validator.setVerbose(false);
+  MoveGenerator generator(validator);
+
+  std::mt19937 rng(36);
+  std::vector<PlayedGame> games;
+  size_t total_plies = 0;
+  for (size_t i = 0; i < game_count; ++i) {
+    games.push_back(playGame(config, initial, generator, rng));
+    total_plies += games.back().record.moves.size();
+  }
+  std::cout << game_count << " oyun, " << total_plies << " yarım hamle üretildi\n";
+
+  std::string synced_path = directory + "/gamedb_bench_synced.games";
+  std::string db_path = directory + "/gamedb_bench.games";
+  std::string index_path = db_path + ".idx";
+  std::remove(synced_path.c_str());
+  std::remove(db_path.c_str());
+
+  size_t synced = std::min(kSyncedGames, games.size());
+  auto start = Clock::now();
+  {
+    GameDatabase::Writer writer(1);
+    if (!writer.open(synced_path)) return 1;
+    for (size_t i = 0; i < synced; ++i) writer.append(games[i].record);
+  }
+  double synced_ms = elapsedMs(start);
+
+  start = Clock::now();
+  {
+    GameDatabase::Writer writer(256);
+    if (!writer.open(db_path)) return 1;
+    for (const auto& game : games) writer.append(game.record);
+  }
+  double batched_ms = elapsedMs(start);
+  std::cout << "yazma, her oyunda fsync: " << synced * 1000.0 / synced_ms << " oyun/s (" << synced
+            << " oyun)\n";
+  std::cout << "yazma, 256 oyunda fsync: " << games.size() * 1000.0 / batched_ms << " oyun/s\n";
+
+  GameDatabase database;
+  start = Clock::now();
+  if (!database.open(db_path)) return 1;
+  std::cout << "okuyucu açılışı: " << elapsedMs(start) << " ms (" << database.size() << " oyun)\n";
+
+  start = Clock::now();
+  if (!database.writeIndex(index_path, config) || !database.openIndex(index_path)) return 1;
+  std::cout << "indeks kurulumu: " << elapsedMs(start) << " ms\n";
+
+  // Her oyunun her pozisyonu aranır; oyun sonuçta bulunmalı
+  size_t lookups = 0, missing = 0, matches = 0;
+  start = Clock::now();
+  for (size_t id = 0; id < games.size(); ++id) {
+    for (uint64_t key : games[id].keys) {
+      auto found = database.gamesReaching(key);
+      matches += found.size();
+      ++lookups;
+      bool present = std::any_of(found.begin(), found.end(), [id](const auto& entry) {
+        return entry.game == id;
+      });
+      if (!present) ++missing;
+    }
+  }
+  double lookup_ms = elapsedMs(start);
+  std::cout << "arama: " << lookups << " pozisyon, ortalama " << lookup_ms * 1000.0 / lookups
+            << " µs, ortalama " << static_cast<double>(matches) / lookups << " oyun, "
+            << missing << " eksik\n";
+
+  std::remove(synced_path.c_str());
+  std::remove(db_path.c_str());
+  std::remove(index_path.c_str());
+  return missing == 0 ? 0 : 1;
+}
@@ -0,0 +1,182 @@
+// kernel_bench.cpp
+// Boyuta özel (constexpr tablolu) hareket çekirdeklerini genel çekirdekle, genel
+// çekirdeği de çekirdek öncesi yön yürüyüşüyle (taban) kıyaslar, ardından tahtanın seçtiği çekirdekle uçtan uca sözde yasal hamle üretimini ölçer.
+// Kullanım: kernel_bench [tekrar sayısı]
+#include "BoardKernels.hpp"
+#include "ChessBoard.hpp"
+#include "MoveGenerator.hpp"
+#include "MoveValidator.hpp"
+#include "PortalSystem.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+
+namespace {
+
+const char* const kPieces[] = {"Pawn", "Knight", "Bishop", "Rook", "Queen", "King"};
+
+// Tahtanın yaklaşık dörtte biri rastgele taşlarla dolu
+ChessBoard randomBoard(int size, unsigned seed) {
+  ChessBoard board(size);
+  std::mt19937 rng(seed);
+  for (int y = 0; y < size; ++y) {
+    for (int x = 0; x < size; ++x) {
+      if (rng() % 4 != 0) continue;
+      board.placePiece(kPieces[rng() % 6], rng() % 2 == 0, x, y);
+    }
+  }
+  return board;
+}
+
+struct Job {
+  PieceKind kind;
+  Position pos;
+  bool is_white;
+};
+
+// Türler tip tablosundan önceden alınır
+std::vector<Job> jobsOf(const ChessBoard& board) {
+  std::vector<Job> jobs;
+  for (bool is_white : {true, false}) {
+    const auto& pieces = board.getPieces(is_white);
+    for (size_t i = 0; i < pieces.size(); ++i) {
+      jobs.push_back({board.typeKind(pieces.types[i]), board.positionOf(pieces.squares[i]),
+                      is_white});
+    }
+  }
+  return jobs;
+}
+
+// Çekirdekler öncesi getMoveEdges döngüsü: yön başına isInBounds/getSquare
+void baselineEdges(PieceKind kind, const Position& pos, bool is_white, const ChessBoard& board,
+                   std::vector<Position>& edges) {
+  static const std::pair<int, int> kSteps[8] = {{0, 1}, {0, -1}, {1, 0},  {-1, 0},
+                                                {1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+  static const std::pair<int, int> kJumps[8] = {{2, 1}, {2, -1}, {-2, 1}, {-2, -1},
+                                                {1, 2}, {1, -2}, {-1, 2}, {-1, -2}};
+  auto leap = [&](const std::pair<int, int>* steps) {
+    for (int i = 0; i < 8; ++i) {
+      Position p = {pos.x + steps[i].first, pos.y + steps[i].second};
+      if (!board.isInBounds(p)) continue;
+      const auto& target = board.getSquare(p);
+      if (target.is_empty() || target.is_white != is_white) edges.push_back(p);
+    }
+  };
+  auto ride = [&](int first, int last) {
+    for (int d = first; d < last; ++d) {
+      for (int i = 1; i < board.getBoardSize(); ++i) {
+        Position p = {pos.x + i * kSteps[d].first, pos.y + i * kSteps[d].second};
+        if (!board.isInBounds(p)) break;
+        edges.push_back(p);
+        if (!board.getSquare(p).is_empty()) break;
+      }
+    }
+  };
+  int forward = is_white ? 1 : -1;
+  switch (kind) {
+  case PieceKind::Pawn: {
+    Position one = {pos.x, pos.y + forward};
+    if (board.isInBounds(one) && board.getSquare(one).is_empty()) {
+      edges.push_back(one);
+      Position two = {pos.x, pos.y + 2 * forward};
+      if (((is_white && pos.y == 1) || (!is_white && pos.y == 6)) && board.isInBounds(two) &&
+          board.getSquare(two).is_empty()) {
+        edges.push_back(two);
+      }
+    }
+    for (int dx : {-1, 1}) {
+      Position p = {pos.x + dx, pos.y + forward};
+      if (!board.isInBounds(p)) continue;
+      const auto& target = board.getSquare(p);
+      if (!target.is_empty() && target.is_white != is_white) edges.push_back(p);
+    }
+    break;
+  }
+  case PieceKind::Knight: leap(kJumps); break;
+  case PieceKind::Bishop: ride(4, 8); break;
+  case PieceKind::Rook: ride(0, 4); break;
+  case PieceKind::Queen: ride(0, 8); break;
+  case PieceKind::King: leap(kSteps); break;
+  case PieceKind::Other: break;
+  }
+}
+
+double baselineNs(const ChessBoard& board, int repeat, size_t& sink) {
+  std::vector<Job> jobs = jobsOf(board);
+  std::vector<Position> edges;
+  edges.reserve(64);
+  auto t0 = std::chrono::steady_clock::now();
+  for (int r = 0; r < repeat; ++r) {
+    for (const auto& job : jobs) {
+      edges.clear();
+      baselineEdges(job.kind, job.pos, job.is_white, board, edges);
+      sink += edges.size();
+    }
+  }
+  return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() /
+         (static_cast<double>(repeat) * static_cast<double>(jobs.size()));
+}
+
+double kernelNs(const MoveKernels& kernels, const ChessBoard& board, int repeat, size_t& sink) {
+  std::vector<Job> jobs = jobsOf(board);
+  std::vector<Position> edges;
+  edges.reserve(64);
+  auto t0 = std::chrono::steady_clock::now();
+  for (int r = 0; r < repeat; ++r) {
+    for (const auto& job : jobs) {
+      edges.clear();
+      kernels.edges(job.kind, job.pos, job.is_white, board.rawSquares(), edges);
+      sink += edges.size();
+    }
+  }
+  return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() /
+         (static_cast<double>(repeat) * static_cast<double>(jobs.size()));
+}
+
+// Makine gürültüsüne karşı birkaç denemenin en küçüğü
+template <class Measure>
+double fastest(Measure measure) {
+  double best = measure();
+  for (int trial = 1; trial < 5; ++trial) best = std::min(best, measure());
+  return best;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  int repeat = (argc > 1) ? std::stoi(argv[1]) : 2000;
+  size_t sink = 0;
+
+  MoveValidator validator;
+  validator.setVerbose(false);
+  MoveGenerator generator(validator);
+  PortalSystem portal_system(std::vector<PortalConfig>{});
+  portal_system.setVerbose(false);
+
+  for (int size : {8, 10, 12, 16, 9, 20}) {
+    ChessBoard board = randomBoard(size, 777u + static_cast<unsigned>(size));
+    const MoveKernels& selected = MoveKernels::forSize(size);
+    double specialized_ns = fastest([&] { return kernelNs(selected, board, repeat, sink); });
+    double generic_ns =
+        fastest([&] { return kernelNs(MoveKernels::generic(size), board, repeat, sink); });
+    double baseline_ns = fastest([&] { return baselineNs(board, repeat, sink); });
+
+    auto t0 = std::chrono::steady_clock::now();
+    int move_repeat = std::max(1, repeat / 20);
+    for (int r = 0; r < move_repeat; ++r) {
+      sink += generator.pseudoLegalMoves(board, portal_system, r % 2 == 0).size();
+    }
+    double movegen_us =
+        std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count() /
+        move_repeat;
+
+    std::cout << size << "x" << size << (selected.isSpecialized() ? " (özel)  " : " (genel)  ")
+              << "çekirdek " << specialized_ns << " ns/taş, genel " << generic_ns
+              << " ns/taş (oran " << generic_ns / specialized_ns << "x), taban " << baseline_ns
+              << " ns/taş (genel/taban " << generic_ns / baseline_ns << "x); sözde yasal üretim "
+              << movegen_us << " us/pozisyon\n";
+  }
+  std::cout << "(checksum " << sink << ")\n";
+  return 0;
+}
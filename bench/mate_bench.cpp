@@ -0,0 +1,102 @@
+// mate_bench.cpp
+// Mat çözücüsünün hızı: bulmaca dosyasındaki her pozisyon boş tabloyla çözülür,
+// bulunan mat uzunluğu (veya matın yokluğu) beklenenle karşılaştırılır; düğüm,
+// süre ve düğüm/sn yazılır. Aynı pozisyonlar 2N-1 yarım hamle derinliğinde
+// alfa-beta ile de aranır (tam genişlik, sessiz hamleler dahil).
+// Kullanım: mate_bench [config.json] [bulmaca dosyası] [hash MB]
+#include "ConfigReader.hpp"
+#include "MateSolver.hpp"
+#include "MoveValidator.hpp"
+#include "PositionParser.hpp"
+#include "Ruleset.hpp"
+#include "Search.hpp"
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+int main(int argc, char* argv[]) {
+  std::string config_file = (argc > 1) ? argv[1] : "data/chess_pieces.json";
+  std::string puzzle_file = (argc > 2) ? argv[2] : "data/mate_puzzles.txt";
+  size_t hash_mb = (argc > 3) ? std::stoul(argv[3]) : 16;
+
+  ConfigReader config_reader;
+  if (!config_reader.loadFromFile(config_file)) {
+    std::cerr << "Yapılandırma dosyası yüklenemedi\n";
+    return 1;
+  }
+  std::shared_ptr<const Ruleset> ruleset = Ruleset::create(config_reader.getConfig());
+  PositionParser parser(ruleset->config, ruleset->evaluation, ruleset->network);
+  std::ifstream in(puzzle_file);
+  if (!in) {
+    std::cerr << "Bulmaca dosyası açılamadı: " << puzzle_file << "\n";
+    return 1;
+  }
+
+  MateSolver solver(hash_mb);
+  MoveValidator validator;
+  validator.setVerbose(false);
+  std::cout << "  #  N  beklenen  sonuç      düğüm   hash     ms    düğüm/sn  "
+               "alfa-beta düğüm     ms  çizgi\n";
+  int count = 0, failures = 0;
+  uint64_t total_nodes = 0, total_ab_nodes = 0;
+  double total_ms = 0, total_ab_ms = 0;
+  std::string line;
+  while (std::getline(in, line)) {
+    if (line.empty() || line[0] == '#') continue;
+    std::istringstream iss(line);
+    std::string expected;
+    int moves = 0;
+    iss >> expected >> moves;
+    std::string text;
+    std::getline(iss >> std::ws, text);
+    PositionParser::Setup setup;
+    std::string error;
+    if (moves <= 0 || !parser.parse(text, setup, error)) {
+      std::cerr << "Okunamayan satır: " << line << " " << error << "\n";
+      ++failures;
+      continue;
+    }
+
+    solver.clear();
+    MateSolver::Result result = solver.solve(*setup.board, *setup.portals, setup.is_white, moves);
+    std::string found = result.outcome == MateSolver::Outcome::Mate     ? std::to_string(result.moves)
+                        : result.outcome == MateSolver::Outcome::NoMate ? "-"
+                                                                        : "?";
+    bool ok = found == expected;
+    if (!ok) ++failures;
+
+    Search search(*ruleset->evaluation, validator);
+    SearchLimits limits;
+    limits.max_depth = 2 * moves - 1;
+    PortalSystem portals = *setup.portals;
+    auto t0 = std::chrono::steady_clock::now();
+    SearchResult ab = search.iterate(*setup.board, portals, setup.is_white, limits);
+    double ab_ms = std::chrono::duration<double, std::milli>(
+                       std::chrono::steady_clock::now() - t0).count();
+
+    std::string pv;
+    for (const auto& move : result.line) pv += " " + formatCoordinateMove(move);
+    std::cout << std::setw(3) << ++count << std::setw(3) << moves << std::setw(10) << expected
+              << "  " << std::left << std::setw(6) << (found + (ok ? "" : " !")) << std::right
+              << std::setw(10) << result.nodes << std::setw(7) << result.hash_hits << std::fixed
+              << std::setprecision(1) << std::setw(7) << result.elapsed_ms << std::setprecision(0)
+              << std::setw(12) << result.nodes / (result.elapsed_ms / 1000.0 + 1e-9)
+              << std::setw(17) << ab.nodes << std::setprecision(1) << std::setw(7) << ab_ms
+              << " " << pv << "\n";
+    total_nodes += result.nodes;
+    total_ms += result.elapsed_ms;
+    total_ab_nodes += ab.nodes;
+    total_ab_ms += ab_ms;
+  }
+
+  std::cout << "\n" << count << " bulmaca, " << failures << " hata\n"
+            << "df-pn:     " << total_nodes << " düğüm, " << std::setprecision(1) << total_ms
+            << " ms, " << std::setprecision(0) << total_nodes / (total_ms / 1000.0 + 1e-9)
+            << " düğüm/sn\n"
+            << "alfa-beta: " << total_ab_nodes << " düğüm, " << std::setprecision(1)
+            << total_ab_ms << " ms\n";
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,91 @@
+// mcts_bench.cpp
+// MCTS'in thread sayısıyla ölçeklenmesi: başlangıç pozisyonunda sabit süre
+// boyunca rastgele oyun/sn, ağaç boyutu ve seçilen hamle. Ardından bir oyun
+// MCTS'e karşı MCTS oynanır ve her hamlede önceki aramadan devralınan düğüm
+// sayısı yazılır (ağacın yeniden kullanımı).
+// Kullanım: mcts_bench [config.json] [hamle başına ms] [en fazla thread] [oyun yarım hamlesi]
+#include "ConfigReader.hpp"
+#include "Mcts.hpp"
+#include "MoveGenerator.hpp"
+#include "MoveValidator.hpp"
+#include "Ruleset.hpp"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace {
+
+Mcts::Limits limitsFor(int movetime_ms) {
+  Mcts::Limits limits;
+  limits.deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(movetime_ms);
+  return limits;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  std::string config_file = (argc > 1) ? argv[1] : "data/chess_pieces.json";
+  int movetime_ms = (argc > 2) ? std::stoi(argv[2]) : 2000;
+  unsigned max_threads = (argc > 3) ? static_cast<unsigned>(std::stoul(argv[3]))
+                                    : std::max(4u, std::thread::hardware_concurrency());
+  int game_plies = (argc > 4) ? std::stoi(argv[4]) : 6;
+
+  ConfigReader config_reader;
+  if (!config_reader.loadFromFile(config_file)) {
+    std::cerr << "Yapılandırma dosyası yüklenemedi\n";
+    return 1;
+  }
+  std::shared_ptr<const Ruleset> ruleset = Ruleset::create(config_reader.getConfig());
+  ChessBoard board = ruleset->createBoard("none");
+  board.setVerbose(false);
+  PortalSystem portals = ruleset->createPortals();
+  portals.setVerbose(false);
+  int rollout_plies = 2 * ruleset->config.game_settings.turn_limit;
+
+  std::cout << ruleset->config.game_settings.board_size << "x"
+            << ruleset->config.game_settings.board_size << ", rastgele oyun en fazla "
+            << rollout_plies << " yarım hamle, hamle başına " << movetime_ms
+            << " ms, donanım thread: " << std::thread::hardware_concurrency() << "\n\n"
+            << "thread   oyun   oyun/sn  hızlanma    ağaç  ziyaret  kazanma  hamle\n";
+  double base_rate = 0;
+  for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+    Mcts::Options options;
+    options.threads = threads;
+    options.rollout_plies = rollout_plies;
+    Mcts mcts(options);
+    Mcts::Result result = mcts.search(board, portals, true, limitsFor(movetime_ms));
+    double rate = result.rollouts / (result.elapsed_ms / 1000.0);
+    if (threads == 1) base_rate = rate;
+    std::cout << std::setw(6) << threads << std::setw(7) << result.rollouts << std::setw(10)
+              << std::fixed << std::setprecision(1) << rate << std::setw(9)
+              << std::setprecision(2) << (base_rate > 0 ? rate / base_rate : 1.0) << "x"
+              << std::setw(8) << result.tree_nodes << std::setw(9) << result.best_visits
+              << std::setw(9) << std::setprecision(3) << result.win_rate << "  "
+              << (result.has_move ? formatCoordinateMove(result.best_move) : "-") << "\n";
+  }
+
+  // İki taraf aynı ağacı kullanır: her arama bir önceki kökün torununu değil
+  // çocuğunu bulur
+  std::cout << "\noyun (" << max_threads << " thread)\nply  hamle    oyun    ağaç  devralınan\n";
+  MoveValidator validator;
+  validator.setVerbose(false);
+  MoveGenerator generator(validator);
+  Mcts::Options options;
+  options.threads = max_threads;
+  options.rollout_plies = rollout_plies;
+  Mcts mcts(options);
+  bool is_white = true;
+  for (int ply = 0; ply < game_plies; ++ply) {
+    Mcts::Result result = mcts.search(board, portals, is_white, limitsFor(movetime_ms));
+    if (!result.has_move) break;
+    std::cout << std::setw(3) << ply + 1 << "  " << std::setw(6)
+              << formatCoordinateMove(result.best_move) << std::setw(8) << result.rollouts
+              << std::setw(8) << result.tree_nodes << std::setw(12) << result.reused_nodes
+              << "\n";
+    generator.makeMove(board, portals, result.best_move);
+    is_white = !is_white;
+  }
+  return 0;
+}
@@ -0,0 +1,138 @@
+// memory_bench.cpp
+// Aynı anda açık N oyunun heap maliyetini ölçer (1, 1000, 100000 oyun):
+//   bağımsız: her oyun kendi config kopyasını ve değerlendirme tablolarını tutar
+//   kopyalı : değerlendirme paylaşılır, portal listesi ve tip tablosu oyun başına
+//   paylaşımlı: taş tipleri, portal ve değerlendirme tabloları Ruleset'te tek kopya
+// Her oyunda iki hamle oynanır; böylece hamle geçmişi de ölçüme girer.
+// Kullanım: memory_bench [config.json]
+#include "ChessBoard.hpp"
+#include "ConfigReader.hpp"
+#include "Evaluation.hpp"
+#include "GameManager.hpp"
+#include "MoveValidator.hpp"
+#include "PortalSystem.hpp"
+#include "Ruleset.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <malloc.h>
+#include <memory>
+#include <new>
+#include <optional>
+#include <vector>
+
+namespace {
+
+// mallinfo, thread önbelleğindeki boş blokları da kullanımda sayar; bu yüzden
+// canlı bayt operator new/delete üzerinden tutulur
+std::atomic<size_t> live_bytes{0};
+
+size_t heapInUse() {
+  return live_bytes;
+}
+
+// Bir oyunun tuttuğu her şey; GameManager tahta ve portallara referans tutar
+struct Game {
+  std::optional<GameConfig> config;  // yalnızca bağımsız modda
+  ChessBoard board;
+  PortalSystem portals;
+  GameManager manager;
+
+  Game(ChessBoard board_in, PortalSystem portals_in, MoveValidator& validator)
+      : board(std::move(board_in)), portals(std::move(portals_in)),
+        manager(board, validator, portals) {
+    board.setVerbose(false);
+    portals.setVerbose(false);
+  }
+};
+
+enum class Mode { Independent, Copied, Shared };
+
+std::unique_ptr<Game> newGame(Mode mode, const Ruleset& ruleset,
+                              const std::vector<PieceConfig>& all_pieces,
+                              MoveValidator& validator) {
+  const GameConfig& config = ruleset.config;
+  if (mode == Mode::Shared) {
+    return std::make_unique<Game>(ruleset.createBoard(), ruleset.createPortals(), validator);
+  }
+  ChessBoard board(config.game_settings.board_size);
+  board.initializeBoard(all_pieces);
+  if (mode == Mode::Copied) {
+    board.attachEvaluation(ruleset.evaluation);
+    return std::make_unique<Game>(std::move(board), PortalSystem(config.portals), validator);
+  }
+  GameConfig own = config;
+  board.attachEvaluation(std::make_shared<const Evaluation>(own));
+  auto game = std::make_unique<Game>(std::move(board), PortalSystem(own.portals), validator);
+  game->config = std::move(own);
+  return game;
+}
+
+void playOpening(Game& game, MoveValidator& validator) {
+  game.board.movePiece({4, 1}, {4, 3}, validator, game.portals, game.manager);
+  game.board.movePiece({4, 6}, {4, 4}, validator, game.portals, game.manager);
+}
+
+} // namespace
+
+void* operator new(size_t size) {
+  void* ptr = std::malloc(size ? size : 1);
+  if (!ptr) throw std::bad_alloc();
+  live_bytes += malloc_usable_size(ptr);
+  return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+  if (!ptr) return;
+  live_bytes -= malloc_usable_size(ptr);
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+  operator delete(ptr);
+}
+
+int main(int argc, char* argv[]) {
+  std::string config_file = (argc > 1) ? argv[1] : "data/chess_pieces.json";
+  ConfigReader config_reader;
+  if (!config_reader.loadFromFile(config_file)) {
+    std::cerr << "Yapılandırma dosyası yüklenemedi\n";
+    return 1;
+  }
+
+  size_t before = heapInUse();
+  std::shared_ptr<const Ruleset> ruleset = Ruleset::create(config_reader.getConfig());
+  std::cout << "Kural seti (bir kez): " << (heapInUse() - before) << " bayt\n\n";
+
+  std::vector<PieceConfig> all_pieces = ruleset->config.pieces;
+  all_pieces.insert(all_pieces.end(), ruleset->config.custom_pieces.begin(),
+                    ruleset->config.custom_pieces.end());
+  MoveValidator validator;
+  validator.setVerbose(false);
+
+  const std::pair<Mode, const char*> modes[] = {
+      {Mode::Independent, "bağımsız  "}, {Mode::Copied, "kopyalı   "}, {Mode::Shared, "paylaşımlı"}};
+  std::cout << "mod         oyun     bayt/oyun   toplam MB   kurulum µs/oyun\n";
+  for (size_t count : {size_t{1}, size_t{1000}, size_t{100000}}) {
+    for (const auto& [mode, label] : modes) {
+      std::vector<std::unique_ptr<Game>> games;
+      games.reserve(count);
+      size_t start = heapInUse();
+      auto t0 = std::chrono::steady_clock::now();
+      for (size_t i = 0; i < count; ++i) {
+        games.push_back(newGame(mode, *ruleset, all_pieces, validator));
+        playOpening(*games.back(), validator);
+      }
+      double micros =
+          std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+      // unique_ptr dizisi ölçüme dahil değil: reserve'den önce ayrıldı
+      size_t bytes = heapInUse() - start;
+      std::cout << label << "  " << std::setw(6) << count << "  " << std::setw(12)
+                << bytes / count << "  " << std::setw(10) << std::fixed << std::setprecision(1)
+                << bytes / 1e6 << "  " << std::setw(12) << micros / count << "\n";
+    }
+  }
+  return 0;
+}
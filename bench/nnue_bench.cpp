@@ -0,0 +1,192 @@
+// nnue_bench.cpp
+// NNUE değerlendirmesinin maliyeti:
+//   - rastgele bir oyun boyunca artımlı birikecin baştan kurulanla aynı kaldığı
+//     ve çıkış katmanı sıfır olan ağın el yapımı değerlendirmeyle aynı olduğu,
+//   - çekirdek sürümlerinin (skaler, SSE2, AVX2) aynı skoru verdiği doğrulanır,
+//   - hamle başına güncelleme, baştan kurma ve ağ hesabı süreleri ölçülür,
+//   - aynı derinlikte arama tablo değerlendirmesiyle ve ağla koşulur.
+// Ağ, config'in tablolarından üretilip geçici dosyaya yazılır ve mmap ile açılır.
+// Kullanım: nnue_bench [config.json] [hidden] [arama derinliği] [ağ dosyası]
+#include "ConfigReader.hpp"
+#include "MoveGenerator.hpp"
+#include "MoveValidator.hpp"
+#include "Nnue.hpp"
+#include "Ruleset.hpp"
+#include "Search.hpp"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double nanosSince(Clock::time_point start) {
+  return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+std::shared_ptr<const NnueNetwork> buildNetwork(const Ruleset& ruleset, int hidden,
+                                                int output_scale, const std::string& path) {
+  auto weights = NnueNetwork::initialWeights(*ruleset.evaluation, ruleset.piece_types->names,
+                                             hidden, 32, 1, output_scale);
+  std::string error;
+  std::shared_ptr<const NnueNetwork> network;
+  if (NnueNetwork::write(path, weights, error)) {
+    network = NnueNetwork::open(path, ruleset.config.game_settings.board_size, error);
+  }
+  if (!network) std::cerr << error << "\n";
+  return network;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  std::string config_file = (argc > 1) ? argv[1] : "data/chess_pieces.json";
+  int hidden = (argc > 2) ? std::stoi(argv[2]) : 256;
+  int depth = (argc > 3) ? std::stoi(argv[3]) : 3;
+  std::string path = (argc > 4) ? argv[4] : "/tmp/nnue_bench.nnue";
+
+  ConfigReader config_reader;
+  if (!config_reader.loadFromFile(config_file)) {
+    std::cerr << "Yapılandırma dosyası yüklenemedi\n";
+    return 1;
+  }
+  GameConfig config = config_reader.getConfig();
+  config.evaluation.nnue_file.clear();
+  std::shared_ptr<const Ruleset> ruleset = Ruleset::create(config);
+  MoveValidator validator;
+  validator.setVerbose(false);
+  MoveGenerator generator(validator);
+
+  // Çıkış katmanı sıfır: ağ tablo değerlendirmesinin aynısı olmalı
+  auto identity = buildNetwork(*ruleset, hidden, 0, path + ".identity");
+  auto network = buildNetwork(*ruleset, hidden, 4, path);
+  if (!identity || !network) return 1;
+
+  // Rastgele oyun: pozisyonlar ve hamleler sonraki ölçümlerde tekrar kullanılır
+  ChessBoard start = ruleset->createBoard("none");
+  start.setVerbose(false);
+  PortalSystem start_portals = ruleset->createPortals();
+  start_portals.setVerbose(false);
+  std::vector<CoordinateMove> game;
+  std::vector<ChessBoard> positions;
+  int mismatches = 0;
+  {
+    ChessBoard board = start;
+    ChessBoard with_identity = start;
+    with_identity.attachNetwork(identity);
+    ChessBoard with_network = start;
+    with_network.attachNetwork(network);
+    PortalSystem portals = start_portals;
+    std::mt19937 rng(11);
+    bool is_white = true;
+    for (int ply = 0; ply < 200; ++ply) {
+      auto moves = generator.legalMoves(board, portals, is_white);
+      if (moves.empty()) break;
+      CoordinateMove move = moves[rng() % moves.size()];
+      PortalSystem scratch = portals;
+      generator.makeMove(with_identity, scratch, move);
+      scratch = portals;
+      generator.makeMove(with_network, scratch, move);
+      generator.makeMove(board, portals, move);
+      game.push_back(move);
+      positions.push_back(board);
+      ChessBoard refreshed = board;
+      refreshed.attachNetwork(network);
+      if (with_identity.getEvaluation() != board.getEvaluation() ||
+          with_network.getEvaluation() != refreshed.getEvaluation()) {
+        ++mismatches;
+      }
+      is_white = !is_white;
+    }
+  }
+
+  std::cout << ruleset->config.game_settings.board_size << "x"
+            << ruleset->config.game_settings.board_size << ", " << network->inputCount()
+            << " girdi, " << hidden << " birikeç, 32x32 yoğun, dosya "
+            << network->fileSize() / 1024 << " KB, varsayılan çekirdek "
+            << NnueNetwork::backendName(NnueNetwork::defaultBackend()) << "\n"
+            << game.size() << " yarım hamlelik oyun, artımlı/baştan ve tablo/ağ uyuşmazlığı: "
+            << mismatches << "\n\n";
+
+  // Birikeçler önceden kurulur; yalnızca ağ hesabı ölçülür
+  std::vector<NnueNetwork::Accumulator> accumulators(positions.size());
+  for (size_t i = 0; i < positions.size(); ++i) network->refresh(positions[i], accumulators[i]);
+  std::cout << "çekirdek    ağ hesabı ns  güncelleme ns   skor toplamı\n";
+  long long reference = 0;
+  bool agree = true;
+  for (auto backend : {NnueNetwork::Backend::Scalar, NnueNetwork::Backend::Sse2,
+                       NnueNetwork::Backend::Avx2}) {
+    if (!NnueNetwork::supports(backend)) continue;
+    constexpr int kRounds = 200;
+    long long sum = 0;
+    auto t0 = Clock::now();
+    for (int round = 0; round < kRounds; ++round) {
+      for (const auto& accumulator : accumulators) sum += network->evaluate(accumulator, backend);
+    }
+    double eval_ns = nanosSince(t0) / (kRounds * accumulators.size());
+    // Hamle başına iki satır: bir taş çıkar, bir taş girer
+    NnueNetwork::Accumulator accumulator = accumulators[0];
+    int inputs = network->inputCount();
+    t0 = Clock::now();
+    constexpr int kUpdates = 200000;
+    for (int i = 0; i < kUpdates; ++i) {
+      network->update(accumulator, (i * 7) % inputs, (i * 13 + 5) % inputs, backend);
+    }
+    double update_ns = nanosSince(t0) / kUpdates;
+    sum += accumulator.psqt + accumulator.hidden[0];
+    if (backend == NnueNetwork::Backend::Scalar) reference = sum;
+    agree = agree && sum == reference;
+    std::cout << std::left << std::setw(10) << NnueNetwork::backendName(backend) << std::right
+              << std::fixed << std::setprecision(1) << std::setw(14) << eval_ns
+              << std::setw(15) << update_ns << std::setw(15) << sum << "\n";
+  }
+  std::cout << "çekirdekler " << (agree ? "aynı sonucu verdi" : "FARKLI SONUÇ VERDİ") << "\n\n";
+
+  // Oyunun hamleleri: tablo değerlendirmesiyle ve ağla (artımlı) oynanır
+  std::cout << "hamle başına (oyun tekrarı)            ns\n";
+  for (int mode = 0; mode < 3; ++mode) {
+    constexpr int kRounds = 50;
+    long long sink = 0;
+    auto t0 = Clock::now();
+    for (int round = 0; round < kRounds; ++round) {
+      ChessBoard board = start;
+      if (mode > 0) board.attachNetwork(network);
+      PortalSystem portals = start_portals;
+      for (const auto& move : game) {
+        generator.makeMove(board, portals, move);
+        if (mode == 2) {
+          // Artımlı güncelleme yerine her hamlede baştan kurma
+          board.attachNetwork(network);
+        }
+        sink += board.getEvaluation();
+      }
+    }
+    const char* label = mode == 0   ? "tablo                            "
+                        : mode == 1 ? "ağ, artımlı birikeç              "
+                                    : "ağ, her hamlede baştan kurulan   ";
+    std::cout << label << std::setw(8) << std::setprecision(0)
+              << nanosSince(t0) / (kRounds * game.size()) << (sink == 0 ? " " : "") << "\n";
+  }
+
+  std::cout << "\narama (derinlik " << depth << ")      düğüm        ms    düğüm/sn  hamle\n";
+  for (bool use_network : {false, true}) {
+    ChessBoard board = start;
+    if (use_network) board.attachNetwork(network);
+    PortalSystem portals = start_portals;
+    Search search(*ruleset->evaluation, validator);
+    SearchLimits limits;
+    limits.max_depth = depth;
+    auto t0 = Clock::now();
+    SearchResult result = search.iterate(board, portals, true, limits);
+    double ms = nanosSince(t0) / 1e6;
+    std::cout << (use_network ? "ağ                 " : "tablo              ") << std::setw(10)
+              << result.nodes << std::setw(10) << std::setprecision(1) << ms << std::setw(12)
+              << std::setprecision(0) << result.nodes / (ms / 1000.0) << "  "
+              << (result.has_move ? formatCoordinateMove(result.best_move) : "-") << "\n";
+  }
+  return mismatches == 0 && agree ? 0 : 1;
+}
@@ -0,0 +1,114 @@
+// ordering_bench.cpp
+// Sabit derinlikte hamle sıralamalı ve sıralamasız aramanın düğüm sayılarını kıyaslar.
+// Standart ölçüm için portallar kaldırılır, portal ölçümü config'deki portallarla yapılır.
+// Kullanım: ordering_bench [config.json] [derinlik]
+#include "ChessBoard.hpp"
+#include "ConfigReader.hpp"
+#include "Evaluation.hpp"
+#include "MoveGenerator.hpp"
+#include "MoveNotation.hpp"
+#include "MoveValidator.hpp"
+#include "PortalSystem.hpp"
+#include "Search.hpp"
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <sstream>
+
+namespace {
+
+// Başlangıç pozisyonu ve birkaç açılış hamlesi sonrası pozisyonlar
+const char* const kOpenings[] = {
+    "",
+    "e2e4 e7e5 g1f3 b8c6",
+    "d2d4 d7d5 c2c4 e7e6 b1c3 g8f6",
+    "e2e4 d7d5 e4d5 d8d5 b1c3",
+};
+
+struct Totals {
+  uint64_t nodes = 0;
+  double seconds = 0;
+};
+
+void runConfig(const std::string& label, const GameConfig& config, int depth) {
+  std::vector<PieceConfig> all_pieces = config.pieces;
+  all_pieces.insert(all_pieces.end(), config.custom_pieces.begin(), config.custom_pieces.end());
+  auto evaluation = std::make_shared<Evaluation>(config);
+
+  MoveValidator validator;
+  validator.setVerbose(false);
+  MoveGenerator generator(validator);
+
+  Totals without_ordering, with_ordering;
+  for (const char* opening : kOpenings) {
+    ChessBoard board(config.game_settings.board_size);
+    board.initializeBoard(all_pieces);
+    board.attachEvaluation(evaluation);
+    board.setVerbose(false);
+    PortalSystem portal_system(config.portals);
+    portal_system.setVerbose(false);
+
+    bool is_white = true;
+    std::istringstream iss(opening);
+    std::string token;
+    bool valid = true;
+    while (iss >> token) {
+      CoordinateMove move;
+      if (!parseCoordinateMove(token, board.getBoardSize(), move)) {
+        valid = false;
+        break;
+      }
+      if (!generator.tryMakeMove(board, portal_system, move)) {
+        valid = false;
+        break;
+      }
+      is_white = !is_white;
+    }
+    if (!valid) {
+      std::cout << "  açılış oynanamadı, atlandı: " << opening << "\n";
+      continue;
+    }
+
+    for (bool enabled : {false, true}) {
+      Search search(*evaluation, validator);
+      search.setOrdering(enabled);
+      auto t0 = std::chrono::steady_clock::now();
+      SearchResult result = search.search(board, portal_system, is_white, depth);
+      double seconds =
+          std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+      Totals& totals = enabled ? with_ordering : without_ordering;
+      totals.nodes += result.nodes;
+      totals.seconds += seconds;
+      std::cout << "  [" << (opening[0] ? opening : "başlangıç") << "] "
+                << (enabled ? "sıralı   " : "sırasız  ") << result.nodes << " düğüm, "
+                << seconds << " s, en iyi "
+                << (result.has_move ? formatCoordinateMove(result.best_move) : "-")
+                << " skor " << result.score << "\n";
+    }
+  }
+
+  double ratio = with_ordering.nodes
+                     ? static_cast<double>(without_ordering.nodes) / with_ordering.nodes : 0;
+  std::cout << label << " derinlik " << depth << ": sırasız " << without_ordering.nodes
+            << " düğüm / " << without_ordering.seconds << " s, sıralı " << with_ordering.nodes
+            << " düğüm / " << with_ordering.seconds << " s, düğüm azalması " << ratio << "x\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  std::string config_file = (argc > 1) ? argv[1] : "data/chess_pieces.json";
+  int depth = (argc > 2) ? std::stoi(argv[2]) : 4;
+
+  ConfigReader config_reader;
+  if (!config_reader.loadFromFile(config_file)) {
+    std::cerr << "Yapılandırma dosyası yüklenemedi\n";
+    return 1;
+  }
+
+  GameConfig standard = config_reader.getConfig();
+  standard.portals.clear();
+  runConfig("standart", standard, depth);
+  runConfig("portallı", config_reader.getConfig(), depth);
+  return 0;
+}
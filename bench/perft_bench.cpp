@@ -0,0 +1,115 @@
+// perft_bench.cpp
+// Paralel perft'in thread sayısıyla ölçeklenmesi: 1'den N'ye (ikinin katları)
+// her thread sayısında yaprak sayısı, süre, düğüm/sn, 1 thread'e göre hızlanma,
+// görev ve çalma sayıları. Her koşu aynı yaprak sayısını vermelidir.
+// Ardından aynı derinlik paylaşılan yaprak tablosuyla tekrar ölçülür. Son
+// olarak şahlar ve atlarla perft 6, tablo açık ve küçük bölünme derinliğiyle
+// çok thread'li tekrarlanır: bölünen alt ağaçların eksik sayıları tabloya girmemeli.
+// Kullanım: perft_bench [config.json] [derinlik] [en fazla thread] [tablo MB]
+#include "ConfigReader.hpp"
+#include "Perft.hpp"
+#include "Ruleset.hpp"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+void printRow(const Perft::Result& result, double base_nps) {
+  double nps = result.nodes / (result.elapsed_ms / 1000.0);
+  std::cout << std::setw(7) << result.threads << std::setw(14) << result.nodes << std::setw(11)
+            << std::fixed << std::setprecision(1) << result.elapsed_ms << std::setw(14)
+            << std::setprecision(0) << nps << std::setw(9) << std::setprecision(2)
+            << (base_nps > 0 ? nps / base_nps : 1.0) << "x" << std::setw(8) << result.tasks
+            << std::setw(8) << result.steals << std::setw(10) << result.hash_hits << "\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  std::string config_file = (argc > 1) ? argv[1] : "data/chess_pieces.json";
+  int depth = (argc > 2) ? std::stoi(argv[2]) : 4;
+  unsigned max_threads = (argc > 3) ? static_cast<unsigned>(std::stoul(argv[3]))
+                                    : std::max(4u, std::thread::hardware_concurrency());
+  size_t hash_mb = (argc > 4) ? std::stoul(argv[4]) : 64;
+
+  ConfigReader config_reader;
+  if (!config_reader.loadFromFile(config_file)) {
+    std::cerr << "Yapılandırma dosyası yüklenemedi\n";
+    return 1;
+  }
+  std::shared_ptr<const Ruleset> ruleset = Ruleset::create(config_reader.getConfig());
+  ChessBoard board = ruleset->createBoard("none");
+  board.setVerbose(false);
+  PortalSystem portals = ruleset->createPortals();
+  portals.setVerbose(false);
+
+  std::cout << "perft " << depth << ", " << ruleset->config.game_settings.board_size << "x"
+            << ruleset->config.game_settings.board_size << ", "
+            << ruleset->config.portals.size() << " portal, donanım thread: "
+            << std::thread::hardware_concurrency() << "\n";
+
+  bool consistent = true;
+  for (size_t table : {size_t{0}, hash_mb}) {
+    std::cout << "\n" << (table ? "yaprak tablosu " + std::to_string(table) + " MB" : "tablosuz")
+              << "\nthread        yaprak         ms      düğüm/sn  hızlanma   görev   çalma     tablo\n";
+    double base_nps = 0;
+    uint64_t expected = 0;
+    for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+      Perft::Options options;
+      options.threads = threads;
+      options.hash_mb = table;
+      Perft::Result result = Perft::run(board, portals, true, depth, options);
+      if (threads == 1) {
+        base_nps = result.nodes / (result.elapsed_ms / 1000.0);
+        expected = result.nodes;
+      } else if (result.nodes != expected) {
+        consistent = false;
+      }
+      printRow(result, threads == 1 ? 0 : base_nps);
+    }
+  }
+  // Bölünme ve transpozisyon birlikte: şahlar ve atlarla perft 6'da bölünen
+  // düğümlerin ataları başka hamle sıralarıyla tekrar görülür. Sonuç bölünmeyen
+  // tek thread'li koşuyla aynı olmalı
+  {
+    ChessBoard knights(board.getBoardSize(), board.getTypes());
+    knights.setVerbose(false);
+    int last = board.getBoardSize() - 1;
+    knights.placePiece("King", true, 4, 0);
+    knights.placePiece("King", false, 4, last);
+    for (int x : {1, 6}) {
+      knights.placePiece("Knight", true, x, 0);
+      knights.placePiece("Knight", false, x, last);
+    }
+    Perft::Options options;
+    options.threads = 1;
+    options.hash_mb = hash_mb;
+    uint64_t expected = Perft::run(knights, portals, true, 6, options).nodes;
+    constexpr int kRuns = 10;
+    options.threads = std::max(8u, max_threads);
+    options.split_depth = 2;
+    int wrong = 0;
+    uint64_t tasks = 0, hits = 0;
+    for (int run = 0; run < kRuns; ++run) {
+      Perft::Result result = Perft::run(knights, portals, true, 6, options);
+      if (result.nodes != expected) ++wrong;
+      tasks += result.tasks;
+      hits += result.hash_hits;
+    }
+    std::cout << "\nşah+at perft 6 (" << expected << "), bölünme derinliği 2, "
+              << options.threads << " thread, tablo " << hash_mb << " MB: " << kRuns
+              << " koşu, koşu başına " << tasks / kRuns << " görev ve " << hits / kRuns
+              << " tablo isabeti, yanlış sayı " << wrong << "\n";
+    if (wrong > 0) consistent = false;
+  }
+
+  if (!consistent) {
+    std::cerr << "Uyuşmazlık: thread sayısına göre yaprak sayısı değişti\n";
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,162 @@
+// ponder_bench.cpp
+// Örnek oyunları oynatıp her pozisyonda sabit derinliğe ulaşma süresini ölçer:
+// soğuk başlangıç ile önceki pozisyonda belirli bir süre ponder yapılmış hali kıyaslar.
+// Kullanım: ponder_bench [config.json] [oyunlar.txt] [derinlik] [ponder ms]
+#include "Analyzer.hpp"
+#include "ChessBoard.hpp"
+#include "ConfigReader.hpp"
+#include "MoveGenerator.hpp"
+#include "MoveNotation.hpp"
+#include "MoveValidator.hpp"
+#include "PortalSystem.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+namespace {
+
+double percentile(std::vector<double> values, double p) {
+  if (values.empty()) return 0;
+  std::sort(values.begin(), values.end());
+  size_t index = static_cast<size_t>(p * (values.size() - 1) + 0.5);
+  return values[std::min(index, values.size() - 1)];
+}
+
+struct Timings {
+  std::vector<double> cold;
+  std::vector<double> pondered;
+  int hits = 0; // ponder sonucu istenen derinliği zaten kapsıyordu
+};
+
+// Motor-motor ölçümü: kayıttaki ilk kOpeningPlies yarım hamle, sonra kSelfPlayPlies
+constexpr int kOpeningPlies = 4;
+constexpr int kSelfPlayPlies = 12;
+
+void printTimes(const std::string& label, const std::vector<double>& times) {
+  std::cout << "  " << label << ": p50 " << percentile(times, 0.50) << " ms, p99 "
+            << percentile(times, 0.99) << " ms, maks " << percentile(times, 1.0) << " ms\n";
+}
+
+void report(const std::string& label, const Timings& timings) {
+  std::cout << label << " (" << timings.cold.size() << " yanıt, " << timings.hits
+            << " tanesi doğrudan önbellekten)\n";
+  printTimes("soğuk ", timings.cold);
+  printTimes("ponder", timings.pondered);
+}
+
+double timeGo(Analyzer& analyzer, const ChessBoard& board, const PortalSystem& portal_system,
+              bool is_white, int depth, SearchResult& result, bool& from_cache) {
+  auto t0 = std::chrono::steady_clock::now();
+  analyzer.go(board, portal_system, is_white, std::chrono::milliseconds(0),
+              [&](const SearchResult& r, bool cached) {
+                result = r;
+                from_cache = cached;
+              },
+              depth);
+  analyzer.wait();
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0)
+      .count();
+}
+
+// Ölçülen taraf (siyah) her hamlesinden sonra rakip düşünürken ponder yapar.
+// İlk hamleler script'ten, kalanlar iki tarafın kendi aramasından gelir.
+// Rakibin düşünme süresi ponder_ms olarak sabitlenir (ayrı çekirdek varsayımı).
+void playGame(const GameConfig& config, const std::vector<PieceConfig>& all_pieces,
+              const std::shared_ptr<const Evaluation>& evaluation,
+              const MoveGenerator& generator, int depth, int ponder_ms, int plies,
+              const std::vector<CoordinateMove>& script, Timings& timings) {
+  ChessBoard board(config.game_settings.board_size);
+  board.initializeBoard(all_pieces);
+  board.attachEvaluation(evaluation);
+  board.setVerbose(false);
+  PortalSystem portal_system(config.portals);
+  portal_system.setVerbose(false);
+
+  Analyzer engine(evaluation);
+  Analyzer opponent(evaluation);
+  bool is_white = true;
+  for (int ply = 0; ply < plies; ++ply) {
+    bool scripted = ply < static_cast<int>(script.size());
+    bool engine_turn = (ply % 2) == 1;
+    SearchResult result;
+    bool from_cache = false;
+    if (engine_turn) {
+      Analyzer cold(evaluation);
+      timings.cold.push_back(timeGo(cold, board, portal_system, is_white, depth, result,
+                                    from_cache));
+      timings.pondered.push_back(timeGo(engine, board, portal_system, is_white, depth, result,
+                                        from_cache));
+      if (from_cache) ++timings.hits;
+    } else {
+      if (!scripted) {
+        timeGo(opponent, board, portal_system, is_white, depth, result, from_cache);
+      }
+      engine.ponder(board, portal_system, is_white);
+      std::this_thread::sleep_for(std::chrono::milliseconds(ponder_ms));
+      engine.cancel();
+    }
+    CoordinateMove move = scripted ? script[ply] : result.best_move;
+    if (!scripted && !result.has_move) break;
+    if (!generator.tryMakeMove(board, portal_system, move)) {
+      break;
+    }
+    is_white = !is_white;
+  }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  std::string config_file = (argc > 1) ? argv[1] : "data/chess_pieces.json";
+  std::string games_file = (argc > 2) ? argv[2] : "data/sample_games.txt";
+  int depth = (argc > 3) ? std::stoi(argv[3]) : 4;
+  int ponder_ms = (argc > 4) ? std::stoi(argv[4]) : 500;
+
+  ConfigReader config_reader;
+  if (!config_reader.loadFromFile(config_file)) {
+    std::cerr << "Yapılandırma dosyası yüklenemedi\n";
+    return 1;
+  }
+  const GameConfig& config = config_reader.getConfig();
+  std::vector<PieceConfig> all_pieces = config.pieces;
+  all_pieces.insert(all_pieces.end(), config.custom_pieces.begin(), config.custom_pieces.end());
+  auto evaluation = std::make_shared<const Evaluation>(config);
+
+  std::ifstream games(games_file);
+  if (!games) {
+    std::cerr << "Oyun dosyası açılamadı: " << games_file << "\n";
+    return 1;
+  }
+
+  MoveValidator validator;
+  validator.setVerbose(false);
+  MoveGenerator generator(validator);
+  Timings recorded, self_play;
+
+  // 1) Kayıtlı oyunlar: rakip hamlesi tahmin edilemeyebilir
+  std::string line;
+  while (std::getline(games, line)) {
+    if (line.empty() || line[0] == '#') continue;
+    std::istringstream iss(line);
+    std::vector<CoordinateMove> moves;
+    std::string token;
+    CoordinateMove move;
+    while (iss >> token && parseCoordinateMove(token, config.game_settings.board_size, move)) {
+      moves.push_back(move);
+    }
+    playGame(config, all_pieces, evaluation, generator, depth, ponder_ms,
+             static_cast<int>(moves.size()), moves, recorded);
+
+    // 2) Motor-motor: açılıştan sonra rakip de aynı derinlikte en iyi hamlesini oynar
+    moves.resize(std::min<size_t>(moves.size(), kOpeningPlies));
+    playGame(config, all_pieces, evaluation, generator, depth, ponder_ms,
+             kOpeningPlies + kSelfPlayPlies, moves, self_play);
+  }
+
+  std::cout << "derinlik " << depth << ", ponder " << ponder_ms << " ms\n";
+  report("kayıtlı oyunlar", recorded);
+  report("motor-motor", self_play);
+  return 0;
+}
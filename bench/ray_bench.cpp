@@ -0,0 +1,140 @@
+// ray_bench.cpp
+// Işın tablosunun AVX2 ve skaler sürümlerini birbiriyle ve kare kare yürüyen
+// referansla doğrular; 16x16 ve 26x26 tahtalarda hesaplama, sözde yasal hamle
+// üretimi, şah kontrolü ve şah çekenlerin analizi sürelerini ölçer.
+// Kullanım: ray_bench [rastgele tahta sayısı]
+#include "ChessBoard.hpp"
+#include "GameManager.hpp"
+#include "MoveGenerator.hpp"
+#include "MoveValidator.hpp"
+#include "PortalSystem.hpp"
+#include "RayScan.hpp"
+#include <chrono>
+#include <iostream>
+#include <random>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const char* const kPieces[] = {"Pawn", "Knight", "Bishop", "Rook", "Queen"};
+constexpr int kDirX[8] = {0, 0, 1, -1, 1, 1, -1, -1};
+constexpr int kDirY[8] = {1, -1, 0, 0, 1, -1, 1, -1};
+
+// Her renkten bir şah ve verilen yoğunlukta rastgele taşlar
+ChessBoard randomBoard(int size, int density_percent, std::mt19937& rng) {
+  ChessBoard board(size);
+  for (int y = 0; y < size; ++y) {
+    for (int x = 0; x < size; ++x) {
+      if (static_cast<int>(rng() % 100) >= density_percent) continue;
+      board.placePiece(kPieces[rng() % 5], rng() % 2 == 0, x, y);
+    }
+  }
+  board.placePiece("King", true, static_cast<int>(rng() % size), static_cast<int>(rng() % size));
+  board.placePiece("King", false, static_cast<int>(rng() % size), static_cast<int>(rng() % size));
+  return board;
+}
+
+int walkLength(const ChessBoard& board, int x, int y, int dir) {
+  int length = 0;
+  for (;;) {
+    Position p{x + kDirX[dir] * (length + 1), y + kDirY[dir] * (length + 1)};
+    if (!board.isInBounds(p)) return length;
+    ++length;
+    if (!board.getSquare(p).is_empty()) return length;
+  }
+}
+
+int validate(int size, int boards, std::mt19937& rng) {
+  int mismatches = 0;
+  RayTable scalar(size), simd(size);
+  for (int i = 0; i < boards; ++i) {
+    ChessBoard board = randomBoard(size, 5 + static_cast<int>(rng() % 60), rng);
+    scalar.compute(board, RayTable::Backend::Scalar);
+    simd.compute(board, RayTable::Backend::Avx2);
+    for (int y = 0; y < size; ++y) {
+      for (int x = 0; x < size; ++x) {
+        for (int dir = 0; dir < 8; ++dir) {
+          int expected = walkLength(board, x, y, dir);
+          if (scalar.length(x, y, dir) != expected || simd.length(x, y, dir) != expected) {
+            ++mismatches;
+          }
+        }
+      }
+    }
+  }
+  return mismatches;
+}
+
+template <class F>
+double timeNs(int repeat, F&& body) {
+  auto t0 = Clock::now();
+  for (int r = 0; r < repeat; ++r) body(r);
+  return std::chrono::duration<double, std::nano>(Clock::now() - t0).count() / repeat;
+}
+
+void run(int size, int boards, std::mt19937& rng) {
+  int mismatches = validate(size, boards, rng);
+  std::cout << size << "x" << size << ": " << boards << " tahta doğrulandı, uyuşmazlık "
+            << mismatches << "\n";
+
+  ChessBoard board = randomBoard(size, 25, rng);
+  RayTable table(size);
+  long long sink = 0;
+  const int repeat = 20000;
+  double scalar_ns = timeNs(repeat, [&](int) {
+    table.compute(board, RayTable::Backend::Scalar);
+    sink += table.length(0, 0, 0);
+  });
+  double simd_ns = timeNs(repeat, [&](int) {
+    table.compute(board, RayTable::Backend::Avx2);
+    sink += table.length(0, 0, 0);
+  });
+  double walk_ns = timeNs(repeat / 10, [&](int) {
+    for (int y = 0; y < size; ++y)
+      for (int x = 0; x < size; ++x)
+        for (int dir = 0; dir < 8; ++dir) sink += walkLength(board, x, y, dir);
+  });
+  std::cout << "  tüm tablo: AVX2 " << simd_ns << " ns, skaler " << scalar_ns
+            << " ns, kare kare yürüme " << walk_ns << " ns"
+            << (RayTable::avx2Available() ? "" : " (AVX2 yok, skaler kullanıldı)") << "\n";
+
+  PortalSystem portal_system(std::vector<PortalConfig>{});
+  portal_system.setVerbose(false);
+  for (bool tables : {false, true}) {
+    MoveValidator validator;
+    validator.setVerbose(false);
+    validator.setRayTables(tables);
+    MoveGenerator generator(validator);
+    // Her turda tahtanın kopyası: önbellek soğuk başlar, gerçek aramadaki gibi
+    double movegen_us = timeNs(200, [&](int r) {
+      ChessBoard copy = board;
+      sink += static_cast<long long>(generator.pseudoLegalMoves(copy, portal_system, r % 2 == 0).size());
+    }) / 1000.0;
+    double check_us = timeNs(200, [&](int r) {
+      ChessBoard copy = board;
+      GameManager manager(copy, validator, portal_system);
+      sink += manager.isInCheck(r % 2 == 0) ? 1 : 0;
+    }) / 1000.0;
+    double analyze_us = timeNs(200, [&](int r) {
+      ChessBoard copy = board;
+      sink += static_cast<long long>(
+          generator.analyzeChecks(copy, portal_system, r % 2 == 0).checkers.size());
+    }) / 1000.0;
+    std::cout << "  " << (tables ? "ışın tablosu" : "kare kare   ") << ": sözde yasal üretim "
+              << movegen_us << " us, isInCheck " << check_us << " us, analyzeChecks "
+              << analyze_us << " us\n";
+  }
+  std::cout << "  (checksum " << sink << ")\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  int boards = (argc > 1) ? std::stoi(argv[1]) : 500;
+  std::mt19937 rng(2024);
+  for (int size : {16, 26}) {
+    run(size, boards, rng);
+  }
+  return 0;
+}
@@ -0,0 +1,191 @@
+// snapshot_bench.cpp
+// Bir oyunun ortasından çok sayıda "ya şöyle oynansaydı" dalı açmanın maliyeti:
+//   kopya     : her dal tahtanın, portal durumunun ve geçmişin tam kopyası
+//   kalıcı    : GameSnapshot; dal açmak O(1), hamle yalnızca değişen satırları kopyalar
+// Her dalda iki hamle oynanır ve dallar ölçüm bitene kadar canlı tutulur.
+// Bellek operator new/delete üzerinden canlı bayt olarak sayılır.
+// Kullanım: snapshot_bench [config.json] [açılış yarım hamlesi]
+#include "ChessBoard.hpp"
+#include "ConfigReader.hpp"
+#include "GameManager.hpp"
+#include "GameSnapshot.hpp"
+#include "MoveGenerator.hpp"
+#include "MoveValidator.hpp"
+#include "PortalSystem.hpp"
+#include "Ruleset.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <malloc.h>
+#include <new>
+#include <random>
+#include <vector>
+
+namespace {
+
+std::atomic<size_t> live_bytes{0};
+
+using Clock = std::chrono::steady_clock;
+
+double microsSince(Clock::time_point start) {
+  return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+}
+
+struct CopiedBranch {
+  ChessBoard board;
+  PortalSystem portals;
+  std::vector<GameManager::Move> history;
+};
+
+// Dal i'nin hamleleri: kök hamlesi ve ona verilen cevaplardan biri
+struct Line {
+  CoordinateMove first;
+  CoordinateMove second;
+  bool has_second;
+};
+
+void printRow(const char* label, size_t count, size_t bytes, double fork_us, double play_us) {
+  std::cout << label << std::setw(8) << count << std::setw(14) << bytes / count << std::setw(12)
+            << std::fixed << std::setprecision(1) << bytes / 1e6 << std::setw(12)
+            << std::setprecision(3) << fork_us / count << std::setw(12) << play_us / count
+            << "\n";
+}
+
+} // namespace
+
+void* operator new(size_t size) {
+  void* ptr = std::malloc(size ? size : 1);
+  if (!ptr) throw std::bad_alloc();
+  live_bytes += malloc_usable_size(ptr);
+  return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+  if (!ptr) return;
+  live_bytes -= malloc_usable_size(ptr);
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+  operator delete(ptr);
+}
+
+int main(int argc, char* argv[]) {
+  std::string config_file = (argc > 1) ? argv[1] : "data/chess_pieces.json";
+  int opening_plies = (argc > 2) ? std::stoi(argv[2]) : 30;
+  ConfigReader config_reader;
+  if (!config_reader.loadFromFile(config_file)) {
+    std::cerr << "Yapılandırma dosyası yüklenemedi\n";
+    return 1;
+  }
+  std::shared_ptr<const Ruleset> ruleset = Ruleset::create(config_reader.getConfig());
+  MoveValidator validator;
+  validator.setVerbose(false);
+  MoveGenerator generator(validator);
+
+  // Dalların açılacağı oyun: rastgele yasal hamlelerle oynanır
+  ChessBoard board = ruleset->createBoard("none");
+  board.setVerbose(false);
+  PortalSystem portals = ruleset->createPortals();
+  portals.setVerbose(false);
+  GameManager manager(board, validator, portals);
+  std::mt19937 rng(7);
+  bool is_white = true;
+  for (int ply = 0; ply < opening_plies; ++ply) {
+    auto moves = generator.legalMoves(board, portals, is_white);
+    if (moves.empty()) break;
+    const CoordinateMove& move = moves[rng() % moves.size()];
+    board.movePiece(move.from, move.to, validator, portals, manager, "Queen");
+    is_white = !is_white;
+  }
+  std::vector<GameManager::Move> history = manager.getMoveHistory();
+  GameSnapshot base(board, portals, is_white, history);
+
+  // Her dalın iki hamlesi önceden seçilir; iki mod aynı hamleleri oynar
+  auto roots = generator.legalMoves(board, portals, is_white);
+  if (roots.empty()) {
+    std::cerr << "Açılıştan sonra yasal hamle yok\n";
+    return 1;
+  }
+  std::vector<std::vector<CoordinateMove>> replies;
+  for (const auto& root : roots) {
+    ChessBoard next = board;
+    PortalSystem next_portals = portals;
+    generator.makeMove(next, next_portals, root);
+    replies.push_back(generator.legalMoves(next, next_portals, !is_white));
+  }
+  auto lineFor = [&](size_t i) {
+    size_t r = i % roots.size();
+    const auto& answers = replies[r];
+    Line line{roots[r], {}, !answers.empty()};
+    if (line.has_second) line.second = answers[(i / roots.size()) % answers.size()];
+    return line;
+  };
+
+  std::cout << ruleset->config.game_settings.board_size << "x"
+            << ruleset->config.game_settings.board_size << ", " << history.size()
+            << " kayıtlık geçmişten dal açılıyor, dal başına 2 hamle\n\n"
+            << "mod          dal     bayt/dal    toplam MB   açma µs/dal  oynama µs/dal\n";
+  for (size_t count : {size_t{1000}, size_t{10000}}) {
+    {
+      std::vector<CopiedBranch> branches;
+      branches.reserve(count);
+      size_t start_bytes = live_bytes;
+      auto t0 = Clock::now();
+      for (size_t i = 0; i < count; ++i) {
+        branches.push_back({board, portals, history});
+      }
+      double fork_us = microsSince(t0);
+      t0 = Clock::now();
+      for (size_t i = 0; i < count; ++i) {
+        CopiedBranch& branch = branches[i];
+        GameManager branch_manager(branch.board, validator, branch.portals);
+        Line line = lineFor(i);
+        branch.board.movePiece(line.first.from, line.first.to, validator, branch.portals,
+                               branch_manager, "Queen");
+        if (line.has_second) {
+          branch.board.movePiece(line.second.from, line.second.to, validator, branch.portals,
+                                 branch_manager, "Queen");
+        }
+        for (const auto& move : branch_manager.getMoveHistory()) branch.history.push_back(move);
+      }
+      double play_us = microsSince(t0);
+      printRow("kopya   ", count, live_bytes - start_bytes, fork_us, play_us);
+    }
+    {
+      std::vector<GameSnapshot> forks;
+      std::vector<GameSnapshot> branches;
+      forks.reserve(count);
+      branches.reserve(count);
+      size_t start_bytes = live_bytes;
+      auto t0 = Clock::now();
+      for (size_t i = 0; i < count; ++i) {
+        forks.push_back(base);
+      }
+      double fork_us = microsSince(t0);
+      t0 = Clock::now();
+      size_t shared_rows = 0;
+      for (size_t i = 0; i < count; ++i) {
+        Line line = lineFor(i);
+        auto played = forks[i].play(line.first, validator);
+        if (played && line.has_second) played = played->play(line.second, validator);
+        if (!played) {
+          std::cerr << "Dal " << i << " oynanamadı\n";
+          return 1;
+        }
+        shared_rows += played->sharedRows(base);
+        branches.push_back(*played);
+      }
+      double play_us = microsSince(t0);
+      forks.clear();
+      forks.shrink_to_fit();
+      printRow("kalıcı  ", count, live_bytes - start_bytes, fork_us, play_us);
+      std::cout << "         ortak satır: ortalama " << std::setprecision(1)
+                << static_cast<double>(shared_rows) / count << " / "
+                << ruleset->config.game_settings.board_size << "\n";
+    }
+  }
+  return 0;
+}
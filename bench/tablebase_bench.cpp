@@ -0,0 +1,88 @@
+// tablebase_bench.cpp
+// KRvK tablosunu geçici bir dizine üretir (süre ve sonuç dağılımını üretici
+// yazar), ardından bilinen mat, bir hamlede mat ve beraberlik pozisyonlarını
+// tablodan sorgular. Pozisyonlar köşelerde, varsayılan config'in portallarından
+// uzaktadır. Kullanım: tablebase_bench [config.json] [thread sayısı]
+#include "ConfigReader.hpp"
+#include "PositionParser.hpp"
+#include "Ruleset.hpp"
+#include "Tablebase.hpp"
+#include "TablebaseGenerator.hpp"
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+namespace {
+
+struct KnownPosition {
+  const char* position;
+  TablebaseResult::Outcome outcome;
+  int plies_to_mate;
+};
+
+const KnownPosition kPositions[] = {
+    {"board k6R/8/K7/8/8/8/8/8 b", TablebaseResult::Outcome::Loss, 0},
+    {"board R6k/8/7K/8/8/8/8/8 b", TablebaseResult::Outcome::Loss, 0},
+    {"board 8/8/8/8/8/K7/8/k6R b", TablebaseResult::Outcome::Loss, 0},
+    {"board k7/8/K7/8/8/8/8/7R w", TablebaseResult::Outcome::Win, 1},
+    {"board 7k/8/7K/8/8/8/8/R7 w", TablebaseResult::Outcome::Win, 1},
+    {"board k7/1R6/8/8/8/8/8/7K b", TablebaseResult::Outcome::Draw, 0},
+};
+
+const char* outcomeText(TablebaseResult::Outcome outcome) {
+  switch (outcome) {
+    case TablebaseResult::Outcome::Win: return "kazanç";
+    case TablebaseResult::Outcome::Loss: return "kayıp";
+    default: return "beraberlik";
+  }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  std::string config_file = (argc > 1) ? argv[1] : "data/chess_pieces.json";
+  unsigned threads = (argc > 2) ? static_cast<unsigned>(std::stoul(argv[2])) : 0;
+
+  ConfigReader config_reader;
+  if (!config_reader.loadFromFile(config_file)) {
+    std::cerr << "Yapılandırma dosyası yüklenemedi\n";
+    return 1;
+  }
+  std::shared_ptr<const Ruleset> ruleset = Ruleset::create(config_reader.getConfig());
+  PositionParser parser(ruleset->config, ruleset->evaluation, ruleset->network);
+
+  std::filesystem::path directory =
+      std::filesystem::temp_directory_path() / "tablebase_bench";
+  std::filesystem::remove_all(directory);
+  Tablebase::Material material;
+  if (!Tablebase::parseSignature("KRvK", ruleset->config, material) ||
+      !TablebaseGenerator(ruleset->config, directory.string(), threads).generate(material)) {
+    std::filesystem::remove_all(directory);
+    return 1;
+  }
+
+  Tablebase tablebase(ruleset->config, directory.string());
+  int failures = 0;
+  for (const auto& expected : kPositions) {
+    PositionParser::Setup setup;
+    std::string error;
+    TablebaseResult result;
+    std::string found = "yok";
+    if (!parser.parse(expected.position, setup, error)) {
+      found = error;
+    } else if (tablebase.probe(*setup.board, *setup.portals, setup.is_white, result)) {
+      found = std::string(outcomeText(result.outcome)) + " " +
+              std::to_string(result.plies_to_mate);
+    }
+    std::string wanted = std::string(outcomeText(expected.outcome)) + " " +
+                         std::to_string(expected.plies_to_mate);
+    bool ok = found == wanted;
+    if (!ok) ++failures;
+    std::cout << std::left << std::setw(32) << expected.position << std::setw(14) << wanted
+              << found << (ok ? "" : " !") << "\n";
+  }
+  std::filesystem::remove_all(directory);
+  std::cout << "\n" << std::size(kPositions) << " pozisyon, " << failures << " hata\n";
+  return failures == 0 ? 0 : 1;
+}
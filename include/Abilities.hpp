@@ -0,0 +1,41 @@
+// Abilities.hpp
+#ifndef ABILITIES_HPP
+#define ABILITIES_HPP
+#include <cstdint>
+#include <string>
+
+// Taş yetenekleri config yüklenirken tip başına bir bit maskesine derlenir;
+// kural kontrolleri isim karşılaştırmak yerine bit sınar. Standart yetenekler
+// ve motorun tanıdığı portal_master sabit ID'lidir, diğer özel yetenekler ilk
+// görüldükleri anda süreç genelinde bir ID alır (config yenilense de değişmez).
+namespace abilities {
+
+using Mask = uint64_t;
+
+enum Id : int {
+  Castling = 0,
+  Royal,
+  JumpOver,
+  Promotion,
+  EnPassant,
+  PortalMaster,
+  kBuiltinCount
+};
+
+constexpr int kMaxAbilities = 64;
+
+constexpr Mask bit(int id) { return Mask{1} << id; }
+constexpr bool has(Mask mask, int id) { return (mask & bit(id)) != 0; }
+
+// İsmin ID'si; yeni isim kaydedilir. Yer kalmadıysa -1
+int intern(const std::string& name);
+// Kayıtlı değilse -1
+int find(const std::string& name);
+
+// Config'te yeteneği verilmeden tahtaya konan tipler için (elle kurulan
+// tahtalar, tablebase) klasik satranç adlarından varsayılan maske
+Mask defaultsFor(const std::string& piece);
+
+} // namespace abilities
+
+#endif
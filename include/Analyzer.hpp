@@ -0,0 +1,68 @@
+// Analyzer.hpp
+#ifndef ANALYZER_HPP
+#define ANALYZER_HPP
+#include "ChessBoard.hpp"
+#include "Evaluation.hpp"
+#include "PortalSystem.hpp"
+#include "Search.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+// REPL girdi beklerken arka planda analiz yapan yardımcı.
+// - ponder: sıradaki tarafın beklenen hamlesini bulur, sonra o hamleden
+//   sonraki pozisyonu derinleştirir. Beklenen hamle gelince sonuçlar hazırdır.
+// - go: süre veya stop komutuna kadar arar, bitince en iyi hamleyi bildirir.
+// Her arama tahta ve portal durumunun kopyası üzerinde çalışır; sonuçlar
+// pozisyon anahtarıyla paylaşılan önbellekte tutulur.
+class Analyzer {
+public:
+  using Clock = std::chrono::steady_clock;
+  // go sonucu arka plan thread'inden bu fonksiyonla bildirilir
+  using Report = std::function<void(const SearchResult& result, bool from_cache)>;
+
+  explicit Analyzer(std::shared_ptr<const Evaluation> evaluation);
+  ~Analyzer();
+
+  void ponder(const ChessBoard& board, const PortalSystem& portal_system, bool is_white);
+
+  // movetime <= 0 ise stop gelene veya max_depth tamamlanana kadar arar
+  void go(const ChessBoard& board, const PortalSystem& portal_system, bool is_white,
+          std::chrono::milliseconds movetime, Report report,
+          int max_depth = MoveOrdering::kMaxPly - 1);
+
+  // Çalışan aramayı durdurur; go ise sonucu bildirilir
+  void stop();
+  // Çalışan aramayı sonucu bildirmeden iptal eder (tahta değiştiğinde)
+  void cancel();
+  // Çalışan go aramasının bitmesini bekler
+  void wait();
+
+  bool isSearching() const;
+  // Kural seti değişince: çalışan arama iptal edilir, önbellek boşaltılır
+  void setEvaluation(std::shared_ptr<const Evaluation> next);
+  bool cached(uint64_t key, SearchResult& result) const;
+
+  // Ponder aşamasında beklenen hamleyi bulmak için kullanılan kısa derinlik
+  static constexpr int kExpectedMoveDepth = 3;
+
+private:
+  std::shared_ptr<const Evaluation> evaluation;
+  std::jthread worker;
+  mutable std::mutex cache_mutex;
+  std::unordered_map<uint64_t, SearchResult> cache;
+  std::atomic<bool> report_enabled{true};
+  std::atomic<bool> running{false};
+
+  static uint64_t keyOf(const ChessBoard& board, const PortalSystem& portal_system,
+                        bool is_white);
+  void store(uint64_t key, const SearchResult& result);
+  void join(bool report);
+};
+
+#endif
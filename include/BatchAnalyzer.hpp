@@ -0,0 +1,50 @@
+// BatchAnalyzer.hpp
+#ifndef BATCH_ANALYZER_HPP
+#define BATCH_ANALYZER_HPP
+#include "ChessBoard.hpp"
+#include "ConfigReader.hpp"
+#include "Evaluation.hpp"
+#include "PositionParser.hpp"
+#include <chrono>
+#include <cstddef>
+#include <iosfwd>
+#include <memory>
+
+// Dosyadaki pozisyonları tüm çekirdeklerde analiz edip pozisyon başına bir JSON
+// satırı yazar. Okuma, analiz ve yazma sınırlı kuyruklarla bağlı ayrı
+// aşamalardır; çıktı girdi sırasıyla yazılır.
+//
+// Girdi satırları PositionParser biçimindedir; '#' ile başlayanlar ve boşlar atlanır.
+class BatchAnalyzer {
+public:
+  struct Options {
+    int depth = 0;                          // 0: süre sınırı yoksa 3
+    std::chrono::milliseconds movetime{0};  // pozisyon başına; 0: sınırsız
+    unsigned threads = 0;                   // 0: donanım thread sayısı
+    size_t queue_capacity = 64;
+  };
+
+  // Aşamaların kuyrukta bekleyerek geçirdiği süreler: analiz darboğazsa okuma
+  // dolu kuyrukta bekler, analiz thread'leri ise neredeyse hiç beklemez
+  struct Stats {
+    size_t positions = 0;
+    size_t errors = 0;
+    double elapsed_ms = 0;
+    double reader_blocked_ms = 0;   // dolu girdi kuyruğunda
+    double workers_idle_ms = 0;     // boş girdi kuyruğunda (thread'lerin toplamı)
+    double workers_blocked_ms = 0;  // dolu çıktı kuyruğunda (thread'lerin toplamı)
+    double writer_idle_ms = 0;      // boş çıktı kuyruğunda
+    unsigned threads = 0;
+  };
+
+  BatchAnalyzer(const GameConfig& config, std::shared_ptr<const Evaluation> evaluation,
+                std::shared_ptr<const NnueNetwork> network = nullptr);
+
+  Stats run(std::istream& input, std::ostream& output, const Options& options);
+
+private:
+  std::shared_ptr<const Evaluation> evaluation;
+  PositionParser parser;
+};
+
+#endif
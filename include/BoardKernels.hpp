@@ -0,0 +1,58 @@
+// BoardKernels.hpp
+#ifndef BOARD_KERNELS_HPP
+#define BOARD_KERNELS_HPP
+#include "ChessBoard.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Standart hareket kuralları olan taş türleri; diğerlerinin kenarı yoktur
+enum class PieceKind : uint8_t { Pawn, Knight, Bishop, Rook, Queen, King, Other };
+
+// Küçük harfli taş isminden tür
+PieceKind pieceKindOf(const std::string& piece_lower);
+
+// Hareket kenarı çekirdekleri. Yaygın boyutlar (8, 10, 12, 16) için sınır
+// kontrolleri ve kare tabloları derleme zamanında üretilen şablon sürümleri
+// kullanılır; diğer boyutlar aynı şablonun çalışma zamanı tablolu genel
+// sürümüne düşer. Seçim tahta kurulurken bir kez yapılır (forSize).
+class MoveKernels {
+public:
+  // Bir karenin at veya şah sıçrama hedefleri (kare indeksleri)
+  struct JumpList {
+    uint8_t count = 0;
+    uint16_t squares[8] = {};
+  };
+
+  using EdgeFunction = void (*)(const MoveKernels& kernels, PieceKind kind, const Position& pos,
+                                bool is_white, const ChessBoard::Square* squares,
+                                std::vector<Position>& edges);
+
+  // MoveValidator::getMoveEdges ile aynı sırada ve aynı kurallarla kenarlar
+  void edges(PieceKind kind, const Position& pos, bool is_white,
+             const ChessBoard::Square* squares, std::vector<Position>& out) const {
+    edge_function(*this, kind, pos, is_white, squares, out);
+  }
+
+  int getBoardSize() const { return board_size; }
+  bool isSpecialized() const { return specialized; }
+
+  // Boyuta göre çekirdek: özel sürüm varsa o, yoksa genel sürüm
+  static const MoveKernels& forSize(int board_size);
+  // Her zaman genel sürüm (kıyas için)
+  static const MoveKernels& generic(int board_size);
+
+  // Genel sürümün tabloları (özel sürümler kendi constexpr tablolarını kullanır)
+  std::vector<uint8_t> ray_lengths; // [kare * 8 + yön]
+  std::vector<JumpList> knight_jumps;
+  std::vector<JumpList> king_steps;
+
+private:
+  int board_size = 0;
+  bool specialized = false;
+  EdgeFunction edge_function = nullptr;
+
+  MoveKernels(int board_size, bool specialized, EdgeFunction function);
+};
+
+#endif
@@ -0,0 +1,58 @@
+// BoardRenderer.hpp
+#ifndef BOARD_RENDERER_HPP
+#define BOARD_RENDERER_HPP
+#include "ConfigReader.hpp"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class ChessBoard;
+
+// Tahtayı tek bir tampona çizip tek seferde yazan çizici.
+// Ansi modunda yalnızca değişen kareler yeniden çizilir.
+class BoardRenderer {
+public:
+  enum class Mode {
+    Detailed, // sütun/satır etiketli iki harfli gösterim (varsayılan)
+    Simple,   // tek harfli, etiketsiz gösterim
+    Ansi,     // imleç kodlarıyla sadece değişen kareleri günceller
+    None      // headless çalışma: hiçbir şey çizilmez
+  };
+
+  explicit BoardRenderer(Mode mode = Mode::Detailed);
+
+  // "detailed", "simple", "ansi", "none"; bilinmeyen değerler Detailed olur
+  static Mode modeFromString(const std::string& name);
+
+  // Özel taşlar dahil tüm taş tiplerine config sırasıyla sembol atar
+  void registerPieceTypes(const GameConfig& config);
+
+  // Tahtayı çizer ve çıktıyı tek write ile stdout'a yollar
+  void render(const ChessBoard& board);
+
+  // Bir sonraki render'da tam çizim yapılmasını zorlar
+  void invalidate();
+
+  Mode getMode() const { return mode; }
+  const std::string& lastFrame() const { return frame; }
+  const std::string& symbolFor(const std::string& piece);
+
+private:
+  Mode mode;
+  std::string frame;                 // yeniden kullanılan çıktı tamponu
+  std::vector<int> previous_cells;   // ansi modu için önceki karedeki hücre kodları
+  int previous_size = 0;
+  std::vector<std::string> symbols;  // tip indeksi -> iki harfli sembol (renksiz harf)
+  std::unordered_map<std::string, int> type_index;
+
+  int typeIndexOf(const std::string& piece);
+  int cellCode(const ChessBoard& board, int x, int y);
+  void appendCell(int code);
+  void appendColumnLabels(int size, int label_width);
+  void buildDetailed(const ChessBoard& board);
+  void buildSimple(const ChessBoard& board);
+  void buildAnsi(const ChessBoard& board);
+  void flush();
+};
+
+#endif
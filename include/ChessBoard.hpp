@@ -2,13 +2,25 @@
 #ifndef CHESS_BOARD_HPP
 #define CHESS_BOARD_HPP
 #include "ConfigReader.hpp"
-#include <unordered_map>
+#include "Expected.hpp"
+#include "Nnue.hpp"
+#include "RayCache.hpp"
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
 class MoveValidator;
+class Evaluation;
 class PortalSystem;
 class GameManager;
+class MoveKernels;
+class RayTable;
+enum class PieceKind : uint8_t;   // BoardKernels.hpp
+
+// Kare erişimi ve hamle hataları; fırlatan sürümler mesajı moveErrorText'ten alır
+enum class MoveError { OutOfBounds, EmptySquare, WrongPiece, IllegalMove };
+const char* moveErrorText(MoveError error);
 
 class ChessBoard {
 public:
@@ -21,27 +33,131 @@ public:
     bool is_empty() const { return piece.empty(); }
   };
 
+  // Bir rengin taşları (SoA): tip ID'si ve kare indeksi (y * boyut + x).
+  // Sıra sabit değildir; taş çıkarılınca yerine listenin sonu gelir.
+  struct PieceList {
+    std::vector<int> types;
+    std::vector<int> squares;
+    size_t size() const { return squares.size(); }
+  };
+
+  // Tip ID'si -> isim tablosu. Aynı kural setinden kurulan tahtalar tek tabloyu
+  // paylaşır; tabloda olmayan bir tip görülünce tahta kendi kopyasına geçer.
+  struct TypeTable {
+    std::vector<std::string> names;
+    std::vector<std::string> keys;            // küçük harfli isimler
+    std::vector<abilities::Mask> abilities;   // derlenmiş yetenekler
+    std::vector<PieceKind> kinds;             // hareket türü, isimden bir kez
+    // Varsa mevcut ID'yi (ve yeteneklerini) korur; maske verilmezse isimden varsayılan
+    int add(const std::string& piece, abilities::Mask mask);
+    int add(const std::string& piece) { return add(piece, abilities::defaultsFor(piece)); }
+    int find(const std::string& piece) const;  // birebir isim, yoksa -1
+  };
+
   ChessBoard(int size, const std::string& display_format = "detailed"); 
+  ChessBoard(int size, std::shared_ptr<const TypeTable> types,
+             const std::string& display_format = "detailed");
   int getBoardSize() const;
+  // Config'teki yetenekleri tip tablosuna işler ve taşları dizer
   void initializeBoard(const std::vector<PieceConfig>& piece_configs);
   void placePiece(const std::string& piece, bool is_white, int x, int y);
   void printBoard() const;
-  bool isInBounds(const Position& pos) const;
-  const Square& getSquare(const Position& pos) const;
+  bool isInBounds(const Position& pos) const {
+    return pos.x >= 0 && pos.x < board_size && pos.y >= 0 && pos.y < board_size;
+  }
+  // Tahta dışı için std::out_of_range
+  const Square& getSquare(const Position& pos) const {
+    if (!isInBounds(pos)) throwOutOfRange();
+    return squares[indexOf(pos)];
+  }
+  Expected<const Square*, MoveError> tryGetSquare(const Position& pos) const {
+    if (!isInBounds(pos)) return unexpected(MoveError::OutOfBounds);
+    return &squares[indexOf(pos)];
+  }
+  // promotion boşsa terfi seçimi kullanıcıya sorulur; geçersiz hamlede
+  // std::invalid_argument
   void movePiece(const Position& start, const Position& end, MoveValidator& validator, 
-                 PortalSystem& portal_system, GameManager& game_manager);
+                 PortalSystem& portal_system, GameManager& game_manager,
+                 const std::string& promotion = "");
+  // Fırlatmayan sürüm: geçersiz hamlede tahta değişmez, hata kodu döner
+  Expected<void, MoveError> tryMovePiece(const Position& start, const Position& end,
+                                         MoveValidator& validator, PortalSystem& portal_system,
+                                         GameManager& game_manager,
+                                         const std::string& promotion = "");
   
   // special hareketler
   Position notationToPosition(const std::string& notation) const;
   std::string positionToNotation(const Position& pos) const;
-  void handlePawnPromotion(const Position& pos, bool is_white);
+  void handlePawnPromotion(const Position& pos, bool is_white, const std::string& choice = "");
   void handleCastling(const Position& king_start, const Position& king_end);
 
+  // Değerlendirme: tahta değiştikçe skor farkla güncellenir, sorgu O(1)
+  void attachEvaluation(std::shared_ptr<const Evaluation> eval);
+  int getEvaluation() const; // beyazın bakışıyla, santipiyon
+  const std::shared_ptr<const Evaluation>& getEvaluationTables() const { return evaluation; }
+  // Ağ bağlıysa getEvaluation ağın çıktısını döner; birikeç de setSquare'de
+  // farkla güncellenir, ağ yalnızca skor istendiğinde hesaplanır
+  void attachNetwork(std::shared_ptr<const NnueNetwork> net);
+  const std::shared_ptr<const NnueNetwork>& getNetwork() const { return network; }
+
+  // Zobrist anahtarı: sadece taş yerleşimi, setSquare'de artımlı tutulur
+  uint64_t getHash() const { return board_hash; }
+
+  // false ise hamle mesajları yazılmaz (araçlar ve arama için)
+  void setVerbose(bool value) { verbose = value; }
+
+  // Boyuta göre seçilmiş hareket çekirdekleri ve ham kare dizisi (index = y * boyut + x)
+  const MoveKernels& getKernels() const { return *kernels; }
+  const Square* rawSquares() const { return squares.data(); }
+  // Tüm kareler için ilk engele kadar ışın uzunlukları; tahta değişene kadar önbellekte
+  const RayTable& getRayTable() const { return ray_cache.get(*this); }
+
+  // Taş listeleri: "tüm taşlarım" döngüleri tahta alanı yerine taş sayısı kadar sürer
+  const PieceList& getPieces(bool is_white) const { return piece_lists[is_white ? 1 : 0]; }
+  const std::string& typeName(int type_id) const { return types->names[type_id]; }
+  const std::shared_ptr<const TypeTable>& getTypes() const { return types; }
+  // Büyük/küçük harf duyarsız; tahtada hiç görülmemiş tip için -1
+  int findTypeId(const std::string& piece) const;
+  Position positionOf(int square) const { return {square % board_size, square / board_size}; }
+  // Verilen tipteki ilk taşın yeri; yoksa false
+  bool findPiece(const std::string& piece, bool is_white, Position& pos) const;
+  // royal yetenekli ilk taşın (şahın) yeri; yoksa false
+  bool findRoyal(bool is_white, Position& pos) const;
+  // Karedeki taşın yetenekleri; boş kare veya tahta dışı için 0
+  abilities::Mask abilitiesAt(const Position& pos) const;
+  bool hasAbility(const Position& pos, int ability) const {
+    return abilities::has(abilitiesAt(pos), ability);
+  }
+  // Karedeki taşın hareket türü; boş kare veya tahta dışı için PieceKind::Other
+  PieceKind kindAt(const Position& pos) const;
+  PieceKind typeKind(int type_id) const { return types->kinds[type_id]; }
+
 private:
-  std::unordered_map<std::string, Square> board;
+  std::vector<Square> squares; // satır satır: index = y * board_size + x
   int board_size;
+  const MoveKernels* kernels;
   std::string board_display_format; 
-  std::string posToString(const Position& pos) const;
+  std::shared_ptr<const Evaluation> evaluation;
+  int evaluation_score = 0;
+  std::shared_ptr<const NnueNetwork> network;
+  NnueNetwork::Accumulator accumulator;
+  mutable int network_score = 0;
+  mutable bool network_dirty = true;
+  uint64_t board_hash = 0;
+  bool verbose = true;
+  mutable RayCache ray_cache;
+  PieceList piece_lists[2];            // [0] siyah, [1] beyaz
+  std::vector<int> list_index;         // kare -> listedeki sıra, boş kare -1
+  std::shared_ptr<const TypeTable> types;
+  size_t indexOf(const Position& pos) const {
+    return static_cast<size_t>(pos.y) * board_size + pos.x;
+  }
+  [[noreturn]] static void throwOutOfRange();
+  int internType(const std::string& piece);
+  void registerTypes(const std::vector<PieceConfig>& piece_configs);
+  void addToList(const Square& square, int index);
+  void removeFromList(const Square& square, int index);
+  void setSquare(const Position& pos, const Square& square);
 };
 
 #endif
\ No newline at end of file
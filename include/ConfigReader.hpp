@@ -1,4 +1,7 @@
 #pragma once
+#include "Abilities.hpp"
+#include "Expected.hpp"
+#include <cstdint>
 #include <memory>
 #include <nlohmann/json.hpp>
 #include <string>
@@ -39,6 +42,20 @@ struct SpecialAbilities {
   bool en_passant = false;
   // Additional custom abilities are also welcome
   std::unordered_map<std::string, bool> custom_abilities;
+  // Yukarıdakilerin derlenmiş hali (Abilities.hpp); kural kontrolleri bunu sınar
+  abilities::Mask mask = 0;
+};
+
+// Açık yetenekler için bitleri kurar; özel yetenek isimleri burada ID alır
+abilities::Mask compileAbilities(const SpecialAbilities& special_abilities);
+
+// Evaluation parameters for a piece type
+struct PieceEvaluation {
+  bool has_value = false; // false ise tipin varsayılan değeri kullanılır
+  int value = 0;
+  // board_size*board_size değer, beyazın bakışıyla, index = y * board_size + x.
+  // Siyah için tablo dikey olarak aynalanır. Boşsa sıfır kabul edilir.
+  std::vector<int> piece_square_table;
 };
 
 // Configuration for a chess piece
@@ -48,6 +65,7 @@ struct PieceConfig {
   // unordered map: key- value 
   Movement movement;
   SpecialAbilities special_abilities;
+  PieceEvaluation evaluation;
   int count;
 };
 
@@ -80,19 +98,38 @@ struct GameConfig {
   std::vector<PieceConfig> pieces;
   std::vector<PieceConfig> custom_pieces;
   std::vector<PortalConfig> portals;
+
+  // Global evaluation terms
+  struct {
+    int portal_entry_bonus = 0; // portal girişinde duran, portalı kullanabilen taş
+    int portal_exit_bonus = 0;  // portal çıkışını tutan taş
+    std::string nnue_file;      // optional NNUE weights; empty uses the tables above
+  } evaluation;
+
+  // Hash of the parsed JSON; files derived from a config (e.g. opening
+  // books) store it to refuse being used with a different ruleset
+  uint64_t config_hash = 0;
 };
 
+// Why a configuration failed to load; lastError() has the details
+enum class ConfigError { FileNotFound, Syntax, Schema, Invalid };
+
 class ConfigReader {
 public:
   // Constructor
   ConfigReader();
 
-  // Load configuration from a file
+  // Load configuration from a file (errors are printed to std::cerr)
   bool loadFromFile(const std::string &filePath);
 
-  // Load configuration from a JSON string
+  // Load configuration from a JSON string (errors are printed to std::cerr)
   bool loadFromString(const std::string &jsonString);
 
+  // Same as above without printing parse errors; never throws
+  Expected<void, ConfigError> tryLoadFromFile(const std::string &filePath);
+  Expected<void, ConfigError> tryLoadFromString(const std::string &jsonString);
+  const std::string &lastError() const { return m_error; }
+
   // Get the parsed configuration
   const GameConfig &getConfig() const;
 
@@ -101,6 +138,10 @@ public:
 
 private:
   GameConfig m_config;
+  std::string m_error;
+
+  // Parses all sections and validates; jsonData comes from parse()
+  Expected<void, ConfigError> load(const nlohmann::json &jsonData);
 
   // Parse game settings from JSON
   void parseGameSettings(const nlohmann::json &json);
@@ -117,4 +158,14 @@ private:
   // Parse special abilities from JSON
   void parseSpecialAbilities(const nlohmann::json &abilities,
                              SpecialAbilities &specialAbilities);
+
+  // Parse a piece's special abilities, or apply the defaults for its name
+  void parsePieceAbilities(const nlohmann::json &pieceJson, PieceConfig &piece);
+
+  // Parse piece value and piece-square table from JSON
+  void parsePieceEvaluation(const nlohmann::json &evaluation,
+                            PieceEvaluation &pieceEvaluation);
+
+  // Parse global evaluation settings from JSON
+  void parseEvaluationSettings(const nlohmann::json &json);
 };
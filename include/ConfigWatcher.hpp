@@ -0,0 +1,51 @@
+// ConfigWatcher.hpp
+#ifndef CONFIG_WATCHER_HPP
+#define CONFIG_WATCHER_HPP
+#include "Ruleset.hpp"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Config dosyasını inotify ile izler. Dosya değişince ConfigReader ile yeniden
+// okur ve doğrular, canlı config ile farkını çıkarır, yalnızca etkilenen
+// tabloları kurup yeni kural setini atomik olarak yayınlar. Çalışan oyunlar
+// ellerindeki seti tutmaya devam eder; current() yeni oyunlar içindir.
+// Editörler dosyayı yeniden adlandırarak kaydedebildiği için dizin izlenir.
+class ConfigWatcher {
+public:
+  // Başarılı yüklemede yeni set ve fark, başarısızlıkta boş set ve hata mesajı
+  using Listener = std::function<void(const std::shared_ptr<const Ruleset>& ruleset,
+                                      const ConfigDiff& diff, const std::string& error)>;
+
+  ConfigWatcher(std::string path, std::shared_ptr<const Ruleset> initial);
+  ~ConfigWatcher();
+  ConfigWatcher(const ConfigWatcher&) = delete;
+  ConfigWatcher& operator=(const ConfigWatcher&) = delete;
+
+  // Hata mesajı std::cerr'e yazılır
+  bool start(Listener listener);
+  void stop();
+
+  std::shared_ptr<const Ruleset> current() const { return ruleset.load(); }
+
+  // Dosyayı hemen yeniden okur; değişiklik yayınlandıysa true
+  bool reload();
+
+  // Art arda gelen yazma olayları bu süre sessiz kalınca tek yüklemeye indirgenir
+  static constexpr int kSettleMilliseconds = 50;
+
+private:
+  std::string path;
+  std::atomic<std::shared_ptr<const Ruleset>> ruleset;
+  Listener listener;
+  std::mutex reload_mutex;   // reload() hem izleyiciden hem dışarıdan çağrılabilir
+  std::jthread worker;
+  int inotify_fd = -1;
+
+  void watch(std::stop_token stop, std::string file_name);
+};
+
+#endif
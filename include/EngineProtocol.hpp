@@ -0,0 +1,75 @@
+// EngineProtocol.hpp
+#ifndef ENGINE_PROTOCOL_HPP
+#define ENGINE_PROTOCOL_HPP
+#include "MateSolver.hpp"
+#include "Mcts.hpp"
+#include "PositionParser.hpp"
+#include "Ruleset.hpp"
+#include "Search.hpp"
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+
+// GUI'ler ve otomasyon için UCI benzeri satır protokolü (stdin/stdout):
+//   uci, isready, ucinewgame, setoption name <ad> value <değer>, stop, ponderhit, quit
+//   position startpos [moves ...]
+//   position board|fen <dizilim> <w|b> [diğer FEN alanları] [moves ...]
+//   go [depth N] [movetime ms] [wtime/btime/winc/binc/movestogo ...] [infinite|ponder]
+//   go mate N [nodes N] [movetime ms]: df-pn ile N hamlede mat arar (yalnızca şah çeken hamleler)
+// Uzantılar: "setoption name Config value <dosya>" kural setini değiştirir,
+// "setoption name Engine value MCTS" Monte Carlo aramasına geçer (Threads ile
+// thread sayısı; go nodes N rastgele oyun sayısını sınırlar), "portals" portal
+// durumunu yazar ve "portalsok" ile biter. MCTS ağacı hamleler arasında korunur.
+// Arama ayrı thread'de koşar; girdi poll ile okunduğundan stop arama sürerken
+// işlenir. Çıktı tamponlanır, yalnızca bir yanıt tamamlanınca yazılır.
+class EngineProtocol {
+public:
+  EngineProtocol(std::string config_file, std::shared_ptr<const Ruleset> ruleset,
+                 std::FILE* output = stdout);
+  ~EngineProtocol();
+  EngineProtocol(const EngineProtocol&) = delete;
+  EngineProtocol& operator=(const EngineProtocol&) = delete;
+
+  // quit veya girdi sonuna kadar komut işler
+  int run(int input_fd = 0);
+  // Tek satır; quit gelince false
+  bool handle(const std::string& line);
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  std::string config_file;
+  std::shared_ptr<const Ruleset> ruleset;
+  std::unique_ptr<PositionParser> parser;
+  PositionParser::Setup position;
+  int played_plies = 0;   // oyun başından bu pozisyona kadar (moves ve FEN sayacı)
+  std::FILE* output;
+  std::mutex output_mutex;  // arama thread'i info/bestmove yazar
+  std::jthread worker;
+  bool infinite_search = false;   // worker stop gelene kadar bestmove yazmaz
+  long long ponder_movetime = -1;   // go ponder'da ponderhit sonrası kullanılacak süre (ms)
+  std::jthread ponder_timer;   // ponderhit sonrası süre dolunca worker'ı durdurur
+  bool use_mcts = false;
+  unsigned mcts_threads = 0;
+  std::unique_ptr<Mcts> mcts;   // yalnızca arama thread'i kullanır; ilk MCTS aramasında kurulur
+  std::unique_ptr<MateSolver> mate_solver;   // ilk go mate'te kurulur
+
+  // Satırlar tek yazımda gönderilir ve hemen flush edilir
+  void send(const std::string& lines);
+  void reset();
+  bool loadConfig(const std::string& path, std::string& error);
+  void setOption(std::istringstream& args);
+  void setPosition(std::istringstream& args);
+  void go(std::istringstream& args);
+  void goMcts(Mcts::Limits limits, bool infinite, Clock::time_point start);
+  void goMate(int moves, MateSolver::Limits limits, bool infinite, Clock::time_point start);
+  void ponderHit();
+  void stopSearch();
+  std::string portalState() const;
+};
+
+#endif
@@ -0,0 +1,58 @@
+// Evaluation.hpp
+#ifndef EVALUATION_HPP
+#define EVALUATION_HPP
+#include "ConfigReader.hpp"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class ChessBoard;
+
+// Materyal + taş-kare tablosu + portal kontrolü değerlendirmesi.
+// Tablolar config yüklenirken bir kez birleştirilir; ChessBoard skoru her
+// kare değişiminde squareScore farkıyla günceller, sorgu O(1) olur.
+class Evaluation {
+public:
+  explicit Evaluation(const GameConfig& config);
+
+  // Tek bir taşın skora katkısı, beyazın bakışıyla (siyah taşlar negatif)
+  int squareScore(const std::string& piece, bool is_white, const Position& pos) const;
+
+  // Tüm tahtayı tarayarak skoru baştan hesaplar (doğrulama ve kıyas için)
+  int fullScore(const ChessBoard& board) const;
+
+  int pieceValue(const std::string& piece) const;
+
+  // Config'deki taş tipleri için 0..typeCount()-1; bilinmeyen tip -1
+  int typeId(const std::string& piece) const;
+  int typeCount() const { return static_cast<int>(values.size()); }
+  int getBoardSize() const { return board_size; }
+
+  // Config'de değer verilmemiş tipler için varsayılanlar
+  static int defaultPieceValue(const std::string& piece);
+
+  // Config yeniden yüklendiğinde kopya üzerinde yalnızca etkilenen tabloları günceller.
+  // Tip değerini/tablosunu yeniden hesaplar; yeni tip sona eklenir
+  void updatePieceType(const PieceConfig& piece);
+  // Eski portalın bonusunu geri alır, yenisininkini ekler (biri boş olabilir)
+  void updatePortal(const PortalConfig* removed, const PortalConfig* added);
+
+private:
+  int board_size;
+  std::unordered_map<std::string, int> type_index;
+  std::vector<int> values;
+  // Her tip için önceden birleştirilmiş tablolar: değer + pst + portal bonusu
+  std::vector<std::vector<int>> white_tables;
+  std::vector<std::vector<int>> black_tables;
+  int portal_entry_bonus;
+  int portal_exit_bonus;
+  std::vector<int> white_portal_bonus;
+  std::vector<int> black_portal_bonus;
+
+  void addPieceType(const PieceConfig& piece);
+  void buildTables(const PieceConfig& piece, int& value, std::vector<int>& white,
+                   std::vector<int>& black) const;
+  void applyPortal(const PortalConfig& portal, int sign);
+};
+
+#endif
@@ -0,0 +1,54 @@
+// Expected.hpp
+#ifndef EXPECTED_HPP
+#define EXPECTED_HPP
+#include <optional>
+#include <utility>
+
+// std::expected (C++23) yerine küçük bir karşılık: değer ya da hata kodu.
+// Arama ve doğrulama döngülerinde istisna yerine kullanılır; fırlatan
+// sürümler CLI için bunların üstünde ince sarmalayıcıdır.
+template <typename E>
+struct Unexpected {
+  E error;
+};
+
+template <typename E>
+Unexpected<E> unexpected(E error) {
+  return {error};
+}
+
+template <typename T, typename E>
+class Expected {
+public:
+  Expected(T value) : value_(std::move(value)) {}
+  Expected(Unexpected<E> failure) : error_(failure.error) {}
+
+  bool has_value() const { return value_.has_value(); }
+  explicit operator bool() const { return value_.has_value(); }
+  // Yalnızca has_value() iken
+  const T& value() const { return *value_; }
+  const T& operator*() const { return *value_; }
+  const T* operator->() const { return &*value_; }
+  E error() const { return error_; }
+
+private:
+  std::optional<T> value_;   // T'nin varsayılan kurucusu gerekmez
+  E error_{};
+};
+
+template <typename E>
+class Expected<void, E> {
+public:
+  Expected() : ok_(true) {}
+  Expected(Unexpected<E> failure) : error_(failure.error), ok_(false) {}
+
+  bool has_value() const { return ok_; }
+  explicit operator bool() const { return ok_; }
+  E error() const { return error_; }
+
+private:
+  E error_{};
+  bool ok_;
+};
+
+#endif
@@ -0,0 +1,148 @@
+// GameDatabase.hpp
+#ifndef GAME_DATABASE_HPP
+#define GAME_DATABASE_HPP
+#include "ConfigReader.hpp"
+#include "MoveNotation.hpp"
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+class GameManager;
+
+// Bitmiş oyunların yalnızca sona eklenen ikili deposu. Her kayıt sabit bir
+// başlık, paketlenmiş hamle listesi ve "anahtar=değer" satırlarından oluşan
+// metadata taşır. Okuyucu dosyayı mmap ile açar; ayrı bir indeks dosyası
+// pozisyon hash'inden (oyun, yarım hamle) çiftlerine sıralı girişler tutar.
+class GameDatabase {
+public:
+  enum class Result : uint8_t { Unknown = 0, WhiteWins = 1, BlackWins = 2, Draw = 3 };
+  using Metadata = std::vector<std::pair<std::string, std::string>>;
+
+  struct Header {
+    char magic[8];        // "PCGAMES"
+    uint32_t version;
+    uint32_t reserved;
+    int64_t created;      // unix zamanı
+    uint64_t reserved2;
+  };
+
+  // Ardından ply_count adet paketlenmiş hamle, metadata ve 8 bayta dolgu gelir
+  struct RecordHeader {
+    uint32_t record_size; // başlık dahil, 8'in katı
+    uint32_t ply_count;
+    uint64_t config_hash;
+    int64_t timestamp;
+    uint16_t metadata_size;
+    uint8_t board_size;
+    uint8_t result;       // Result
+    uint32_t reserved;
+  };
+
+  struct IndexHeader {
+    char magic[8];        // "PCGIDX"
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t game_count;  // indeks oluşturulurken depodaki oyun sayısı
+    uint64_t entry_count;
+  };
+
+  // Bir oyunda aynı pozisyon tekrar ederse yalnızca ilk yarım hamle tutulur
+  struct IndexEntry {
+    uint64_t key;         // zobrist::positionKey
+    uint32_t game;
+    uint16_t ply;         // bu pozisyondan önce oynanan yarım hamle sayısı
+    uint16_t reserved;
+  };
+
+  // Depoya eklenecek oyun
+  struct GameRecord {
+    uint64_t config_hash = 0;
+    int board_size = 0;
+    Result result = Result::Unknown;
+    int64_t timestamp = 0;
+    std::vector<CoordinateMove> moves;
+    Metadata metadata;
+  };
+
+  // mmap'lenmiş kayda bakış; dosya kapanana kadar geçerli
+  struct GameView {
+    const RecordHeader* header = nullptr;
+    std::span<const uint32_t> moves;
+    std::string_view metadata;
+  };
+
+  // Kayıtları bellekte biriktirir; her sync_every oyunda bir write ve bir fsync
+  class Writer {
+  public:
+    explicit Writer(size_t sync_every = 64);
+    ~Writer();
+    Writer(const Writer&) = delete;
+    Writer& operator=(const Writer&) = delete;
+
+    // Dosya yoksa oluşturulur; yarım kalmış son kayıt kesilip atılır
+    bool open(const std::string& path);
+    bool append(const GameRecord& game);
+    // Bekleyen kayıtları yazar ve diske indirir
+    bool flush();
+    void close();
+    bool isOpen() const { return fd >= 0; }
+
+  private:
+    int fd = -1;
+    size_t sync_every;
+    size_t pending = 0;
+    std::string buffer;
+    std::string path;
+  };
+
+  static constexpr uint32_t kVersion = 1;
+  static constexpr uint32_t kIndexVersion = 1;
+
+  GameDatabase() = default;
+  ~GameDatabase();
+  GameDatabase(const GameDatabase&) = delete;
+  GameDatabase& operator=(const GameDatabase&) = delete;
+
+  // Hata mesajı std::cerr'e yazılır
+  bool open(const std::string& path);
+  void close();
+  bool isOpen() const { return mapping != nullptr; }
+  size_t size() const { return offsets.size(); }
+  GameView game(size_t id) const;
+
+  // Depodaki oyunları config ile oynatıp indeks dosyasını yazar; config hash'i
+  // farklı olan oyunlar atlanır. Geçersiz hamlede oyunun indekslenmesi durur.
+  bool writeIndex(const std::string& path, const GameConfig& config) const;
+  bool openIndex(const std::string& path);
+  bool hasIndex() const { return index_entries != nullptr; }
+  // Bu pozisyona ulaşan tüm oyunlar, oyun numarasına göre sıralı
+  std::span<const IndexEntry> gamesReaching(uint64_t key) const;
+
+  // Etiketler ve koordinat notasyonunda hamle metni
+  std::string toPgn(size_t id) const;
+
+  static Metadata parseMetadata(std::string_view text);
+  static const char* resultText(Result result);
+  // Kare indeksleri y * board_size + x; terfi harfi en üst baytta
+  static uint32_t packMove(const CoordinateMove& move, int board_size);
+  static CoordinateMove unpackMove(uint32_t packed, int board_size);
+  // GameManager geçmişindeki hamleler; portal ışınlamaları ayrı hamle sayılmaz
+  static std::vector<CoordinateMove> movesFromHistory(const GameManager& game_manager);
+
+private:
+  void* mapping = nullptr;
+  size_t mapping_size = 0;
+  std::vector<size_t> offsets;   // oyun numarası -> kaydın dosyadaki yeri
+
+  void* index_mapping = nullptr;
+  size_t index_mapping_size = 0;
+  const IndexEntry* index_entries = nullptr;
+  size_t index_entry_count = 0;
+
+  void closeIndex();
+};
+
+#endif
@@ -1,12 +1,17 @@
-//#ifndef GAME_MANAGER_HPP
+#ifndef GAME_MANAGER_HPP
 #define GAME_MANAGER_HPP
+#include <cstdint>
 #include <stack>
+#include <utility>
+#include <vector>
 #include "ConfigReader.hpp"
 
 
 class ChessBoard;
 class MoveValidator;
 class PortalSystem;
+class Tablebase;
+struct TablebaseResult;
 
 class GameManager {
 public:
@@ -17,21 +22,64 @@ public:
     bool moved_piece_color; // true white, false black
     std::string captured_piece;
     bool captured_piece_color;
+    std::string promoted_to;       // terfi edilen taş, terfi yoksa boş
+    bool portal_teleport = false;  // önceki hamlenin portal ışınlaması (ayrı hamle değil)
 };
 
 
+    // Sıradaki taraf için oyunun durumu
+    struct GameStatus {
+        enum class Outcome { Ongoing, Checkmate, Stalemate, Repetition, TurnLimit };
+        Outcome outcome = Outcome::Ongoing;
+        bool in_check = false;
+        int legal_moves = 0;        // count_moves yoksa yalnızca 0 veya 1 (hamle var)
+        bool counted = false;       // legal_moves tam sayı mı
+        bool isOver() const { return outcome != Outcome::Ongoing; }
+    };
+
     GameManager(ChessBoard& board, MoveValidator& validator, PortalSystem& portal_system);
     bool isInCheck(bool is_white_turn) const;
+    // Karede rakip bir taş dursaydı by_white renginden bir taş onu alabilir miydi
+    // (isValidMove'un şah çeken tiplerdeki kararıyla aynı). Kareden geriye bakılır:
+    // at sıçramaları, piyon alma kareleri, ilk engele kadar ışınlar, çıkışı bu
+    // kare olan portallar ve geçiş çıkışından bu kareye uzanan ışınlar
+    bool isSquareAttacked(const Position& square, bool by_white) const;
     bool isCheckmate(bool is_white_turn);
-    bool isStalemate(bool is_white_turn) const;
+    bool isStalemate(bool is_white_turn);
+
+    // Şah, mat, pat, üç kez tekrar ve tur sınırı tek geçişte: şah çekenler bir
+    // kez bulunur, yasal hamleler aynı bilgiyle denenir. count_moves false ise
+    // ilk yasal hamlede durulur. Sonuç pozisyon değişene kadar saklanır.
+    // Tekrar, evaluateStatus'un hamle sonrası gördüğü pozisyonlardan sayılır.
+    const GameStatus& evaluateStatus(bool is_white_turn, bool count_moves = false);
+    // Her iki tarafın oynadığı tur sayısı sınırı; 0 sınırsız
+    void setTurnLimit(int turns) { turn_limit = turns; }
     void addToMoveHistory(const Move& move);
     void undoMove(); 
+    // Oynanış sırasıyla hamle geçmişi (en eski önce)
+    std::vector<Move> getMoveHistory() const;
+    // Yeni oyun için geçmişi boşaltır
+    void clearHistory();
+
+    // Oyun sonu tablosu; kapsanan pozisyonlarda sonuç anında bilinir
+    void setTablebase(const Tablebase* tablebase);
+    bool probeTablebase(bool is_white_turn, TablebaseResult& result) const;
 
 private:
     ChessBoard& chess_board;
     MoveValidator& validator;
     PortalSystem& portal_system; 
     std::stack<Move> move_history;
+    const Tablebase* tablebase = nullptr;
+    int turn_limit = 0;
+    int played_moves = 0;  // ışınlama kayıtları hariç
+
+    // Görülen pozisyonlar (geçmiş uzunluğu, anahtar); geri alınınca kırpılır
+    std::vector<std::pair<size_t, uint64_t>> seen_positions;
+    GameStatus status;
+    uint64_t status_key = 0;
+    size_t status_history = 0;
+    bool status_valid = false;
 };
 
-//#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,87 @@
+// GameSnapshot.hpp
+#ifndef GAME_SNAPSHOT_HPP
+#define GAME_SNAPSHOT_HPP
+#include "ChessBoard.hpp"
+#include "Evaluation.hpp"
+#include "Expected.hpp"
+#include "GameManager.hpp"
+#include "MoveNotation.hpp"
+#include "PortalSystem.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Oyun durumunun (tahta, portal cooldown'ları, hamle geçmişi, sıra) kalıcı
+// görüntüsü: "ya şöyle oynansaydı" dalları için. Tahta satır bloklarından
+// oluşur ve bloklar değişmez; dal açmak görüntüyü kopyalamaktır (O(1), birkaç
+// shared_ptr). Hamle oynamak yalnızca değişen satırları ve satır dizisini
+// kopyalar (yol kopyalama), geçmiş ise ortak önekini paylaşan bağlı listedir.
+// Standart kenar hamleleri (rok, en passant, portal ve geçiş dışı) satırlara
+// doğrudan yazılır; diğerlerinde kurallar gerçek tahtada uygulanır: play()
+// tahtayı kurar, hamleyi oynar ve farkı yeni görüntüye yazar.
+class GameSnapshot {
+public:
+  struct Cell {
+    int16_t type = -1;   // TypeTable ID'si, boş kare -1
+    bool is_white = false;
+    bool operator==(const Cell& other) const = default;
+  };
+
+  GameSnapshot(const ChessBoard& board, const PortalSystem& portal_system, bool is_white,
+               const std::vector<GameManager::Move>& history = {});
+
+  // Hamle oynanmış yeni görüntü; bu görüntü değişmez. Terfi seçimi yoksa vezir
+  Expected<GameSnapshot, MoveError> play(const CoordinateMove& move,
+                                         MoveValidator& validator) const;
+
+  // Arama ve çizim için gerçek nesneler; O(boyut²)
+  ChessBoard board(const std::string& display_format = "none") const;
+  PortalSystem portals() const;
+  std::vector<GameManager::Move> history() const;  // en eski önce
+
+  const Cell& at(const Position& pos) const { return (*(*rows)[pos.y])[pos.x]; }
+  int getBoardSize() const { return context->board_size; }
+  bool isWhiteToMove() const { return is_white; }
+  size_t historyLength() const { return history_head ? history_head->length : 0; }
+  uint64_t key() const;
+
+  // Diğer görüntüyle bellekte ortak olan satır sayısı (ölçüm için)
+  size_t sharedRows(const GameSnapshot& other) const;
+
+private:
+  using Row = std::vector<Cell>;
+  using Rows = std::vector<std::shared_ptr<const Row>>;
+
+  // Oyunun tüm görüntülerinde ortak, değişmeyen bilgiler
+  struct Context {
+    int board_size;
+    std::shared_ptr<const Evaluation> evaluation;
+    std::shared_ptr<const NnueNetwork> network;
+    std::shared_ptr<const PortalRules> portal_rules;
+  };
+
+  struct HistoryNode {
+    GameManager::Move move;
+    std::shared_ptr<const HistoryNode> parent;
+    size_t length;
+  };
+
+  std::shared_ptr<const Context> context;
+  std::shared_ptr<const ChessBoard::TypeTable> types;
+  std::shared_ptr<const Rows> rows;
+  std::shared_ptr<const std::vector<int>> cooldowns;
+  std::shared_ptr<const HistoryNode> history_head;
+  uint64_t board_hash = 0;
+  uint64_t portal_hash = 0;
+  bool is_white = true;
+
+  GameSnapshot() = default;
+  static std::vector<Cell> cellsOf(const ChessBoard& board);
+  void pushHistory(const GameManager::Move& move);
+  // Tahta kurmadan oynanabilen hamleyi next'e yazar; false ise next değişmez
+  bool playDirect(const CoordinateMove& move, GameSnapshot& next) const;
+};
+
+#endif
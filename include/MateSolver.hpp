@@ -0,0 +1,92 @@
+// MateSolver.hpp
+#ifndef MATE_SOLVER_HPP
+#define MATE_SOLVER_HPP
+#include "ChessBoard.hpp"
+#include "MoveGenerator.hpp"
+#include "MoveNotation.hpp"
+#include "MoveValidator.hpp"
+#include "PortalSystem.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <stop_token>
+#include <utility>
+#include <vector>
+
+// N hamlede mat çözücüsü: derinlik sınırlı df-pn (derinlik öncelikli ispat
+// sayısı araması). Saldıran yalnızca şah çeken hamleleri, savunan tüm yasal
+// hamleleri (şahtan kaçışları) dener. Her düğüm ispat/çürütme sayılarını
+// negamax biçiminde (sıradaki taraf için phi, rakip için delta) kendi hash
+// tablosunda tutar; anahtar pozisyon ve kalan yarım hamledir. Mat 1'den N'ye
+// artan sınırlarla aranır, böylece bulunan mat en kısasıdır; tablo turlar
+// arasında korunur. Tüm sınırlar çürütülürse N hamlede mat olmadığı kanıtlanmış olur.
+class MateSolver {
+public:
+  enum class Outcome { Mate, NoMate, Unknown };
+
+  struct Limits {
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+    uint64_t max_nodes = 0;   // 0: sınırsız
+    std::stop_token stop;
+  };
+
+  struct Result {
+    Outcome outcome = Outcome::Unknown;
+    int moves = 0;          // Mate: saldıranın hamle sayısı; diğerleri: çürütülmüş en büyük sınır
+    std::vector<CoordinateMove> line;   // saldıran hamlesiyle başlar, mat eden hamleyle biter
+    uint64_t nodes = 0;
+    uint64_t hash_hits = 0;
+    double elapsed_ms = 0;
+  };
+
+  explicit MateSolver(size_t hash_mb = 16);
+
+  // Sıradaki taraf saldırandır; max_moves saldıranın en fazla hamle sayısı
+  Result solve(const ChessBoard& board, const PortalSystem& portal_system, bool is_white,
+               int max_moves, const Limits& limits);
+  Result solve(const ChessBoard& board, const PortalSystem& portal_system, bool is_white,
+               int max_moves) {
+    return solve(board, portal_system, is_white, max_moves, Limits());
+  }
+
+  void clear();
+
+private:
+  // phi + delta doyar; çözülmüş düğümde biri 0, diğeri kInfinity
+  static constexpr uint32_t kInfinity = 1u << 30;
+
+  struct Entry {
+    uint64_t key = 0;
+    uint32_t phi = 0;
+    uint32_t delta = 0;
+  };
+
+  struct Node {
+    ChessBoard board;
+    PortalSystem portals;
+    bool is_white;
+    int plies;   // kalan yarım hamle; tekse sıra saldıranda
+  };
+
+  std::vector<Entry> table;
+  size_t mask = 0;
+  MoveValidator validator;
+  MoveGenerator generator;
+  Limits limits;
+  uint64_t nodes = 0;
+  uint64_t hash_hits = 0;
+  bool aborted = false;
+
+  static uint64_t keyOf(const Node& node);
+  bool probe(uint64_t key, uint32_t& phi, uint32_t& delta);
+  void store(uint64_t key, uint32_t phi, uint32_t delta);
+  // Saldıranda şah çeken hamleler, savunanda tüm yasal hamleler; hamle sonrası düğümler
+  std::vector<std::pair<CoordinateMove, Node>> children(const Node& node) const;
+  // Düğümü eşiklerden birine ulaşana (veya çözülene) kadar arar; (phi, delta) döner
+  std::pair<uint32_t, uint32_t> mid(const Node& node, uint32_t threshold_phi,
+                                    uint32_t threshold_delta);
+  bool checkLimits();
+  std::vector<CoordinateMove> principalLine(Node node);
+};
+
+#endif
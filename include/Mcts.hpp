@@ -0,0 +1,85 @@
+// Mcts.hpp
+#ifndef MCTS_HPP
+#define MCTS_HPP
+#include "ChessBoard.hpp"
+#include "MoveNotation.hpp"
+#include "PortalSystem.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stop_token>
+
+// Monte Carlo ağaç araması: değerlendirme tablolarının zayıf kaldığı özel taş
+// ve portal varyantları için. UCT ile seçilen yaprak bir kez genişletilir,
+// oradan rastgele (hafif politika: alma hamlesi varsa yarı olasılıkla alma)
+// hamlelerle tur sınırına kadar oynanır; sınıra varan oyun berabere sayılır.
+// Thread'ler tek ağacı paylaşır (tree parallelism); inen thread yoldaki
+// düğümlere sanal kayıp ekler, böylece diğerleri başka dallara yönelir.
+// Düğümler sabit boyutlu havuzdan gelir. Ağaç aramalar arasında korunur:
+// yeni kök eski kökün kendisi, çocuğu veya torunuysa alt ağacı yeniden
+// kullanılır, kalanı havuza döner.
+class Mcts {
+public:
+  struct Options {
+    unsigned threads = 0;          // 0: donanım thread sayısı
+    double exploration = 1.4;      // UCT sabiti
+    int rollout_plies = 200;       // rastgele oyunun en fazla yarım hamlesi (tur sınırı x 2)
+    bool light_policy = true;      // false: tamamen rastgele
+    size_t max_nodes = 1 << 20;    // havuz dolunca ağaç büyümez, yapraklardan oynanır
+    int virtual_loss = 3;
+  };
+
+  struct Limits {
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+    uint64_t max_rollouts = 0;     // 0: sınırsız
+    int rollout_plies = -1;        // oyunun kalan yarım hamlesi; -1: Options::rollout_plies
+    std::stop_token stop;
+  };
+
+  struct Result {
+    CoordinateMove best_move{{-1, -1}, {-1, -1}, 0};
+    bool has_move = false;
+    double win_rate = 0.5;         // en iyi hamle için, sıradaki tarafın bakışıyla (beraberlik 0.5)
+    uint64_t rollouts = 0;         // bu aramada
+    uint64_t best_visits = 0;
+    size_t tree_nodes = 0;         // arama sonunda ağaçtaki düğüm
+    size_t reused_nodes = 0;       // önceki aramadan devralınan
+    double elapsed_ms = 0;
+  };
+
+  explicit Mcts(const Options& options);
+  ~Mcts();
+  Mcts(const Mcts&) = delete;
+  Mcts& operator=(const Mcts&) = delete;
+
+  // report, çalışırken yaklaşık her report_interval'da bir çağrılır (ilk thread'den)
+  Result search(const ChessBoard& board, const PortalSystem& portal_system, bool is_white,
+                const Limits& limits,
+                const std::function<void(const Result&)>& report = {},
+                std::chrono::milliseconds report_interval = std::chrono::milliseconds(1000));
+
+  // Ağacı bırakır (yeni oyun)
+  void clear();
+
+private:
+  struct Node;
+  class NodePool;
+  class Worker;
+
+  Options options;
+  std::unique_ptr<NodePool> pool;
+  Node* root = nullptr;
+  // Kökün pozisyonu: yeniden kullanımda yeni kök bununla aranır
+  std::unique_ptr<ChessBoard> root_board;
+  std::unique_ptr<PortalSystem> root_portals;
+  bool root_white = true;
+  int rollout_plies = 0;   // bu aramada geçerli sınır (Limits veya Options)
+
+  size_t reuse(const ChessBoard& board, const PortalSystem& portal_system, bool is_white);
+  void releaseExcept(Node* node, Node* keep);
+  Result summarize(uint64_t rollouts, size_t reused, double elapsed_ms) const;
+};
+
+#endif
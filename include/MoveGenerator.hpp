@@ -0,0 +1,92 @@
+// MoveGenerator.hpp
+#ifndef MOVE_GENERATOR_HPP
+#define MOVE_GENERATOR_HPP
+#include "ChessBoard.hpp"
+#include "MoveNotation.hpp"
+#include "MoveValidator.hpp"
+#include "PortalSystem.hpp"
+#include <limits>
+#include <vector>
+
+// Motor tarafı hamle üretimi. Kurallar MoveValidator'dan gelir; bir hamle,
+// oynandıktan sonra kendi şahını tehdit altında bırakmıyorsa yasaldır
+// (GameManager::isCheckmate ile aynı tanım). Hamleler sessiz uygulanır.
+class MoveGenerator {
+public:
+  // Şah çekenler ve açmazlar; şahtan dışarı ışın ve sıçrama yürüyerek bir kez bulunur
+  struct CheckInfo {
+    bool has_king = false;
+    Position king{-1, -1};
+    std::vector<Position> checkers;   // isValidMove ile doğrulanmış
+    std::vector<Position> blocks;     // kayan şah çekenle şah arasındaki kareler
+    std::vector<Position> pinned;     // şahla rakip kayan taş arasındaki tek kendi taşımız
+    std::vector<Position> discoverers; // şahla rakip kayan taş arasındaki tek rakip taşı
+    // Çıkışı şahın karesi olan bir portalın girişinde rakip taşı var ya da şah
+    // bir portal geçişinin çıkış hattında: hamlemizden sonra şah çekilebilir
+    // (cooldown biterse), bu durumda kısayol kullanılmaz
+    bool portal_threat = false;
+    bool inCheck() const { return !checkers.empty(); }
+  };
+
+  explicit MoveGenerator(MoveValidator& validator);
+
+  CheckInfo analyzeChecks(const ChessBoard& board, const PortalSystem& portal_system,
+                          bool is_white) const;
+
+  // Şahtayken aday hamleler: şah hamleleri, şah çekeni alan ve araya giren hamleler
+  // (portal ışınlamasıyla varılanlar dahil). Yasallık ayrıca doğrulanmalı.
+  std::vector<CoordinateMove> evasionCandidates(const ChessBoard& board,
+                                                const PortalSystem& portal_system,
+                                                bool is_white, const CheckInfo& info) const;
+
+  // isValidMove'un kabul ettiği tüm hamleler; terfiler dört seçenekle
+  std::vector<CoordinateMove> pseudoLegalMoves(const ChessBoard& board,
+                                               const PortalSystem& portal_system,
+                                               bool is_white) const;
+
+  // portal_system geçici olarak değiştirilir ama çağrı sonunda geri yüklenir
+  std::vector<CoordinateMove> legalMoves(const ChessBoard& board, PortalSystem& portal_system,
+                                         bool is_white) const;
+
+  // İlk yasal hamlede durur (mat/pat tespiti için)
+  bool hasLegalMove(const ChessBoard& board, PortalSystem& portal_system, bool is_white) const;
+
+  // info aynı pozisyonun analyzeChecks sonucu; limit hamle bulununca durur
+  int countLegalMoves(const ChessBoard& board, PortalSystem& portal_system, bool is_white,
+                      const CheckInfo& info, int limit = std::numeric_limits<int>::max()) const;
+
+  // Hamleyi mesaj yazmadan uygular; terfi seçimi yoksa vezir olur
+  void makeMove(ChessBoard& board, PortalSystem& portal_system, const CoordinateMove& move) const;
+  // Dışarıdan gelen hamleler için: geçersizse tahta değişmez, hata kodu döner
+  Expected<void, MoveError> tryMakeMove(ChessBoard& board, PortalSystem& portal_system,
+                                        const CoordinateMove& move) const;
+
+  bool inCheck(const ChessBoard& board, PortalSystem& portal_system, bool is_white) const;
+
+  // Rakibe şah çekebilecek aday hamleler: şahın karesini türüne göre gören
+  // hedefler, portal girişleri, açarak şah çekebilen taşların, rok yapabilen
+  // şahın, terfi ve en passant sırasındaki taşların tüm hamleleri. Rakip şaha
+  // portal veya geçiş uzanabiliyorsa tüm sözde yasal hamleler. Yasallık ve şah
+  // ayrıca doğrulanmalı.
+  std::vector<CoordinateMove> checkCandidates(const ChessBoard& board,
+                                              const PortalSystem& portal_system,
+                                              bool is_white) const;
+
+  // movePiece'in terfi ettireceği hamle mi
+  static bool isPromotion(const ChessBoard& board, const Position& from, const Position& to);
+
+private:
+  MoveValidator& validator;
+
+  // Oynanıp kendi şahı kontrol edilmeden yasal sayılabilir mi
+  static bool isSafeWithoutCheck(const CheckInfo& info, const PortalSystem& portal_system,
+                                 const CoordinateMove& move);
+  bool leavesKingSafe(const ChessBoard& board, PortalSystem& portal_system, bool is_white,
+                      const CoordinateMove& move, const std::vector<int>& saved_cooldowns) const;
+  // Aday hamleleri üretir; visit false dönerse durur
+  template <typename Visit>
+  void forEachLegal(const ChessBoard& board, PortalSystem& portal_system, bool is_white,
+                    const CheckInfo& info, Visit&& visit) const;
+};
+
+#endif
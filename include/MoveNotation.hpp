@@ -0,0 +1,24 @@
+// MoveNotation.hpp
+#ifndef MOVE_NOTATION_HPP
+#define MOVE_NOTATION_HPP
+#include "ConfigReader.hpp"
+#include <string>
+
+// Koordinat notasyonunda hamle: "e2e4", büyük tahtalarda "a10b12",
+// terfi için sonda harf: "e7e8q" (q, r, b, n)
+struct CoordinateMove {
+  Position from{0, 0};
+  Position to{0, 0};
+  char promotion = 0; // 0: terfi yok
+};
+
+bool parseSquare(const std::string& text, size_t& offset, int board_size, Position& pos);
+bool parseCoordinateMove(const std::string& text, int board_size, CoordinateMove& move);
+std::string squareToText(const Position& pos);
+std::string formatCoordinateMove(const CoordinateMove& move);
+
+// 'q' -> "Queen"; tanınmayan harf veya 0 için boş dizi
+std::string promotionPieceName(char promotion);
+char promotionLetter(const std::string& piece);
+
+#endif
@@ -0,0 +1,51 @@
+// MoveOrdering.hpp
+#ifndef MOVE_ORDERING_HPP
+#define MOVE_ORDERING_HPP
+#include "ChessBoard.hpp"
+#include "Evaluation.hpp"
+#include "MoveNotation.hpp"
+#include "PortalSystem.hpp"
+#include <vector>
+
+// Aramada iyi hamleleri önce denemek için sıralama:
+//   1. kazandıran veya eşit alışlar (SEE >= 0) ve vezir terfileri
+//   2. ply başına iki killer hamle
+//   3. sessiz hamleler history tablosuna göre (taş ID'si x başlangıç x hedef)
+//   4. kaybettiren alışlar
+class MoveOrdering {
+public:
+  static constexpr int kMaxPly = 64;
+
+  explicit MoveOrdering(const Evaluation& evaluation);
+
+  // Portal farkındalıklı static exchange evaluation: hedef karede karşılıklı
+  // alışların net malzeme sonucu. Alan taş portal girişine düşüp ışınlanırsa
+  // karede geri alınacak taş kalmaz ve dizi orada biter; başka bir portal
+  // girişinden hedefe ışınlanabilen taşlar da saldıran sayılır.
+  int staticExchange(const ChessBoard& board, const PortalSystem& portal_system,
+                     const CoordinateMove& move) const;
+
+  void order(const ChessBoard& board, const PortalSystem& portal_system,
+             std::vector<CoordinateMove>& moves, int ply) const;
+
+  // Beta kesmesi yapan sessiz hamleyi killer ve history tablolarına işler
+  void recordCutoff(const ChessBoard& board, const CoordinateMove& move, int ply, int depth);
+
+  void clear();
+
+  static bool isCapture(const ChessBoard& board, const CoordinateMove& move);
+
+private:
+  const Evaluation& evaluation;
+  int board_size;
+  CoordinateMove killers[kMaxPly][2];
+  std::vector<int> history; // [(tip * 2 + renk) * N + başlangıç] * N + hedef
+
+  size_t historyIndex(const ChessBoard& board, const CoordinateMove& move) const;
+  // vacated: alış dizisinde boşalan kareler (y * N + x), tahtada hâlâ dolu görünür
+  int leastValuableAttacker(const ChessBoard& board, const PortalSystem& portal_system,
+                            const Position& target, bool is_white,
+                            const std::vector<int>& vacated, Position& from) const;
+};
+
+#endif
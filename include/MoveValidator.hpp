@@ -13,13 +13,46 @@ public:
   MoveValidator() = default;
   bool isValidMove(const std::string& piece, const Position& start, const Position& end,
                    bool is_white, const ChessBoard& board, const PortalSystem& portal_system) const;
+  // isValidMove ile aynı karar, geçersizse nedeniyle
+  Expected<void, MoveError> checkMove(const std::string& piece, const Position& start,
+                                      const Position& end, bool is_white,
+                                      const ChessBoard& board,
+                                      const PortalSystem& portal_system) const;
 
   std::string toLowerCase(const std::string& str) const;
+
+  // isValidMove'un kabul edeceği tüm hedef kareler (rok, en passant ve portal dahil)
+  std::vector<Position> generateTargets(const std::string& piece, const Position& start,
+                                        bool is_white, const ChessBoard& board,
+                                        const PortalSystem& portal_system) const;
+
+  // Hamle yalnızca bir portaldan geçen kayan taş ışınıyla mümkünse geçilen
+  // portalın sırası (cooldown'u başlatmak için), değilse -1
+  int passagePortal(const std::string& piece, const Position& start, const Position& end,
+                    bool is_white, const ChessBoard& board,
+                    const PortalSystem& portal_system) const;
+
+  // false ise portal bilgilendirme mesajları yazılmaz
+  void setVerbose(bool value) { verbose = value; }
+
+  // Büyük tahtalarda kayan taş kenarlarını tahtanın ışın tablosundan oku (varsayılan açık)
+  void setRayTables(bool value) { use_ray_tables = value; }
 private:
+  bool verbose = true;
+  bool use_ray_tables = true;
   
  
   std::vector<Position> getMoveEdges(const std::string& piece_lower, const Position& pos, 
                                      bool is_white, const ChessBoard& board) const;
+
+  // preserve_direction'lı açık portaldan geçen ışınların hedefleri
+  struct PassageTarget {
+    Position target;
+    int portal;
+  };
+  std::vector<PassageTarget> passageTargets(const std::string& piece_lower, const Position& start,
+                                            bool is_white, const ChessBoard& board,
+                                            const PortalSystem& portal_system) const;
   
   bool bfsValidateMove(const std::string& piece_lower, const Position& start, 
                        const Position& end, bool is_white, const ChessBoard& board, 
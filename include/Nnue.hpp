@@ -0,0 +1,138 @@
+// Nnue.hpp
+#ifndef NNUE_HPP
+#define NNUE_HPP
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class ChessBoard;
+class Evaluation;
+
+// NNUE tarzı değerlendirme ağı. Girdi seyrek (renk, tip, kare) özellikleridir;
+// boyutu tahta boyutu ve ağdaki tip sayısından gelir. İlk katmanın çıktısı
+// (birikeç) tahtada tutulur ve her kare değişiminde iki satırlık farkla
+// güncellenir; değerlendirme yalnızca küçük yoğun katmanları hesaplar.
+// Birikecin yanında özellik başına bir taş-kare değeri toplanır ve çıktıya
+// doğrudan eklenir (el yapımı tabloların karşılığı).
+//
+//   girdi  : clamp(birikeç, 0, 127)                         int16[hidden]
+//   ara 1  : clamp((W1 * girdi + b1) >> kDenseShift, 0, 127) int16[dense]
+//   ara 2  : clamp((W2 * ara1 + b2) >> kDenseShift, 0, 127)  int16[dense]
+//   çıktı  : taş-kare toplamı + ((w * ara2 + b) >> kOutputShift), beyazın bakışıyla
+//
+// Ağırlıklar ikili dosyadan mmap ile okunur, kopyalanmaz. Yoğun katmanlar
+// int16 çarpıp int32 toplayan AVX2 veya SSE2 çekirdekleriyle hesaplanır;
+// çalışma zamanında en iyisi seçilir, x86 dışında skaler sürüm çalışır.
+// Üç sürüm de aynı tamsayı sonucunu verir.
+class NnueNetwork {
+public:
+  struct Header {
+    char magic[8];        // "PCNNUE1"
+    uint32_t version;
+    uint32_t board_size;
+    uint32_t type_count;
+    uint32_t hidden;      // 16'nın katı
+    uint32_t dense;       // 16'nın katı
+    uint32_t reserved;
+  };
+  // Başlıktan sonra sırayla: tip adları (kNameSize bayt, sıfırla doldurulmuş),
+  // taş-kare int32[girdi], birikeç sapması int16[hidden], özellik ağırlıkları
+  // int16[girdi][hidden], b1 int32[dense], W1 int16[dense][hidden], b2 int32[dense],
+  // W2 int16[dense][dense], b int32, w int16[dense].
+  // Özellik indeksi ((beyaz ? 1 : 0) * tip sayısı + tip) * boyut² + kare
+
+  // Dosya yazmak ve başlangıç ağı kurmak için ağırlıkların bellekteki hali
+  struct Weights {
+    int board_size = 0;
+    int hidden = 0;
+    int dense = 0;
+    std::vector<std::string> types;
+    std::vector<int32_t> psqt;
+    std::vector<int16_t> feature_bias;
+    std::vector<int16_t> feature_weights;
+    std::vector<int32_t> dense1_bias;
+    std::vector<int16_t> dense1_weights;
+    std::vector<int32_t> dense2_bias;
+    std::vector<int16_t> dense2_weights;
+    int32_t output_bias = 0;
+    std::vector<int16_t> output_weights;
+  };
+
+  // Tahtada tutulan ilk katman çıktısı
+  struct Accumulator {
+    std::vector<int16_t> hidden;
+    int32_t psqt = 0;
+  };
+
+  enum class Backend { Scalar, Sse2, Avx2 };
+
+  static constexpr uint32_t kVersion = 1;
+  static constexpr size_t kNameSize = 32;
+  static constexpr int kMaxHidden = 2048;
+  static constexpr int kMaxDense = 256;
+  static constexpr int kActivationMax = 127;
+  static constexpr int kDenseShift = 6;
+  static constexpr int kOutputShift = 4;
+
+  ~NnueNetwork();
+  NnueNetwork(const NnueNetwork&) = delete;
+  NnueNetwork& operator=(const NnueNetwork&) = delete;
+
+  // Dosya bozuksa veya başka tahta boyutu içinse nullptr; neden error'a yazılır
+  static std::shared_ptr<const NnueNetwork> open(const std::string& path, int board_size,
+                                                 std::string& error);
+  static bool write(const std::string& path, const Weights& weights, std::string& error);
+
+  // Taş-kare kısmı evaluation'ın tablolarıyla aynı olan ağ: yoğun katmanlar
+  // seed'den küçük rastgele değerler alır, çıkış ağırlıkları output_scale
+  // aralığında (0 ise sıfır: ağ el yapımı değerlendirmeyi birebir verir).
+  // Eğitime başlangıç noktası ve çekirdeklerin ölçümü için.
+  static Weights initialWeights(const Evaluation& evaluation,
+                                const std::vector<std::string>& types, int hidden, int dense,
+                                uint64_t seed, int output_scale = 0);
+
+  // Ağın bilmediği tip veya boş kare için -1 (katkısı yok)
+  int feature(const std::string& piece, bool is_white, int square) const;
+
+  // Birikeç tahtadan baştan kurulur
+  void refresh(const ChessBoard& board, Accumulator& accumulator) const;
+  // Bir karedeki taş değişti: eski özellik çıkar, yenisi girer (biri -1 olabilir)
+  void update(Accumulator& accumulator, int removed, int added) const;
+  void update(Accumulator& accumulator, int removed, int added, Backend backend) const;
+
+  int evaluate(const Accumulator& accumulator) const;
+  int evaluate(const Accumulator& accumulator, Backend backend) const;
+
+  int getBoardSize() const { return static_cast<int>(header->board_size); }
+  int getHidden() const { return static_cast<int>(header->hidden); }
+  int getDense() const { return static_cast<int>(header->dense); }
+  int inputCount() const { return input_count; }
+  size_t fileSize() const { return mapping_size; }
+
+  static bool supports(Backend backend);
+  static Backend defaultBackend();
+  static const char* backendName(Backend backend);
+
+private:
+  NnueNetwork() = default;
+
+  void* mapping = nullptr;
+  size_t mapping_size = 0;
+  const Header* header = nullptr;
+  int input_count = 0;
+  std::unordered_map<std::string, int> type_slots;
+  const int32_t* psqt = nullptr;
+  const int16_t* feature_bias = nullptr;
+  const int16_t* feature_weights = nullptr;
+  const int32_t* dense1_bias = nullptr;
+  const int16_t* dense1_weights = nullptr;
+  const int32_t* dense2_bias = nullptr;
+  const int16_t* dense2_weights = nullptr;
+  const int32_t* output_bias = nullptr;
+  const int16_t* output_weights = nullptr;
+};
+
+#endif
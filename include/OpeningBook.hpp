@@ -0,0 +1,63 @@
+// OpeningBook.hpp
+#ifndef OPENING_BOOK_HPP
+#define OPENING_BOOK_HPP
+#include "MoveNotation.hpp"
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+// Pozisyon hash'ine göre sıralı ikili açılış kitabı. Dosya mmap ile açılır,
+// yüklemede ayrıştırma yapılmaz; arama girişler üzerinde ikili aramadır.
+// Kitap bir config hash'ine bağlıdır: portallar oyunu değiştirdiği için
+// başka bir config ile açılmaya çalışılırsa reddedilir.
+class OpeningBook {
+public:
+  struct Header {
+    char magic[8];        // "PCBOOK1"
+    uint32_t version;
+    uint32_t board_size;
+    uint64_t config_hash;
+    uint64_t entry_count;
+  };
+
+  // Kare indeksleri y * board_size + x
+  struct Entry {
+    uint64_t key;
+    uint16_t from;
+    uint16_t to;
+    uint16_t count;   // bu hamlenin kayıtlarda görülme sayısı
+    char promotion;   // 0 veya q/r/b/n
+    uint8_t reserved;
+  };
+
+  static constexpr uint32_t kVersion = 1;
+
+  OpeningBook() = default;
+  ~OpeningBook();
+  OpeningBook(const OpeningBook&) = delete;
+  OpeningBook& operator=(const OpeningBook&) = delete;
+
+  // Hata mesajı std::cerr'e yazılır
+  bool open(const std::string& path, uint64_t config_hash);
+  void close();
+  bool isOpen() const { return entries != nullptr; }
+  size_t size() const { return entry_count; }
+
+  // Pozisyona ait girişler, en sık oynanan önce
+  std::span<const Entry> lookup(uint64_t key) const;
+  CoordinateMove toMove(const Entry& entry) const;
+
+  // Girişleri sıralar, aynı hamleleri birleştirir ve dosyaya yazar
+  static bool write(const std::string& path, uint64_t config_hash, int board_size,
+                    std::vector<Entry> entries);
+
+private:
+  void* mapping = nullptr;
+  size_t mapping_size = 0;
+  const Entry* entries = nullptr;
+  size_t entry_count = 0;
+  int board_size = 0;
+};
+
+#endif
@@ -0,0 +1,42 @@
+// Perft.hpp
+#ifndef PERFT_HPP
+#define PERFT_HPP
+#include "ChessBoard.hpp"
+#include "MoveNotation.hpp"
+#include "PortalSystem.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Verilen derinlikteki yasal hamle ağacının yaprak sayısı: hamle üretiminin
+// doğruluk ölçüsü ve hız testi. Kök hamleleri görev olur ve thread başına
+// work-stealing kuyruklarına dağıtılır; bir thread boşta kaldığında çalışan
+// thread'ler sıradaki büyük alt ağaçlarını görev olarak kuyruklarına bırakır.
+// Her görev kendi tahta ve cooldown kopyasıyla çalışır. İsteğe bağlı
+// paylaşılan tablo, aynı pozisyon ve derinliğin yaprak sayısını saklar
+// (transpozisyonlar bir kez sayılır).
+class Perft {
+public:
+  struct Options {
+    unsigned threads = 0;   // 0: donanım thread sayısı
+    int split_depth = 3;    // kalan derinliği en az bu kadar olan alt ağaçlar bölünebilir
+    size_t hash_mb = 0;     // 0: tablo yok
+  };
+
+  struct Result {
+    uint64_t nodes = 0;
+    // Kök hamlesi başına yaprak sayısı (divide)
+    std::vector<std::pair<CoordinateMove, uint64_t>> divide;
+    double elapsed_ms = 0;
+    unsigned threads = 0;
+    uint64_t tasks = 0;       // kök görevleri dahil
+    uint64_t steals = 0;
+    uint64_t hash_hits = 0;
+  };
+
+  static Result run(const ChessBoard& board, const PortalSystem& portal_system, bool is_white,
+                    int depth, const Options& options);
+};
+
+#endif
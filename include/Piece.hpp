@@ -13,6 +13,7 @@ public:
     int y;
     Movement movement;
     SpecialAbilities special_abilities;
+    abilities::Mask ability_mask; // config'te derlenmiş maske ve elle kurulan bayraklar
     bool hasMoved;
 
     Piece(const std::string& type,
@@ -27,6 +28,7 @@ public:
         y(y),
         movement(movement),
         special_abilities(special_abilities),
+        ability_mask(special_abilities.mask | compileAbilities(special_abilities)),
         hasMoved(hasMoved) {}
 
     // en son
@@ -2,12 +2,42 @@
 #define PORTAL_SYSTEM_HPP
 #include "ChessBoard.hpp"
 #include "ConfigReader.hpp"
-#include <queue>
-#include <unordered_map>
+#include <cstdint>
+#include <memory>
 #include <string>
 
+// Config'ten bir kez kurulan, değişmeyen portal tabloları. Aynı kural setiyle
+// oynanan tüm oyunlar tek kopyayı paylaşır; oyuna özgü olan yalnızca cooldown
+// sayaçlarıdır. Aynı id'li portallar tek sayacı paylaşır.
+struct PortalRules {
+    std::vector<PortalConfig> portals;
+    std::vector<uint8_t> color_masks;    // portal -> bit 0 beyaz, bit 1 siyah
+    std::vector<int> slots;              // portal -> cooldown sayacı
+    std::vector<std::string> slot_ids;   // sayaç -> portal id'si
+    std::vector<uint64_t> slot_hashes;   // sayaç -> id'nin hash'i (stateHash için)
+    std::vector<int> first_at_entry;     // giriş karesi (y * width + x) -> ilk portal, yoksa -1
+    std::vector<int> next_at_entry;      // portal -> aynı girişteki sonraki portal, yoksa -1
+    // preserve_direction'lı portalların girişleri: kayan taşın ışını buradan
+    // çıkışa geçip aynı yönde sürer
+    std::vector<int> passage_at_entry;   // giriş karesi -> geçiş girişi sırası, yoksa -1
+    std::vector<Position> passage_entries;
+    int width = 0;
+
+    explicit PortalRules(const std::vector<PortalConfig>& portals);
+
+    int firstAt(const Position& entry) const;
+    // Girişi ve çıkışı verilen portal; yoksa -1
+    int find(const Position& entry, const Position& exit) const;
+    bool allows(int portal, bool is_white) const {
+        return (color_masks[portal] & (is_white ? 1 : 2)) != 0;
+    }
+    int passageSlotAt(const Position& entry) const;
+};
+
 class PortalSystem {
 public:
+    explicit PortalSystem(std::shared_ptr<const PortalRules> rules);
+    // Kendi tablolarını kurar; çok sayıda oyun için paylaşılan kurallar tercih edilmeli
     PortalSystem(const std::vector<PortalConfig>& portals);
     bool isPortalMove(const Position& start, const Position& end) const;
     bool validatePortalMove(const std::string& piece, const Position& start, 
@@ -15,12 +45,42 @@ public:
     void handlePortalMove(const Position& start, const Position& end, ChessBoard& board);
     void updateCooldowns();
     bool isPortalInCooldown(const Position& start, const Position& end) const;
-    const std::vector<PortalConfig>& getPortals() const { return portals_; }
+    // Portalın kalan cooldown turu; mesaj yazmaz (sıcak yollardaki sorgular için)
+    int cooldownOf(int portal) const { return cooldowns_[rules_->slots[portal]]; }
+    const std::vector<PortalConfig>& getPortals() const { return rules_->portals; }
+    const std::shared_ptr<const PortalRules>& getRules() const { return rules_; }
+
+    // Bu karede, verilen renk için şu an kullanılabilir bir portal girişi varsa o portal
+    const PortalConfig* activePortalAt(const Position& entry, bool is_white) const;
+
+    // Kayan taş ışını bu boş girişten geçip çıkıştan aynı yönde sürebiliyorsa
+    // portalın sırası, yoksa -1. Tablo cooldown değiştikçe yenilenir; sorgu O(1)
+    int passageAt(const Position& entry, bool is_white) const;
+    bool hasOpenPassage(bool is_white) const { return open_passages_[is_white ? 1 : 0] > 0; }
+    const std::vector<Position>& getPassageEntries() const { return rules_->passage_entries; }
+    // Cooldown'a bakmadan: bu renk için bir geçişin çıkış ışını hedefe uzanabilir mi
+    bool passageMayReach(const Position& target, bool is_white) const;
+    // Portaldan geçen hamle sonrası: ışınlamayla aynı cooldown başlar
+    void startCooldown(int portal);
+
+    // Aktif cooldown durumunun hash'i; cooldown yoksa 0
+    uint64_t stateHash() const;
+
+    // Portal sırasıyla kalan cooldown sayaçları (tablebase indeksleme için)
+    std::vector<int> getCooldownState() const;
+    void setCooldownState(const std::vector<int>& state);
+
+    // false ise cooldown ve renk kısıtı mesajları yazılmaz
+    void setVerbose(bool value) { verbose = value; }
 
 private:
-    std::vector<PortalConfig> portals_;
-    std::queue<std::string> cooldown_queue_;
-    std::unordered_map<std::string, int> cooldowns_;
+    bool verbose = true;
+    std::shared_ptr<const PortalRules> rules_;
+    std::vector<int> cooldowns_;  // sayaç başına kalan tur
+    std::vector<int> passages_;   // geçiş girişi * 2 + renk (1 beyaz) -> açık portal, yoksa -1
+    int open_passages_[2] = {0, 0};
+
+    void refreshPassages();
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,44 @@
+// PositionParser.hpp
+#ifndef POSITION_PARSER_HPP
+#define POSITION_PARSER_HPP
+#include "ChessBoard.hpp"
+#include "ConfigReader.hpp"
+#include "Evaluation.hpp"
+#include "PortalSystem.hpp"
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+// Metin olarak verilen pozisyonu tahtaya kurar (toplu analiz ve motor protokolü):
+//   e2e4 e7e5                      başlangıç pozisyonundan hamleler
+//   startpos [hamleler]            aynı; hamlesiz başlangıç pozisyonu için
+//   board <dizilim> <w|b> [hamle]  dizilim üst sıradan başlar, sıralar '/' ile
+//                                  ayrılır; harfler "simple" gösterimdeki
+//                                  semboller (büyük beyaz), sayılar boş kare;
+//                                  FEN'deki N de at olarak okunur
+class PositionParser {
+public:
+  // Tahta, portal durumu ve sıra
+  struct Setup {
+    std::optional<ChessBoard> board;
+    std::optional<PortalSystem> portals;
+    bool is_white = true;
+  };
+
+  PositionParser(const GameConfig& config, std::shared_ptr<const Evaluation> evaluation,
+                 std::shared_ptr<const NnueNetwork> network = nullptr);
+
+  // Hata mesajı error'a yazılır; hamleler sessiz oynanır
+  bool parse(const std::string& line, Setup& setup, std::string& error) const;
+
+private:
+  int board_size;
+  std::shared_ptr<const Evaluation> evaluation;
+  std::shared_ptr<const NnueNetwork> network;
+  std::shared_ptr<const PortalRules> portal_rules;    // tüm pozisyonlarda ortak
+  ChessBoard initial_board;                           // başlangıç dizilimi
+  std::unordered_map<char, std::string> symbol_types; // büyük harf sembol -> taş tipi
+};
+
+#endif
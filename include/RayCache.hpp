@@ -0,0 +1,26 @@
+// RayCache.hpp
+#ifndef RAY_CACHE_HPP
+#define RAY_CACHE_HPP
+#include <memory>
+
+class ChessBoard;
+class RayTable;
+
+// ChessBoard'un ışın tablosu önbelleği: tahta değişince geçersizleşir, tahta
+// kopyalanınca kopyalanmaz (kopya ilk sorguda kendi tablosunu hesaplar)
+class RayCache {
+public:
+  RayCache();
+  RayCache(const RayCache&);
+  RayCache& operator=(const RayCache&);
+  ~RayCache();
+
+  void invalidate() { valid = false; }
+  const RayTable& get(const ChessBoard& board);
+
+private:
+  std::unique_ptr<RayTable> table;
+  bool valid = false;
+};
+
+#endif
@@ -0,0 +1,55 @@
+// RayScan.hpp
+#ifndef RAY_SCAN_HPP
+#define RAY_SCAN_HPP
+#include "BoardKernels.hpp"
+#include "ChessBoard.hpp"
+#include <cstdint>
+#include <vector>
+
+// Tüm kareler için sekiz yönde ilk engele kadar (engel dahil) ışın uzunlukları.
+// Doluluk satır başına 32 baytlık paketlenmiş düzende tutulur; bir satırın tüm
+// kareleri tek vektörde işlenir. AVX2 varsa çalışma zamanında o sürüm seçilir,
+// yoksa aynı düzen üzerinde skaler sürüm çalışır.
+//
+// Yönler BoardKernels ile aynı sırada: 0 (0,1), 1 (0,-1), 2 (1,0), 3 (-1,0),
+// 4 (1,1), 5 (1,-1), 6 (-1,1), 7 (-1,-1)
+class RayTable {
+public:
+  static constexpr int kStride = 32;          // satır başına bayt (şerit)
+  static constexpr int kMaxBoardSize = kStride - 1;
+  // Bu boyuttan itibaren kayan taş kenarları tablodan okunur
+  static constexpr int kMinBoardSize = 16;
+
+  enum class Backend { Scalar, Avx2 };
+
+  explicit RayTable(int board_size);
+
+  void compute(const ChessBoard& board);
+  void compute(const ChessBoard& board, Backend backend);
+
+  int length(int x, int y, int dir) const { return lengths[dir][rowOffset(y) + x]; }
+
+  // Kayan taşın kenarlarını getMoveEdges sırasıyla ekler
+  void appendSliderEdges(PieceKind kind, const Position& pos,
+                         std::vector<Position>& edges) const;
+
+  int getBoardSize() const { return board_size; }
+  static bool supports(int board_size) { return board_size > 0 && board_size <= kMaxBoardSize; }
+  static bool avx2Available();
+  static Backend defaultBackend();
+
+private:
+  int board_size;
+  // Satır düzeni: tahtanın altında ve üstünde birer boş dolgu satırı, onların da
+  // dışında kaydırmalı yüklemeler için birer boşluk satırı; (board_size + 4) * kStride
+  static size_t rowOffset(int y) { return static_cast<size_t>(y + 2) * kStride; }
+  std::vector<uint8_t> occupied;  // dolu kare 0xFF
+  std::vector<uint8_t> on_board;  // tahta içi kare 0xFF
+  std::vector<uint8_t> lengths[8];
+
+  void fillOccupancy(const ChessBoard& board);
+  void computeScalar();
+  void computeAvx2();
+};
+
+#endif
@@ -0,0 +1,51 @@
+// Ruleset.hpp
+#ifndef RULESET_HPP
+#define RULESET_HPP
+#include "ConfigReader.hpp"
+#include "Evaluation.hpp"
+#include "Nnue.hpp"
+#include "PortalSystem.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// İki config arasındaki fark; yeniden yüklemede neyin kurulacağını belirler
+struct ConfigDiff {
+  bool full_rebuild = false;       // tahta boyutu veya global değerlendirme terimleri değişti
+  bool settings_changed = false;   // isim, hamle sınırı
+  std::vector<std::string> pieces;        // eklenen, kaldırılan veya değişen taş tipleri
+  std::vector<std::string> piece_tables;  // değer/taş-kare tablosu değişen tipler
+  std::vector<std::string> portals;       // eklenen, kaldırılan veya değişen portal id'leri
+
+  bool empty() const;
+  std::string summary() const;
+};
+
+ConfigDiff diffConfigs(const GameConfig& before, const GameConfig& after);
+
+// Bir config'ten türetilmiş, değişmeyen kural seti. Oyunlar başlarken güncel
+// seti alır ve bitene kadar tutar; yeniden yükleme yeni bir nesne yayınlar.
+// Taş tipleri, portal tabloları ve değerlendirme tabloları oyunlar arasında
+// paylaşılır (hareket çekirdekleri zaten boyut başına tektir); oyunda kalan
+// yalnızca tahta, cooldown sayaçları ve hamle geçmişidir.
+struct Ruleset {
+  GameConfig config;
+  std::shared_ptr<const Evaluation> evaluation;
+  std::shared_ptr<const ChessBoard::TypeTable> piece_types;
+  std::shared_ptr<const PortalRules> portal_rules;
+  std::shared_ptr<const NnueNetwork> network;   // config'te ağ yoksa boş
+  uint64_t generation = 1;
+
+  // Başlangıç dizilimiyle, bu setin tablolarını kullanan yeni oyun durumu
+  ChessBoard createBoard(const std::string& display_format = "detailed") const;
+  PortalSystem createPortals() const { return PortalSystem(portal_rules); }
+
+  static std::shared_ptr<const Ruleset> create(GameConfig config);
+  // Değişmeyen türetilmiş yapılar eski setle paylaşılır; değerlendirme
+  // tabloları yalnızca farkta geçen tipler ve portallar için yeniden kurulur
+  static std::shared_ptr<const Ruleset> update(const Ruleset& live, GameConfig config,
+                                               const ConfigDiff& diff);
+};
+
+#endif
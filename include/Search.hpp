@@ -0,0 +1,71 @@
+// Search.hpp
+#ifndef SEARCH_HPP
+#define SEARCH_HPP
+#include "ChessBoard.hpp"
+#include "Evaluation.hpp"
+#include "MoveGenerator.hpp"
+#include "MoveOrdering.hpp"
+#include "PortalSystem.hpp"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <stop_token>
+
+struct SearchResult {
+  CoordinateMove best_move{{-1, -1}, {-1, -1}, 0};
+  int score = 0;       // hamle sırasındaki tarafın bakışıyla
+  int depth = 0;       // tamamlanan son derinlik
+  uint64_t nodes = 0;
+  bool has_move = false;
+};
+
+// Iterative deepening sınırları. Durdurma isteği veya süre dolunca yarım kalan
+// derinlik atılır, son tamamlanan derinliğin sonucu döner.
+struct SearchLimits {
+  int start_depth = 1;
+  int max_depth = MoveOrdering::kMaxPly - 1;
+  std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+  std::stop_token stop;
+  // Önceki aramadan bilinen en iyi hamle: kökte ilk denenir
+  CoordinateMove hint{{-1, -1}, {-1, -1}, 0};
+};
+
+// Sabit derinlikli alpha-beta (negamax). Yasallık hamle oynandıktan sonra
+// kontrol edilir; portal cooldown'ları her hamleden sonra geri yüklenir.
+class Search {
+public:
+  static constexpr int kMateScore = 1000000;
+
+  Search(const Evaluation& evaluation, MoveValidator& validator);
+
+  SearchResult search(const ChessBoard& board, PortalSystem& portal_system, bool is_white,
+                      int depth);
+
+  // Her tamamlanan derinlikte on_depth çağrılır
+  SearchResult iterate(const ChessBoard& board, PortalSystem& portal_system, bool is_white,
+                       const SearchLimits& limits,
+                       const std::function<void(const SearchResult&)>& on_depth = {});
+
+  // false ise hamleler üretildiği sırayla denenir (ölçüm için)
+  void setOrdering(bool enabled) { ordering_enabled = enabled; }
+  MoveOrdering& getOrdering() { return ordering; }
+
+private:
+  const Evaluation& evaluation;
+  MoveGenerator generator;
+  MoveOrdering ordering;
+  bool ordering_enabled = true;
+  uint64_t nodes = 0;
+
+  // Durdurma kontrolü her düğümde değil, kStopCheckInterval düğümde bir yapılır
+  static constexpr uint64_t kStopCheckInterval = 256;
+  const SearchLimits* limits = nullptr;
+  bool aborted = false;
+  CoordinateMove root_hint{{-1, -1}, {-1, -1}, 0};
+
+  bool shouldStop();
+  int negamax(const ChessBoard& board, PortalSystem& portal_system, bool is_white, int depth,
+              int ply, int alpha, int beta, CoordinateMove* best_move);
+};
+
+#endif
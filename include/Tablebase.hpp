@@ -0,0 +1,102 @@
+// Tablebase.hpp
+#ifndef TABLEBASE_HPP
+#define TABLEBASE_HPP
+#include "ChessBoard.hpp"
+#include "ConfigReader.hpp"
+#include "PortalSystem.hpp"
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Sonuç, sıradaki tarafın bakışıyla
+struct TablebaseResult {
+  enum class Outcome { Win, Draw, Loss };
+  Outcome outcome = Outcome::Draw;
+  int plies_to_mate = 0; // Draw için 0
+};
+
+// Az taşlı oyun sonları için kazanç/beraberlik/kayıp + mata uzaklık tabloları.
+// Her malzeme dağılımı (ör. KQvK) ayrı bir dosyadır; dosyada pozisyon başına
+// bir bayt vardır: 0 beraberlik, 255 geçersiz, diğerleri mata yarım hamle + 1
+// (tek sayıda yarım hamle: sıradaki taraf kazanır). Dosyalar mmap ile açılır.
+//
+// İndeks: ((sıra * cooldown_durumları + cooldown) * N + kare_0) * N + kare_1 ...
+// N = board_size^2, cooldown portal başına 0..cooldown sayaçlarının karışık tabanı.
+class Tablebase {
+public:
+  struct Header {
+    char magic[8]; // "PCTB1"
+    uint32_t version;
+    uint32_t board_size;
+    uint64_t config_hash;
+    uint64_t entry_count;
+    uint32_t piece_count;
+    uint32_t cooldown_states;
+  };
+
+  struct Piece {
+    std::string type;
+    bool is_white;
+  };
+
+  // Sabit sıradaki taş listesi: önce beyazlar, her renkte şah önce
+  using Material = std::vector<Piece>;
+
+  static constexpr uint32_t kVersion = 1;
+  static constexpr int kMaxPieces = 4;
+  static constexpr uint8_t kDraw = 0;
+  static constexpr uint8_t kInvalid = 255;
+
+  Tablebase(const GameConfig& config, const std::string& directory);
+  ~Tablebase();
+  Tablebase(const Tablebase&) = delete;
+  Tablebase& operator=(const Tablebase&) = delete;
+
+  // Tablo yoksa veya pozisyon kapsam dışındaysa false
+  bool probe(const ChessBoard& board, const PortalSystem& portal_system, bool is_white_turn,
+             TablebaseResult& result) const;
+
+  // "KQvK", "KRvKP", özel taşlar için "K[Wizard]vK"
+  static bool parseSignature(const std::string& text, const GameConfig& config,
+                             Material& material);
+  static std::string signatureOf(const Material& material);
+  static void canonicalize(Material& material);
+
+  // Dizin düzeni; üretici ile ortak
+  static uint64_t cooldownStateCount(const GameConfig& config);
+  static uint64_t entryCount(const GameConfig& config, const Material& material);
+
+  // Tahtadaki taşlar malzeme sırasıyla ve kareleriyle (y * board_size + x)
+  struct Placement {
+    Material material;
+    std::vector<int> squares;
+  };
+  static void placementOf(const ChessBoard& board, Placement& placement);
+  static uint64_t indexOf(const GameConfig& config, const std::vector<int>& squares,
+                          const std::vector<int>& cooldowns, bool is_white_turn);
+
+  static uint8_t encode(const TablebaseResult& result);
+  static bool decode(uint8_t value, TablebaseResult& result);
+
+  const std::string& getDirectory() const { return directory; }
+
+private:
+  struct MappedTable {
+    void* mapping = nullptr;
+    size_t mapping_size = 0;
+    const uint8_t* values = nullptr;
+    uint64_t entry_count = 0;
+  };
+
+  GameConfig config;
+  std::string directory;
+  mutable std::mutex tables_mutex;
+  mutable std::unordered_map<std::string, std::unique_ptr<MappedTable>> tables;
+
+  const MappedTable* table(const std::string& signature) const;
+};
+
+#endif
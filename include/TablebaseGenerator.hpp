@@ -0,0 +1,41 @@
+// TablebaseGenerator.hpp
+#ifndef TABLEBASE_GENERATOR_HPP
+#define TABLEBASE_GENERATOR_HPP
+#include "ConfigReader.hpp"
+#include "Tablebase.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+struct Ruleset;
+
+// Verilen malzeme için tüm pozisyonları (portal cooldown durumları dahil)
+// sayar ve geriye doğru çözer. Önce her pozisyonun yasal hamleleri bir kez
+// üretilip ardıl indeksleri saklanır; sonra turlar halinde "mata n yarım
+// hamle" değerleri ardıllardan geriye yayılır. İki aşama da tüm çekirdeklere
+// bölünür. Alt tablolar (alma veya terfi sonrası malzeme) önce üretilir.
+// Şahlar ve terfi eden taşlar isimden değil config'teki yeteneklerden bulunur;
+// oyunun aksine şah da saldırır (şahlar yan yana gelemez).
+class TablebaseGenerator {
+public:
+  TablebaseGenerator(const GameConfig& config, const std::string& directory,
+                     unsigned thread_count = 0);
+
+  // Tabloyu ve gereken alt tabloları üretip dizine yazar
+  bool generate(const Tablebase::Material& material);
+
+  // Üretim için izin verilen bellek (bayt); aşılırsa generate hata yazıp false döner
+  void setMemoryLimit(uint64_t bytes) { memory_limit = bytes; }
+
+private:
+  GameConfig config;
+  std::string directory;
+  std::shared_ptr<const Ruleset> ruleset;   // tip ve portal tabloları iş parçacıklarınca paylaşılır
+  unsigned thread_count;
+  uint64_t memory_limit = 4ULL << 30;
+
+  bool generateTable(const Tablebase::Material& material);
+  bool ensureSubTables(const Tablebase::Material& material);
+};
+
+#endif
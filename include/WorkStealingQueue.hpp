@@ -0,0 +1,43 @@
+// WorkStealingQueue.hpp
+#ifndef WORK_STEALING_QUEUE_HPP
+#define WORK_STEALING_QUEUE_HPP
+#include <deque>
+#include <mutex>
+
+// Thread başına görev kuyruğu. Sahibi arkadan ekler ve arkadan alır (en son
+// bölünen, en küçük iş önce: önbellekte sıcak); boştaki thread'ler önden çalar
+// (en eski, en büyük iş). Görevler büyük olduğundan kilit maliyeti önemsizdir.
+template <typename T>
+class WorkStealingQueue {
+public:
+  void push(T value) {
+    std::lock_guard<std::mutex> lock(mutex);
+    items.push_back(std::move(value));
+  }
+
+  bool pop(T& value) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (items.empty()) {
+      return false;
+    }
+    value = std::move(items.back());
+    items.pop_back();
+    return true;
+  }
+
+  bool steal(T& value) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (items.empty()) {
+      return false;
+    }
+    value = std::move(items.front());
+    items.pop_front();
+    return true;
+  }
+
+private:
+  std::mutex mutex;
+  std::deque<T> items;
+};
+
+#endif
@@ -0,0 +1,47 @@
+// Zobrist.hpp
+#ifndef ZOBRIST_HPP
+#define ZOBRIST_HPP
+#include <cstdint>
+#include <string>
+
+// Pozisyon hash'i için platformdan bağımsız anahtarlar. Açılış kitabı gibi
+// dosyalar bu anahtarları sakladığı için std::hash yerine sabit fonksiyonlar
+// kullanılır; anahtar tablosu gerekmez, taş tipi isimle karıştırılır.
+namespace zobrist {
+
+// splitmix64 sonlandırıcısı
+inline uint64_t mix(uint64_t x) {
+  x += 0x9E3779B97F4A7C15ULL;
+  x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+  return x ^ (x >> 31);
+}
+
+inline uint64_t fnv1a(const std::string& text) {
+  uint64_t hash = 0xCBF29CE484222325ULL;
+  for (unsigned char c : text) {
+    hash ^= c;
+    hash *= 0x100000001B3ULL;
+  }
+  return hash;
+}
+
+// Boş kare için 0 döner, böylece setSquare her iki tarafı da XOR'layabilir
+inline uint64_t pieceKey(const std::string& piece, bool is_white, int square) {
+  if (piece.empty()) {
+    return 0;
+  }
+  uint64_t slot = (static_cast<uint64_t>(square) << 1) | (is_white ? 1u : 0u);
+  return mix(fnv1a(piece) ^ (slot * 0xD6E8FEB86659FD93ULL));
+}
+
+constexpr uint64_t kBlackToMove = 0xF3B2A9C1D4E5F607ULL;
+
+// Tahta + sıra + portal cooldown durumu
+inline uint64_t positionKey(uint64_t board_hash, uint64_t portal_hash, bool is_white_turn) {
+  return board_hash ^ portal_hash ^ (is_white_turn ? 0 : kBlackToMove);
+}
+
+} // namespace zobrist
+
+#endif
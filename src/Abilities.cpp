@@ -0,0 +1,54 @@
+// Abilities.cpp
+#include "Abilities.hpp"
+#include <algorithm>
+#include <cctype>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+// Config izleyici thread'i de kayıt yapabildiği için kilitli
+struct Registry {
+  std::mutex mutex;
+  std::vector<std::string> names = {"castling", "royal",      "jump_over",
+                                    "promotion", "en_passant", "portal_master"};
+};
+
+Registry& registry() {
+  static Registry instance;
+  return instance;
+}
+
+} // namespace
+
+namespace abilities {
+
+int intern(const std::string& name) {
+  Registry& reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+  auto it = std::find(reg.names.begin(), reg.names.end(), name);
+  if (it != reg.names.end()) return static_cast<int>(it - reg.names.begin());
+  if (reg.names.size() >= static_cast<size_t>(kMaxAbilities)) return -1;
+  reg.names.push_back(name);
+  return static_cast<int>(reg.names.size()) - 1;
+}
+
+int find(const std::string& name) {
+  Registry& reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+  auto it = std::find(reg.names.begin(), reg.names.end(), name);
+  return it != reg.names.end() ? static_cast<int>(it - reg.names.begin()) : -1;
+}
+
+Mask defaultsFor(const std::string& piece) {
+  std::string lower = piece;
+  std::transform(lower.begin(), lower.end(), lower.begin(),
+                 [](unsigned char c) { return std::tolower(c); });
+  if (lower == "king") return bit(Royal) | bit(Castling);
+  if (lower == "rook") return bit(Castling);
+  if (lower == "knight") return bit(JumpOver);
+  if (lower == "pawn") return bit(Promotion) | bit(EnPassant);
+  return 0;
+}
+
+} // namespace abilities
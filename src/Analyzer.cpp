@@ -0,0 +1,173 @@
+// Analyzer.cpp
+#include "Analyzer.hpp"
+#include "MoveGenerator.hpp"
+#include "MoveValidator.hpp"
+#include "Zobrist.hpp"
+
+namespace {
+
+// Önbellek sınırı: aşılırsa baştan başlanır
+constexpr size_t kMaxCacheEntries = 1 << 16;
+
+// Arka plan thread'i hangi yoldan çıkarsa çıksın çalışıyor bayrağını indirir
+struct RunningGuard {
+  std::atomic<bool>& flag;
+  ~RunningGuard() { flag = false; }
+};
+
+} // namespace
+
+Analyzer::Analyzer(std::shared_ptr<const Evaluation> evaluation)
+    : evaluation(std::move(evaluation)) {}
+
+Analyzer::~Analyzer() { cancel(); }
+
+uint64_t Analyzer::keyOf(const ChessBoard& board, const PortalSystem& portal_system,
+                         bool is_white) {
+  return zobrist::positionKey(board.getHash(), portal_system.stateHash(), is_white);
+}
+
+void Analyzer::store(uint64_t key, const SearchResult& result) {
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  auto it = cache.find(key);
+  if (it != cache.end() && it->second.depth >= result.depth) {
+    return;
+  }
+  if (cache.size() >= kMaxCacheEntries) {
+    cache.clear();
+  }
+  cache[key] = result;
+}
+
+bool Analyzer::cached(uint64_t key, SearchResult& result) const {
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  auto it = cache.find(key);
+  if (it == cache.end()) {
+    return false;
+  }
+  result = it->second;
+  return true;
+}
+
+void Analyzer::setEvaluation(std::shared_ptr<const Evaluation> next) {
+  cancel();
+  evaluation = std::move(next);
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  cache.clear();
+}
+
+bool Analyzer::isSearching() const {
+  return running;
+}
+
+void Analyzer::join(bool report) {
+  if (!worker.joinable()) {
+    return;
+  }
+  report_enabled = report;
+  worker.request_stop();
+  worker.join();
+  worker = std::jthread();
+  report_enabled = true;
+}
+
+void Analyzer::stop() { join(true); }
+
+void Analyzer::cancel() { join(false); }
+
+void Analyzer::wait() {
+  if (worker.joinable()) {
+    worker.join();
+    worker = std::jthread();
+  }
+}
+
+void Analyzer::ponder(const ChessBoard& board, const PortalSystem& portal_system,
+                      bool is_white) {
+  cancel();
+  // Kopyalar ana thread'de alınır; arka plan sadece kendi kopyasına dokunur
+  ChessBoard root = board;
+  root.setVerbose(false);
+  PortalSystem portals = portal_system;
+  portals.setVerbose(false);
+
+  running = true;
+  worker = std::jthread([this, root, portals, is_white](std::stop_token stop) mutable {
+    RunningGuard guard{running};
+    MoveValidator validator;
+    validator.setVerbose(false);
+    Search search(*evaluation, validator);
+
+    // 1) Beklenen hamle: sıradaki tarafın kısa aramadaki en iyi hamlesi
+    SearchLimits limits;
+    limits.stop = stop;
+    limits.max_depth = kExpectedMoveDepth;
+    uint64_t root_key = keyOf(root, portals, is_white);
+    SearchResult previous;
+    if (cached(root_key, previous)) {
+      limits.hint = previous.best_move;
+    }
+    SearchResult expected = search.iterate(root, portals, is_white, limits,
+                                           [&](const SearchResult& r) { store(root_key, r); });
+    if (stop.stop_requested() || !expected.has_move) {
+      return;
+    }
+
+    // 2) Beklenen hamleden sonraki pozisyonu durdurulana kadar derinleştir
+    ChessBoard next = root;
+    MoveGenerator generator(validator);
+    generator.makeMove(next, portals, expected.best_move);
+    uint64_t next_key = keyOf(next, portals, !is_white);
+    SearchLimits deep;
+    deep.stop = stop;
+    if (cached(next_key, previous)) {
+      deep.start_depth = previous.depth + 1;
+      deep.hint = previous.best_move;
+    }
+    search.iterate(next, portals, !is_white, deep,
+                   [&](const SearchResult& r) { store(next_key, r); });
+  });
+}
+
+void Analyzer::go(const ChessBoard& board, const PortalSystem& portal_system, bool is_white,
+                  std::chrono::milliseconds movetime, Report report, int max_depth) {
+  cancel();
+  ChessBoard root = board;
+  root.setVerbose(false);
+  PortalSystem portals = portal_system;
+  portals.setVerbose(false);
+  running = true;
+  Clock::time_point deadline =
+      movetime.count() > 0 ? Clock::now() + movetime : Clock::time_point::max();
+
+  worker = std::jthread([this, root, portals, is_white, deadline, max_depth,
+                         report = std::move(report)](std::stop_token stop) mutable {
+    RunningGuard guard{running};
+    MoveValidator validator;
+    validator.setVerbose(false);
+    Search search(*evaluation, validator);
+
+    // Ponder sonucu varsa kaldığı derinlikten devam edilir
+    uint64_t key = keyOf(root, portals, is_white);
+    SearchResult previous;
+    bool has_previous = cached(key, previous) && previous.has_move;
+    SearchLimits limits;
+    limits.stop = stop;
+    limits.deadline = deadline;
+    limits.max_depth = max_depth;
+    if (has_previous) {
+      limits.start_depth = previous.depth + 1;
+      limits.hint = previous.best_move;
+    }
+    SearchResult result = search.iterate(root, portals, is_white, limits,
+                                         [&](const SearchResult& r) { store(key, r); });
+    bool from_cache = false;
+    if (!result.has_move && has_previous) {
+      result = previous;
+      from_cache = true;
+    }
+    if (report_enabled && report) {
+      report(result, from_cache);
+    }
+  });
+}
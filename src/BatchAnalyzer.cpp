@@ -0,0 +1,182 @@
+// BatchAnalyzer.cpp
+#include "BatchAnalyzer.hpp"
+#include "BoundedQueue.hpp"
+#include "MoveGenerator.hpp"
+#include "MoveNotation.hpp"
+#include "MoveValidator.hpp"
+#include "Search.hpp"
+#include <atomic>
+#include <istream>
+#include <map>
+#include <nlohmann/json.hpp>
+#include <ostream>
+#include <semaphore>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Süre/derinlik verilmediğinde kullanılan sabit derinlik
+constexpr int kDefaultDepth = 3;
+
+// Bekleme süresini nanosaniye olarak toplayan sayaç (thread'ler arası)
+struct WaitTimer {
+  std::atomic<int64_t> nanoseconds{0};
+
+  template <typename F>
+  auto measure(F&& wait) {
+    auto start = Clock::now();
+    auto result = wait();
+    nanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start)
+                       .count();
+    return result;
+  }
+  double milliseconds() const { return static_cast<double>(nanoseconds) / 1e6; }
+};
+
+} // namespace
+
+BatchAnalyzer::BatchAnalyzer(const GameConfig& config,
+                             std::shared_ptr<const Evaluation> evaluation,
+                             std::shared_ptr<const NnueNetwork> network)
+    : evaluation(evaluation), parser(config, evaluation, std::move(network)) {}
+
+BatchAnalyzer::Stats BatchAnalyzer::run(std::istream& input, std::ostream& output,
+                                        const Options& options) {
+  struct Job {
+    size_t sequence = 0;      // sıralı yazım için, atlanan satırlar sayılmaz
+    size_t line_number = 0;
+    std::string error;        // setup boşsa ayrıştırma hatası
+    std::unique_ptr<PositionParser::Setup> setup;
+  };
+  struct Output {
+    size_t sequence = 0;
+    std::string line;
+  };
+
+  Stats stats;
+  stats.threads = options.threads > 0 ? options.threads
+                                      : std::max(1u, std::thread::hardware_concurrency());
+  int depth = options.depth > 0 ? options.depth
+              : options.movetime.count() > 0 ? MoveOrdering::kMaxPly - 1
+                                             : kDefaultDepth;
+
+  BoundedQueue<Job> jobs(options.queue_capacity);
+  BoundedQueue<Output> results(options.queue_capacity);
+  // Sıralı yazım için bekleyen sonuçlar da sınırlı: okuma en fazla bu kadar önde olabilir
+  std::counting_semaphore<> in_flight(
+      static_cast<std::ptrdiff_t>(options.queue_capacity * 2 + stats.threads));
+  WaitTimer reader_blocked, workers_idle, workers_blocked, writer_idle;
+  std::atomic<size_t> errors{0};
+  auto start = Clock::now();
+
+  // 1) Okuma ve ayrıştırma
+  std::jthread reader([&] {
+    std::string line;
+    size_t line_number = 0, sequence = 0;
+    while (std::getline(input, line)) {
+      ++line_number;
+      size_t first = line.find_first_not_of(" \t\r");
+      if (first == std::string::npos || line[first] == '#') continue;
+      Job job;
+      job.sequence = sequence++;
+      job.line_number = line_number;
+      auto setup = std::make_unique<PositionParser::Setup>();
+      if (parser.parse(line, *setup, job.error)) {
+        job.setup = std::move(setup);
+      }
+      reader_blocked.measure([&] {
+        in_flight.acquire();
+        return true;
+      });
+      if (!reader_blocked.measure([&] { return jobs.push(std::move(job)); })) break;
+    }
+    jobs.close();
+  });
+
+  // 2) Analiz: her thread kendi doğrulayıcı ve aramasıyla
+  std::atomic<unsigned> active_workers{stats.threads};
+  std::vector<std::jthread> workers;
+  for (unsigned t = 0; t < stats.threads; ++t) {
+    workers.emplace_back([&] {
+      MoveValidator validator;
+      validator.setVerbose(false);
+      MoveGenerator generator(validator);
+      Search search(*evaluation, validator);
+      Job job;
+      while (workers_idle.measure([&] { return jobs.pop(job); })) {
+        nlohmann::ordered_json result;
+        result["line"] = job.line_number;
+        if (!job.setup) {
+          result["error"] = job.error;
+          ++errors;
+        } else {
+          PositionParser::Setup& setup = *job.setup;
+          ChessBoard& board = *setup.board;
+          PortalSystem& portals = *setup.portals;
+          auto position_start = Clock::now();
+
+          bool in_check = generator.inCheck(board, portals, setup.is_white);
+          size_t legal = generator.legalMoves(board, portals, setup.is_white).size();
+          result["side"] = setup.is_white ? "white" : "black";
+          result["in_check"] = in_check;
+          result["status"] = legal > 0 ? "ongoing" : in_check ? "checkmate" : "stalemate";
+          result["legal_moves"] = legal;
+
+          if (legal > 0) {
+            // Önceki pozisyonun killer/history tabloları sonucu thread'e bağımlı yapmasın
+            search.getOrdering().clear();
+            SearchLimits limits;
+            limits.max_depth = depth;
+            if (options.movetime.count() > 0) {
+              limits.deadline = position_start + options.movetime;
+            }
+            SearchResult best = search.iterate(board, portals, setup.is_white, limits);
+            if (best.has_move) {
+              result["best_move"] = formatCoordinateMove(best.best_move);
+              result["score"] = best.score;
+            }
+            result["depth"] = best.depth;
+            result["nodes"] = best.nodes;
+          }
+          result["time_ms"] =
+              std::chrono::duration<double, std::milli>(Clock::now() - position_start).count();
+        }
+        Output out{job.sequence, result.dump()};
+        if (!workers_blocked.measure([&] { return results.push(std::move(out)); })) break;
+      }
+      if (--active_workers == 0) {
+        results.close();
+      }
+    });
+  }
+
+  // 3) Yazma: sonuçlar girdi sırasına göre dizilir
+  std::map<size_t, std::string> pending;
+  size_t next = 0;
+  Output out;
+  while (writer_idle.measure([&] { return results.pop(out); })) {
+    pending.emplace(out.sequence, std::move(out.line));
+    for (auto it = pending.begin(); it != pending.end() && it->first == next;
+         it = pending.erase(it)) {
+      output << it->second << '\n';
+      ++next;
+      in_flight.release();
+    }
+  }
+  output.flush();
+
+  reader.join();
+  for (auto& worker : workers) worker.join();
+
+  stats.positions = next;
+  stats.errors = errors;
+  stats.elapsed_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+  stats.reader_blocked_ms = reader_blocked.milliseconds();
+  stats.workers_idle_ms = workers_idle.milliseconds();
+  stats.workers_blocked_ms = workers_blocked.milliseconds();
+  stats.writer_idle_ms = writer_idle.milliseconds();
+  return stats;
+}
@@ -0,0 +1,232 @@
+// BoardKernels.cpp
+#include "BoardKernels.hpp"
+#include <array>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace {
+
+// Yön sırası getMoveEdges'deki sırayla aynı: önce dik, sonra çapraz
+constexpr int kDirX[8] = {0, 0, 1, -1, 1, 1, -1, -1};
+constexpr int kDirY[8] = {1, -1, 0, 0, 1, -1, 1, -1};
+constexpr int kKnightX[8] = {2, 2, -2, -2, 1, 1, -1, -1};
+constexpr int kKnightY[8] = {1, -1, 1, -1, 2, -2, 2, -2};
+// Fil yönleri {1,1},{1,-1},{-1,1},{-1,-1}; kale {0,1},{0,-1},{1,0},{-1,0}
+constexpr int kBishopDirs[4] = {4, 5, 6, 7};
+constexpr int kRookDirs[4] = {0, 1, 2, 3};
+constexpr int kQueenDirs[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+
+constexpr bool inBounds(int x, int y, int size) {
+  return x >= 0 && x < size && y >= 0 && y < size;
+}
+
+constexpr uint8_t rayLength(int square, int dir, int size) {
+  int x = square % size, y = square / size;
+  uint8_t length = 0;
+  while (inBounds(x + kDirX[dir] * (length + 1), y + kDirY[dir] * (length + 1), size)) {
+    ++length;
+  }
+  return length;
+}
+
+constexpr MoveKernels::JumpList jumpList(int square, const int* dx, const int* dy, int size) {
+  MoveKernels::JumpList list;
+  int x = square % size, y = square / size;
+  for (int i = 0; i < 8; ++i) {
+    if (inBounds(x + dx[i], y + dy[i], size)) {
+      list.squares[list.count++] = static_cast<uint16_t>((y + dy[i]) * size + x + dx[i]);
+    }
+  }
+  return list;
+}
+
+// Derleme zamanı tabloları: N sabit olduğu için bölme/sınır kontrolleri sabitlenir
+template <int N>
+struct FixedGeometry {
+  static constexpr int kSquares = N * N;
+  static constexpr auto rays = [] {
+    std::array<std::array<uint8_t, 8>, kSquares> table{};
+    for (int square = 0; square < kSquares; ++square) {
+      for (int dir = 0; dir < 8; ++dir) table[square][dir] = rayLength(square, dir, N);
+    }
+    return table;
+  }();
+  static constexpr auto knights = [] {
+    std::array<MoveKernels::JumpList, kSquares> table{};
+    for (int square = 0; square < kSquares; ++square) {
+      table[square] = jumpList(square, kKnightX, kKnightY, N);
+    }
+    return table;
+  }();
+  static constexpr auto kings = [] {
+    std::array<MoveKernels::JumpList, kSquares> table{};
+    for (int square = 0; square < kSquares; ++square) {
+      table[square] = jumpList(square, kDirX, kDirY, N);
+    }
+    return table;
+  }();
+
+  explicit FixedGeometry(const MoveKernels&) {}
+  static constexpr int size() { return N; }
+  static constexpr bool inside(int x, int y) {
+    return static_cast<unsigned>(x) < static_cast<unsigned>(N) &&
+           static_cast<unsigned>(y) < static_cast<unsigned>(N);
+  }
+  static constexpr int ray(int square, int dir) { return rays[square][dir]; }
+  static constexpr const MoveKernels::JumpList& knight(int square) { return knights[square]; }
+  static constexpr const MoveKernels::JumpList& king(int square) { return kings[square]; }
+};
+
+// Aynı arayüz, tablolar çalışma zamanında üretilmiş. Tablo işaretçileri ve boyut
+// yerel kopyalanır; edges'e yazılan push_back'ler bunları yeniden okutmaz.
+struct DynamicGeometry {
+  const uint8_t* rays;
+  const MoveKernels::JumpList* knights;
+  const MoveKernels::JumpList* kings;
+  int n;
+  explicit DynamicGeometry(const MoveKernels& k)
+      : rays(k.ray_lengths.data()), knights(k.knight_jumps.data()), kings(k.king_steps.data()),
+        n(k.getBoardSize()) {}
+  int size() const { return n; }
+  bool inside(int x, int y) const {
+    return static_cast<unsigned>(x) < static_cast<unsigned>(n) &&
+           static_cast<unsigned>(y) < static_cast<unsigned>(n);
+  }
+  int ray(int square, int dir) const { return rays[square * 8 + dir]; }
+  const MoveKernels::JumpList& knight(int square) const { return knights[square]; }
+  const MoveKernels::JumpList& king(int square) const { return kings[square]; }
+};
+
+template <class Geometry, size_t Count>
+void slide(const Geometry& g, const int (&dirs)[Count], int square, const Position& pos,
+           const ChessBoard::Square* squares, std::vector<Position>& edges) {
+  const int size = g.size();
+  for (int dir : dirs) {
+    int length = g.ray(square, dir);
+    int step = kDirY[dir] * size + kDirX[dir];
+    int target = square;
+    for (int i = 1; i <= length; ++i) {
+      target += step;
+      // Engel karesi de eklenir (renk kontrolü isValidMove'da)
+      edges.push_back({pos.x + i * kDirX[dir], pos.y + i * kDirY[dir]});
+      if (!squares[target].is_empty()) break;
+    }
+  }
+}
+
+template <class Geometry>
+void jump(const Geometry& g, const MoveKernels::JumpList& list, bool is_white,
+          const ChessBoard::Square* squares, std::vector<Position>& edges) {
+  const int size = g.size();
+  for (int i = 0; i < list.count; ++i) {
+    int square = list.squares[i];
+    const auto& target = squares[square];
+    if (target.is_empty() || target.is_white != is_white) {
+      edges.push_back({square % size, square / size});
+    }
+  }
+}
+
+template <class Geometry>
+void edgeKernel(const MoveKernels& kernels, PieceKind kind, const Position& pos, bool is_white,
+                const ChessBoard::Square* squares, std::vector<Position>& edges) {
+  const Geometry g(kernels);
+  int square = pos.y * g.size() + pos.x;
+  switch (kind) {
+  case PieceKind::Pawn: {
+    int forward = is_white ? 1 : -1;
+    if (g.inside(pos.x, pos.y + forward) && squares[square + forward * g.size()].is_empty()) {
+      edges.push_back({pos.x, pos.y + forward});
+      // İlk harekette 2 kare ileri (getMoveEdges ile aynı sabit satırlar)
+      if (((is_white && pos.y == 1) || (!is_white && pos.y == 6)) &&
+          g.inside(pos.x, pos.y + 2 * forward) &&
+          squares[square + 2 * forward * g.size()].is_empty()) {
+        edges.push_back({pos.x, pos.y + 2 * forward});
+      }
+    }
+    for (int dx : {-1, 1}) {
+      if (g.inside(pos.x + dx, pos.y + forward)) {
+        const auto& target = squares[square + forward * g.size() + dx];
+        if (!target.is_empty() && target.is_white != is_white) {
+          edges.push_back({pos.x + dx, pos.y + forward});
+        }
+      }
+    }
+    break;
+  }
+  case PieceKind::Knight:
+    jump(g, g.knight(square), is_white, squares, edges);
+    break;
+  case PieceKind::Bishop:
+    slide(g, kBishopDirs, square, pos, squares, edges);
+    break;
+  case PieceKind::Rook:
+    slide(g, kRookDirs, square, pos, squares, edges);
+    break;
+  case PieceKind::Queen:
+    slide(g, kQueenDirs, square, pos, squares, edges);
+    break;
+  case PieceKind::King:
+    jump(g, g.king(square), is_white, squares, edges);
+    break;
+  case PieceKind::Other:
+    break;
+  }
+}
+
+} // namespace
+
+PieceKind pieceKindOf(const std::string& piece_lower) {
+  if (piece_lower == "pawn") return PieceKind::Pawn;
+  if (piece_lower == "knight") return PieceKind::Knight;
+  if (piece_lower == "bishop") return PieceKind::Bishop;
+  if (piece_lower == "rook") return PieceKind::Rook;
+  if (piece_lower == "queen") return PieceKind::Queen;
+  if (piece_lower == "king") return PieceKind::King;
+  return PieceKind::Other;
+}
+
+MoveKernels::MoveKernels(int size, bool is_specialized, EdgeFunction function)
+    : board_size(size), specialized(is_specialized), edge_function(function) {
+  if (specialized) {
+    return;
+  }
+  int square_count = size * size;
+  ray_lengths.resize(static_cast<size_t>(square_count) * 8);
+  knight_jumps.resize(square_count);
+  king_steps.resize(square_count);
+  for (int square = 0; square < square_count; ++square) {
+    for (int dir = 0; dir < 8; ++dir) {
+      ray_lengths[square * 8 + dir] = rayLength(square, dir, size);
+    }
+    knight_jumps[square] = jumpList(square, kKnightX, kKnightY, size);
+    king_steps[square] = jumpList(square, kDirX, kDirY, size);
+  }
+}
+
+const MoveKernels& MoveKernels::generic(int board_size) {
+  // Boyut başına bir kez üretilir; tahtalar işaretçiyi saklar
+  static std::mutex mutex;
+  static std::map<int, std::unique_ptr<MoveKernels>> cache;
+  std::lock_guard<std::mutex> lock(mutex);
+  auto& entry = cache[board_size];
+  if (!entry) {
+    entry.reset(new MoveKernels(board_size, false, &edgeKernel<DynamicGeometry>));
+  }
+  return *entry;
+}
+
+const MoveKernels& MoveKernels::forSize(int board_size) {
+  static const MoveKernels k8(8, true, &edgeKernel<FixedGeometry<8>>);
+  static const MoveKernels k10(10, true, &edgeKernel<FixedGeometry<10>>);
+  static const MoveKernels k12(12, true, &edgeKernel<FixedGeometry<12>>);
+  static const MoveKernels k16(16, true, &edgeKernel<FixedGeometry<16>>);
+  switch (board_size) {
+  case 8: return k8;
+  case 10: return k10;
+  case 12: return k12;
+  case 16: return k16;
+  default: return generic(board_size);
+  }
+}
@@ -0,0 +1,233 @@
+// BoardRenderer.cpp
+#include "BoardRenderer.hpp"
+#include "ChessBoard.hpp"
+#include <algorithm>
+#include <cctype>
+#include <iostream>
+
+namespace {
+
+// Standart taşların harfleri (At için 'A' kullanılıyor)
+const std::vector<std::pair<std::string, char>> kStandardSymbols = {
+    {"king", 'K'}, {"queen", 'Q'}, {"rook", 'R'},
+    {"bishop", 'B'}, {"knight", 'A'}, {"pawn", 'P'}};
+
+std::string lowerCopy(const std::string& str) {
+  std::string lower = str;
+  std::transform(lower.begin(), lower.end(), lower.begin(),
+                 [](unsigned char c) { return std::tolower(c); });
+  return lower;
+}
+
+int digitCount(int value) {
+  int digits = 1;
+  while (value >= 10) {
+    value /= 10;
+    ++digits;
+  }
+  return digits;
+}
+
+} // namespace
+
+BoardRenderer::BoardRenderer(Mode mode) : mode(mode) {}
+
+BoardRenderer::Mode BoardRenderer::modeFromString(const std::string& name) {
+  std::string lower = lowerCopy(name);
+  if (lower == "simple") return Mode::Simple;
+  if (lower == "ansi") return Mode::Ansi;
+  if (lower == "none" || lower == "headless") return Mode::None;
+  return Mode::Detailed;
+}
+
+void BoardRenderer::registerPieceTypes(const GameConfig& config) {
+  for (const auto& piece : config.pieces) {
+    typeIndexOf(piece.type);
+  }
+  for (const auto& piece : config.custom_pieces) {
+    typeIndexOf(piece.type);
+  }
+}
+
+const std::string& BoardRenderer::symbolFor(const std::string& piece) {
+  return symbols[typeIndexOf(piece)];
+}
+
+int BoardRenderer::typeIndexOf(const std::string& piece) {
+  auto it = type_index.find(piece);
+  if (it != type_index.end()) {
+    return it->second;
+  }
+
+  std::string lower = lowerCopy(piece);
+  char letter = 0;
+  for (const auto& standard : kStandardSymbols) {
+    if (standard.first == lower) {
+      letter = standard.second;
+      break;
+    }
+  }
+
+  // Özel taş: isminin harflerinden henüz kullanılmamış ilkini seç
+  auto taken = [this](char c) {
+    for (const auto& symbol : symbols) {
+      if (symbol[0] == c) return true;
+    }
+    for (const auto& standard : kStandardSymbols) {
+      if (standard.second == c) return true;
+    }
+    return false;
+  };
+  if (letter == 0) {
+    for (char c : piece) {
+      char upper = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+      if (upper >= 'A' && upper <= 'Z' && !taken(upper)) {
+        letter = upper;
+        break;
+      }
+    }
+  }
+  for (char c = 'A'; letter == 0 && c <= 'Z'; ++c) {
+    if (!taken(c)) letter = c;
+  }
+  if (letter == 0) letter = '?';
+
+  int index = static_cast<int>(symbols.size());
+  symbols.push_back(std::string(1, letter));
+  type_index[piece] = index;
+  return index;
+}
+
+int BoardRenderer::cellCode(const ChessBoard& board, int x, int y) {
+  const auto& square = board.getSquare({x, y});
+  if (square.is_empty()) {
+    return 0;
+  }
+  return (typeIndexOf(square.piece) + 1) * 2 + (square.is_white ? 1 : 0);
+}
+
+void BoardRenderer::appendCell(int code) {
+  if (code == 0) {
+    frame += " . ";
+    return;
+  }
+  bool is_white = (code & 1) != 0;
+  frame += is_white ? 'W' : 'B';
+  frame += symbols[code / 2 - 1][0];
+  frame += ' ';
+}
+
+void BoardRenderer::appendColumnLabels(int size, int label_width) {
+  frame.append(static_cast<size_t>(label_width) + 2, ' ');
+  for (int x = 0; x < size; ++x) {
+    frame += static_cast<char>('a' + x);
+    frame += "  ";
+  }
+  frame += '\n';
+}
+
+void BoardRenderer::buildDetailed(const ChessBoard& board) {
+  int size = board.getBoardSize();
+  int label_width = std::max(1, digitCount(size));
+  // Sütun (a,h) satır (1,8)
+  appendColumnLabels(size, label_width);
+  for (int y = size - 1; y >= 0; --y) {
+    std::string label = std::to_string(y + 1);
+    frame += label;
+    frame.append(static_cast<size_t>(label_width) - label.size() + 2, ' ');
+    for (int x = 0; x < size; ++x) {
+      appendCell(cellCode(board, x, y));
+    }
+    frame += label;
+    frame += '\n';
+  }
+  appendColumnLabels(size, label_width);
+}
+
+void BoardRenderer::buildSimple(const ChessBoard& board) {
+  int size = board.getBoardSize();
+  for (int y = 0; y < size; ++y) {
+    for (int x = 0; x < size; ++x) {
+      int code = cellCode(board, x, y);
+      if (code == 0) {
+        frame += ". ";
+        continue;
+      }
+      char symbol = symbols[code / 2 - 1][0];
+      frame += (code & 1) ? symbol : static_cast<char>(std::tolower(symbol));
+      frame += ' ';
+    }
+    frame += '\n';
+  }
+}
+
+void BoardRenderer::buildAnsi(const ChessBoard& board) {
+  int size = board.getBoardSize();
+  int label_width = std::max(1, digitCount(size));
+  size_t cell_count = static_cast<size_t>(size) * size;
+
+  if (previous_size != size || previous_cells.size() != cell_count) {
+    // İlk kare: ekranı temizle ve tam çiz
+    frame += "\x1b[H\x1b[2J";
+    buildDetailed(board);
+    previous_cells.assign(cell_count, 0);
+    for (int y = 0; y < size; ++y) {
+      for (int x = 0; x < size; ++x) {
+        previous_cells[static_cast<size_t>(y) * size + x] = cellCode(board, x, y);
+      }
+    }
+    previous_size = size;
+    return;
+  }
+
+  // Sadece değişen kareler: her biri için imleci konumla ve hücreyi yaz
+  for (int y = 0; y < size; ++y) {
+    for (int x = 0; x < size; ++x) {
+      int code = cellCode(board, x, y);
+      int& previous = previous_cells[static_cast<size_t>(y) * size + x];
+      if (code == previous) continue;
+      previous = code;
+      int row = 2 + (size - 1 - y);
+      int column = label_width + 3 + 3 * x;
+      frame += "\x1b[";
+      frame += std::to_string(row);
+      frame += ';';
+      frame += std::to_string(column);
+      frame += 'H';
+      appendCell(code);
+    }
+  }
+  // İmleci tahtanın altına taşı ve eski mesajları temizle
+  frame += "\x1b[";
+  frame += std::to_string(size + 3);
+  frame += ";1H\x1b[J";
+}
+
+void BoardRenderer::invalidate() {
+  previous_cells.clear();
+  previous_size = 0;
+}
+
+void BoardRenderer::flush() {
+  if (frame.empty()) return;
+  std::cout.write(frame.data(), static_cast<std::streamsize>(frame.size()));
+  std::cout.flush();
+}
+
+void BoardRenderer::render(const ChessBoard& board) {
+  frame.clear();
+  switch (mode) {
+  case Mode::None:
+    return;
+  case Mode::Simple:
+    buildSimple(board);
+    break;
+  case Mode::Ansi:
+    buildAnsi(board);
+    break;
+  case Mode::Detailed:
+    buildDetailed(board);
+    break;
+  }
+  flush();
+}
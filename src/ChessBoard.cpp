@@ -3,48 +3,236 @@
 #include "MoveValidator.hpp"
 #include "PortalSystem.hpp"
 #include "GameManager.hpp"
+#include "BoardKernels.hpp"
+#include "BoardRenderer.hpp"
+#include "Evaluation.hpp"
+#include "Zobrist.hpp"
+#include <algorithm>
 #include <iostream>
 #include <stdexcept>
 #include <cctype>
 
 ChessBoard::ChessBoard(int size, const std::string& display_format) 
-    : board_size(size), board_display_format(display_format) {}
+    : squares(static_cast<size_t>(size > 0 ? size * size : 0)), board_size(size),
+      kernels(&MoveKernels::forSize(size)), board_display_format(display_format),
+      list_index(squares.size(), -1), types(std::make_shared<const TypeTable>()) {}
+
+ChessBoard::ChessBoard(int size, std::shared_ptr<const TypeTable> types,
+                       const std::string& display_format)
+    : ChessBoard(size, display_format) {
+  if (types) this->types = std::move(types);
+}
 
 int ChessBoard::getBoardSize() const {
   return board_size;
 }
 
-std::string ChessBoard::posToString(const Position& pos) const {
-  return std::to_string(pos.x) + "," + std::to_string(pos.y);
+const char* moveErrorText(MoveError error) {
+  switch (error) {
+    case MoveError::OutOfBounds: return "Geçersiz pozisyon.";
+    case MoveError::EmptySquare: return "Başlangıç pozisyonunda taş yok.";
+    case MoveError::WrongPiece: return "Karedeki taş uyuşmuyor.";
+    case MoveError::IllegalMove: return "Geçersiz hareket.";
+  }
+  return "Geçersiz hareket.";
 }
 
-bool ChessBoard::isInBounds(const Position& pos) const {
-  return pos.x >= 0 && pos.x < board_size && pos.y >= 0 && pos.y < board_size;
+void ChessBoard::throwOutOfRange() {
+  throw std::out_of_range("Tahta sınırlarının dışı.");
 }
 
-const ChessBoard::Square& ChessBoard::getSquare(const Position& pos) const {
-  if (!isInBounds(pos)) {
-    throw std::out_of_range("Tahta sınırlarının dışı.");
+// Tahtaya yazan tek nokta: değerlendirme skoru ve hash burada farkla güncellenir
+void ChessBoard::setSquare(const Position& pos, const Square& square) {
+  Square& current = squares[indexOf(pos)];
+  int index = static_cast<int>(indexOf(pos));
+  board_hash ^= zobrist::pieceKey(current.piece, current.is_white, index);
+  board_hash ^= zobrist::pieceKey(square.piece, square.is_white, index);
+  if (evaluation) {
+    evaluation_score -= evaluation->squareScore(current.piece, current.is_white, pos);
+    evaluation_score += evaluation->squareScore(square.piece, square.is_white, pos);
   }
-  static const Square empty_square;
-  auto it = board.find(posToString(pos));
-  return it != board.end() ? it->second : empty_square;
+  if (network) {
+    network->update(accumulator, network->feature(current.piece, current.is_white, index),
+                    network->feature(square.piece, square.is_white, index));
+    network_dirty = true;
+  }
+  removeFromList(current, index);
+  addToList(square, index);
+  ray_cache.invalidate();
+  current = square;
+}
+
+namespace {
+
+std::string lowerCopy(const std::string& str) {
+  std::string lower = str;
+  std::transform(lower.begin(), lower.end(), lower.begin(),
+                 [](unsigned char c) { return std::tolower(c); });
+  return lower;
+}
+
+} // namespace
+
+int ChessBoard::TypeTable::add(const std::string& piece, abilities::Mask mask) {
+  int type_id = find(piece);
+  if (type_id >= 0) return type_id;
+  names.push_back(piece);
+  keys.push_back(lowerCopy(piece));
+  abilities.push_back(mask);
+  kinds.push_back(pieceKindOf(keys.back()));
+  return static_cast<int>(names.size()) - 1;
+}
+
+int ChessBoard::TypeTable::find(const std::string& piece) const {
+  auto it = std::find(names.begin(), names.end(), piece);
+  return it != names.end() ? static_cast<int>(it - names.begin()) : -1;
+}
+
+int ChessBoard::findTypeId(const std::string& piece) const {
+  std::string key = lowerCopy(piece);
+  for (size_t i = 0; i < types->keys.size(); ++i) {
+    if (types->keys[i] == key) return static_cast<int>(i);
+  }
+  return -1;
+}
+
+int ChessBoard::internType(const std::string& piece) {
+  int known = types->find(piece);
+  if (known >= 0) return known;
+  // Paylaşılan tablo değişmez; eski ID'ler kopyada aynı kalır
+  auto own = std::make_shared<TypeTable>(*types);
+  int type_id = own->add(piece);
+  types = std::move(own);
+  return type_id;
+}
+
+// Aynı tip config'te iki kez geçerse ilki geçerli (Evaluation ile aynı kural)
+void ChessBoard::registerTypes(const std::vector<PieceConfig>& piece_configs) {
+  std::shared_ptr<TypeTable> own;
+  for (size_t i = 0; i < piece_configs.size(); ++i) {
+    const PieceConfig& config = piece_configs[i];
+    bool repeated = std::any_of(piece_configs.begin(), piece_configs.begin() + i,
+                                [&](const PieceConfig& earlier) { return earlier.type == config.type; });
+    const TypeTable& table = own ? *own : *types;
+    int type_id = table.find(config.type);
+    if (repeated || (type_id >= 0 && table.abilities[type_id] == config.special_abilities.mask)) {
+      continue;
+    }
+    if (!own) own = std::make_shared<TypeTable>(*types);
+    if (type_id < 0) {
+      own->add(config.type, config.special_abilities.mask);
+    } else {
+      own->abilities[type_id] = config.special_abilities.mask;
+    }
+  }
+  if (own) types = std::move(own);
+}
+
+void ChessBoard::addToList(const Square& square, int index) {
+  if (square.is_empty()) return;
+  PieceList& list = piece_lists[square.is_white ? 1 : 0];
+  list_index[index] = static_cast<int>(list.size());
+  list.types.push_back(internType(square.piece));
+  list.squares.push_back(index);
+}
+
+// Sondaki taşı boşalan yere taşır; onun geri işaretçisi güncellenir
+void ChessBoard::removeFromList(const Square& square, int index) {
+  if (square.is_empty()) return;
+  PieceList& list = piece_lists[square.is_white ? 1 : 0];
+  int slot = list_index[index];
+  int last = static_cast<int>(list.size()) - 1;
+  if (slot != last) {
+    list.types[slot] = list.types[last];
+    list.squares[slot] = list.squares[last];
+    list_index[list.squares[slot]] = slot;
+  }
+  list.types.pop_back();
+  list.squares.pop_back();
+  list_index[index] = -1;
+}
+
+bool ChessBoard::findPiece(const std::string& piece, bool is_white, Position& pos) const {
+  int type_id = findTypeId(piece);
+  if (type_id < 0) return false;
+  const PieceList& list = getPieces(is_white);
+  for (size_t i = 0; i < list.size(); ++i) {
+    if (types->keys[list.types[i]] == types->keys[type_id]) {
+      pos = positionOf(list.squares[i]);
+      return true;
+    }
+  }
+  return false;
+}
+
+bool ChessBoard::findRoyal(bool is_white, Position& pos) const {
+  const PieceList& list = getPieces(is_white);
+  for (size_t i = 0; i < list.size(); ++i) {
+    if (abilities::has(types->abilities[list.types[i]], abilities::Royal)) {
+      pos = positionOf(list.squares[i]);
+      return true;
+    }
+  }
+  return false;
+}
+
+abilities::Mask ChessBoard::abilitiesAt(const Position& pos) const {
+  if (!isInBounds(pos)) return 0;
+  size_t index = indexOf(pos);
+  int slot = list_index[index];
+  if (slot < 0) return 0;
+  return types->abilities[getPieces(squares[index].is_white).types[slot]];
+}
+
+PieceKind ChessBoard::kindAt(const Position& pos) const {
+  if (!isInBounds(pos)) return PieceKind::Other;
+  size_t index = indexOf(pos);
+  int slot = list_index[index];
+  if (slot < 0) return PieceKind::Other;
+  return types->kinds[getPieces(squares[index].is_white).types[slot]];
+}
+
+void ChessBoard::attachEvaluation(std::shared_ptr<const Evaluation> eval) {
+  evaluation = std::move(eval);
+  evaluation_score = evaluation ? evaluation->fullScore(*this) : 0;
+}
+
+void ChessBoard::attachNetwork(std::shared_ptr<const NnueNetwork> net) {
+  network = std::move(net);
+  accumulator = NnueNetwork::Accumulator();
+  if (network) network->refresh(*this, accumulator);
+  network_dirty = true;
+}
+
+int ChessBoard::getEvaluation() const {
+  if (network) {
+    if (network_dirty) {
+      network_score = network->evaluate(accumulator);
+      network_dirty = false;
+    }
+    return network_score;
+  }
+  return evaluation_score;
 }
 
 void ChessBoard::placePiece(const std::string& piece, bool is_white, int x, int y) {
   if (!isInBounds({x, y})) {
     throw std::invalid_argument("Geçersiz pozisyon.");
   }
-  std::string pos_str = posToString({x, y});
   if (piece.empty()) {
-    board.erase(pos_str);
+    setSquare({x, y}, Square());
   } else {
-    board[pos_str] = Square(piece, is_white);
+    setSquare({x, y}, Square(piece, is_white));
   }
 }
 
 void ChessBoard::initializeBoard(const std::vector<PieceConfig>& piece_configs) {
-  board.clear();
+  registerTypes(piece_configs);
+  for (int y = 0; y < board_size; ++y) {
+    for (int x = 0; x < board_size; ++x) {
+      setSquare({x, y}, Square());
+    }
+  }
   for (const auto& config : piece_configs) {
     if (config.positions.find("white") != config.positions.end()) {
       for (const auto& pos : config.positions.at("white")) {
@@ -65,61 +253,85 @@ void ChessBoard::initializeBoard(const std::vector<PieceConfig>& piece_configs)
 
 void ChessBoard::movePiece(const Position& start, const Position& end, 
                           MoveValidator& validator, PortalSystem& portal_system, 
-                          GameManager& game_manager) {
+                          GameManager& game_manager, const std::string& promotion) {
+    auto moved = tryMovePiece(start, end, validator, portal_system, game_manager, promotion);
+    if (!moved) {
+        throw std::invalid_argument(moveErrorText(moved.error()));
+    }
+}
+
+Expected<void, MoveError> ChessBoard::tryMovePiece(const Position& start, const Position& end,
+                                                   MoveValidator& validator,
+                                                   PortalSystem& portal_system,
+                                                   GameManager& game_manager,
+                                                   const std::string& promotion) {
     if (!isInBounds(start) || !isInBounds(end)) {
-        throw std::invalid_argument("Geçersiz pozisyon.");
+        return unexpected(MoveError::OutOfBounds);
     }
 
-    const auto& start_square = getSquare(start);
+    // Kopya: taş yer değiştirince referans boş kareyi gösterirdi
+    const Square start_square = getSquare(start);
+    const abilities::Mask moved = abilitiesAt(start);
 
+    if (start_square.is_empty()) {
+        return unexpected(MoveError::EmptySquare);
+    }
     if (!validator.isValidMove(start_square.piece, start, end, start_square.is_white, 
                               *this, portal_system)) {
-        throw std::invalid_argument("Geçersiz hareket.");
+        return unexpected(MoveError::IllegalMove);
     }
 
+    // Portaldan geçen kayan taş: geçilen portal ışınlamadaki gibi cooldown'a girer
+    int passage = portal_system.hasOpenPassage(start_square.is_white)
+                      ? validator.passagePortal(start_square.piece, start, end,
+                                                start_square.is_white, *this, portal_system)
+                      : -1;
+
     std::string captured_piece = getSquare(end).piece;
     bool captured_piece_color = getSquare(end).is_white;
 
-    
-    std::string start_str = posToString(start);
-    std::string end_str = posToString(end);
-    if (board.find(start_str) == board.end()) {
-        throw std::invalid_argument("Başlangıç pozisyonunda taş yok.");
-    }
-    board[end_str] = board[start_str];
-    board.erase(start_str);
+    setSquare(end, start_square);
+    setSquare(start, Square());
 
 
-    if (validator.toLowerCase(start_square.piece) == "pawn") {
+    if (abilities::has(moved, abilities::Promotion)) {
         bool is_promotion_rank = (start_square.is_white && end.y == 7) || 
                                (!start_square.is_white && end.y == 0);
         if (is_promotion_rank) {
-            handlePawnPromotion(end, start_square.is_white);
+            handlePawnPromotion(end, start_square.is_white, promotion);
         }
     }
 
     // En passant 
-    if (validator.toLowerCase(start_square.piece) == "pawn" && 
+    if (abilities::has(moved, abilities::EnPassant) &&
         abs(end.x - start.x) == 1 && getSquare(end).is_empty()) {
         Position captured_pawn_pos = {end.x, start.y};
-        if (!getSquare(captured_pawn_pos).is_empty()) {
-            std::string captured_str = posToString(captured_pawn_pos);
-            captured_piece = board[captured_str].piece;
-            captured_piece_color = board[captured_str].is_white;
-            board.erase(captured_str);
-            std::cout << "\nEn passantla piyon alındı." << std::endl;
+        if (hasAbility(captured_pawn_pos, abilities::EnPassant)) {
+            const Square& captured_square = getSquare(captured_pawn_pos);
+            captured_piece = captured_square.piece;
+            captured_piece_color = captured_square.is_white;
+            setSquare(captured_pawn_pos, Square());
+            if (verbose) std::cout << "\nEn passantla piyon alındı." << std::endl;
         }
     }
 
-    // Rok 
-    if (validator.toLowerCase(start_square.piece) == "king" && 
-        abs(end.x - start.x) == 2) {
+    // Rok (aynı sırada iki kare; portalla iki sütun kayan şah rok değildir)
+    if (abilities::has(moved, abilities::Royal) && abilities::has(moved, abilities::Castling) &&
+        abs(end.x - start.x) == 2 && end.y == start.y &&
+        !portal_system.isPortalMove(start, end)) {
         handleCastling(start, end);
     }
 
     // undo için
+    const std::string& landed_piece = getSquare(end).piece;
     game_manager.addToMoveHistory({start, end, start_square.piece, start_square.is_white, 
-                                  captured_piece, captured_piece_color});
+                                  captured_piece, captured_piece_color,
+                                  landed_piece != start_square.piece ? landed_piece : ""});
+
+    if (passage >= 0) {
+        if (verbose) std::cout << "\n!!Portaldan geçildi!!" << std::endl;
+        portal_system.startCooldown(passage);
+    }
 
     // Portal kontrolü 
     for (const auto& portal : portal_system.getPortals()) {
@@ -131,18 +343,13 @@ void ChessBoard::movePiece(const Position& start, const Position& end,
             if (!portal_system.isPortalInCooldown(end, portal_exit) &&
                 portal_system.validatePortalMove(start_square.piece, end, portal_exit, 
                                                start_square.is_white, *this)) {
-                std::cout << "\n!!Portal!!" << std::endl;
-                
-                
-                std::string exit_str = posToString(portal_exit);
-                board[exit_str] = board[end_str];
-                board.erase(end_str);
+                if (verbose) std::cout << "\n!!Portal!!" << std::endl;
                 
                 // stacke
                 game_manager.addToMoveHistory({end, portal_exit, start_square.piece, 
-                                             start_square.is_white, "", false});
-                
+                                             start_square.is_white, "", false, "", true});
                 
+                // Işınlama ve cooldown başlatma portal sisteminde
                 portal_system.handlePortalMove(end, portal_exit, *this);
                 break;
             }
@@ -151,13 +358,16 @@ void ChessBoard::movePiece(const Position& start, const Position& end,
 
    
     portal_system.updateCooldowns();
+    return {};
 }
 //DÖNNNNN
-void ChessBoard::handlePawnPromotion(const Position& pos, bool is_white) {
-    std::string promoted_piece;
-    std::cout << "\nPiyon terfi ediyor! Seçenekler: Queen, Rook, Bishop, Knight" << std::endl;
-    std::cout << "Terfi etmek istediğiniz taşı seçin: ";
-    std::cin >> promoted_piece;
+void ChessBoard::handlePawnPromotion(const Position& pos, bool is_white, const std::string& choice) {
+    std::string promoted_piece = choice;
+    if (promoted_piece.empty()) {
+        std::cout << "\nPiyon terfi ediyor! Seçenekler: Queen, Rook, Bishop, Knight" << std::endl;
+        std::cout << "Terfi etmek istediğiniz taşı seçin: ";
+        std::cin >> promoted_piece;
+    }
 
     // İlk harfi büyük, geri kalanı küçük yap
     promoted_piece[0] = std::toupper(promoted_piece[0]);
@@ -167,6 +377,10 @@ void ChessBoard::handlePawnPromotion(const Position& pos, bool is_white) {
 
     // Geçerli bir seçim mi kontrol et
     std::vector<std::string> valid_pieces = {"Queen", "Rook", "Bishop", "Knight"};
+    if (!choice.empty() &&
+        std::find(valid_pieces.begin(), valid_pieces.end(), promoted_piece) == valid_pieces.end()) {
+        promoted_piece = "Queen"; // etkileşimsiz çağrılarda geçersiz seçim vezir olur
+    }
     while (std::find(valid_pieces.begin(), valid_pieces.end(), promoted_piece) == valid_pieces.end()) {
         std::cout << "Geçersiz seçim. Lütfen tekrar deneyin: ";
         std::cin >> promoted_piece;
@@ -177,9 +391,10 @@ void ChessBoard::handlePawnPromotion(const Position& pos, bool is_white) {
     }
 
     // Piyonu terfi et
-    std::string pos_str = posToString(pos);
-    board[pos_str] = Square(promoted_piece, is_white);
-    std::cout << (is_white ? "Beyaz" : "Siyah") << " piyon " << promoted_piece << " olarak terfi etti!" << std::endl;
+    setSquare(pos, Square(promoted_piece, is_white));
+    if (verbose) {
+        std::cout << (is_white ? "Beyaz" : "Siyah") << " piyon " << promoted_piece << " olarak terfi etti!" << std::endl;
+    }
 }
 
 void ChessBoard::handleCastling(const Position& king_start, const Position& king_end) {
@@ -193,69 +408,16 @@ void ChessBoard::handleCastling(const Position& king_start, const Position& king
     Position rook_end = {rook_end_x, king_start.y};
     
     // Kaleyi hareket ettir
-    std::string rook_start_str = posToString(rook_start);
-    std::string rook_end_str = posToString(rook_end);
-    board[rook_end_str] = board[rook_start_str];
-    board.erase(rook_start_str);
+    setSquare(rook_end, getSquare(rook_start));
+    setSquare(rook_start, Square());
     
-    std::cout << "\nRok yapıldı!" << std::endl;
+    if (verbose) std::cout << "\nRok yapıldı!" << std::endl;
 }
 
 void ChessBoard::printBoard() const {
-  if (board_display_format == "simple") {
-    
-    for (int y = 0; y < board_size; ++y) {
-      for (int x = 0; x < board_size; ++x) {
-        const Square& square = getSquare({x, y});
-        if (square.is_empty()) {
-          std::cout << ". ";
-        } else {
-          char symbol = square.piece[0];
-          if (square.is_white) {
-            symbol = std::toupper(symbol);
-          }
-          std::cout << symbol << " ";
-        }
-      }
-      std::cout << "\n";
-    }
-  } else {
-    // Sütun (a,h) satır (1,8)
-    std::cout << "   ";
-    for (int x = 0; x < board_size; ++x) {
-      std::cout << (char)('a' + x) << "  ";
-    }
-    std::cout << std::endl;
-
-    for (int y = board_size - 1; y >= 0; --y) {
-      std::cout << (y + 1) << "  ";
-      for (int x = 0; x < board_size; ++x) {
-        Position pos{x, y};
-        std::string key = posToString(pos);
-        if (board.find(key) != board.end() && !board.at(key).is_empty()) {
-          const auto& square = board.at(key);
-          std::string piece_short;
-          if (square.piece == "King") piece_short = square.is_white ? "WK" : "BK";
-          else if (square.piece == "Queen") piece_short = square.is_white ? "WQ" : "BQ";
-          else if (square.piece == "Rook") piece_short = square.is_white ? "WR" : "BR";
-          else if (square.piece == "Bishop") piece_short = square.is_white ? "WB" : "BB";
-          else if (square.piece == "Knight") piece_short = square.is_white ? "WA" : "BA";
-          else if (square.piece == "Pawn") piece_short = square.is_white ? "WP" : "BP";
-          else piece_short = square.is_white ? "XX" : "xx";
-          std::cout << piece_short << " ";
-        } else {
-          std::cout << " . ";
-        }
-      }
-      std::cout << (y + 1) << std::endl;
-    }
-
-    std::cout << "   ";
-    for (int x = 0; x < board_size; ++x) {
-      std::cout << (char)('a' + x) << "  ";
-    }
-    std::cout << std::endl;
-  }
+  // Tek seferlik tam çizim; oyun döngüsü kendi BoardRenderer'ını tutar
+  BoardRenderer renderer(BoardRenderer::modeFromString(board_display_format));
+  renderer.render(*this);
 }
 
 //Koordinat sistemine dönüşüm 
@@ -1,48 +1,94 @@
 #include "ConfigReader.hpp"
+#include "Zobrist.hpp"
 #include <fstream>
 #include <iostream>
 
 ConfigReader::ConfigReader() {}
 
-bool ConfigReader::loadFromFile(const std::string &filePath) {
-  try {
-    std::ifstream file(filePath);
-    if (!file.is_open()) {
-      std::cerr << "Failed to open config file: " << filePath << std::endl;
-      return false;
+abilities::Mask compileAbilities(const SpecialAbilities& special_abilities) {
+  abilities::Mask mask = 0;
+  if (special_abilities.castling) mask |= abilities::bit(abilities::Castling);
+  if (special_abilities.royal) mask |= abilities::bit(abilities::Royal);
+  if (special_abilities.jump_over) mask |= abilities::bit(abilities::JumpOver);
+  if (special_abilities.promotion) mask |= abilities::bit(abilities::Promotion);
+  if (special_abilities.en_passant) mask |= abilities::bit(abilities::EnPassant);
+  for (const auto& [name, enabled] : special_abilities.custom_abilities) {
+    if (!enabled) continue;
+    int id = abilities::intern(name);
+    if (id < 0) {
+      std::cerr << "Too many custom abilities; ignoring: " << name << std::endl;
+      continue;
     }
+    mask |= abilities::bit(id);
+  }
+  return mask;
+}
 
-    nlohmann::json jsonData;
-    file >> jsonData;
+bool ConfigReader::loadFromFile(const std::string &filePath) {
+  auto loaded = tryLoadFromFile(filePath);
+  // validateConfig prints its own message
+  if (!loaded && loaded.error() != ConfigError::Invalid) {
+    std::cerr << m_error << std::endl;
+  }
+  return loaded.has_value();
+}
 
-    parseGameSettings(jsonData);
-    parsePieces(jsonData);
-    parseCustomPieces(jsonData);
-    parsePortals(jsonData);
+bool ConfigReader::loadFromString(const std::string &jsonString) {
+  auto loaded = tryLoadFromString(jsonString);
+  if (!loaded && loaded.error() != ConfigError::Invalid) {
+    std::cerr << m_error << std::endl;
+  }
+  return loaded.has_value();
+}
 
-    return validateConfig();
+Expected<void, ConfigError> ConfigReader::tryLoadFromFile(const std::string &filePath) {
+  std::ifstream file(filePath);
+  if (!file.is_open()) {
+    m_error = "Failed to open config file: " + filePath;
+    return unexpected(ConfigError::FileNotFound);
+  }
+  try {
+    nlohmann::json jsonData = nlohmann::json::parse(file);
+    return load(jsonData);
+  } catch (const nlohmann::json::parse_error &e) {
+    m_error = std::string("Error parsing config file: ") + e.what();
+    return unexpected(ConfigError::Syntax);
   } catch (const std::exception &e) {
-    std::cerr << "Error parsing config file: " << e.what() << std::endl;
-    return false;
+    m_error = std::string("Error parsing config file: ") + e.what();
+    return unexpected(ConfigError::Schema);
   }
 }
 
-bool ConfigReader::loadFromString(const std::string &jsonString) {
+Expected<void, ConfigError> ConfigReader::tryLoadFromString(const std::string &jsonString) {
   try {
     nlohmann::json jsonData = nlohmann::json::parse(jsonString);
-
-    parseGameSettings(jsonData);
-    parsePieces(jsonData);
-    parseCustomPieces(jsonData);
-    parsePortals(jsonData);
-
-    return validateConfig();
+    return load(jsonData);
+  } catch (const nlohmann::json::parse_error &e) {
+    m_error = std::string("Error parsing config string: ") + e.what();
+    return unexpected(ConfigError::Syntax);
   } catch (const std::exception &e) {
-    std::cerr << "Error parsing config string: " << e.what() << std::endl;
-    return false;
+    m_error = std::string("Error parsing config string: ") + e.what();
+    return unexpected(ConfigError::Schema);
   }
 }
 
+// Schema errors thrown by the json accessors are caught by the callers
+Expected<void, ConfigError> ConfigReader::load(const nlohmann::json &jsonData) {
+  parseGameSettings(jsonData);
+  parsePieces(jsonData);
+  parseCustomPieces(jsonData);
+  parsePortals(jsonData);
+  parseEvaluationSettings(jsonData);
+  m_config.config_hash = zobrist::fnv1a(jsonData.dump());
+
+  if (!validateConfig()) {
+    m_error = "Config validation failed";
+    return unexpected(ConfigError::Invalid);
+  }
+  m_error.clear();
+  return {};
+}
+
 const GameConfig &ConfigReader::getConfig() const { return m_config; }
 
 bool ConfigReader::validateConfig() {
@@ -94,6 +140,22 @@ bool ConfigReader::validateConfig() {
     }
   }
 
+  // Piece-square tables must cover the whole board
+  const size_t square_count =
+      static_cast<size_t>(m_config.game_settings.board_size) *
+      m_config.game_settings.board_size;
+  for (const auto *list : {&m_config.pieces, &m_config.custom_pieces}) {
+    for (const auto &piece : *list) {
+      const auto &table = piece.evaluation.piece_square_table;
+      if (!table.empty() && table.size() != square_count) {
+        std::cerr << "Piece " << piece.type << " piece-square table has "
+                  << table.size() << " entries, expected " << square_count
+                  << std::endl;
+        return false;
+      }
+    }
+  }
+
   // Validate portal positions are within board bounds
   for (const auto &portal : m_config.portals) {
     if (portal.id.empty()) {
@@ -163,6 +225,18 @@ void ConfigReader::parseSpecialAbilities(const nlohmann::json &abilities,
       }
     }
   }
+  specialAbilities.mask = compileAbilities(specialAbilities);
+}
+
+void ConfigReader::parsePieceAbilities(const nlohmann::json &pieceJson,
+                                       PieceConfig &piece) {
+  if (pieceJson.contains("special_abilities")) {
+    parseSpecialAbilities(pieceJson["special_abilities"],
+                          piece.special_abilities);
+  } else {
+    // Classic pieces without an abilities block get their defaults by name
+    piece.special_abilities.mask = abilities::defaultsFor(piece.type);
+  }
 }
 
 void ConfigReader::parsePieces(const nlohmann::json &json) {
@@ -217,9 +291,11 @@ void ConfigReader::parsePieces(const nlohmann::json &json) {
     }
 
     // Parse special abilities
-    if (pieceJson.contains("special_abilities")) {
-      parseSpecialAbilities(pieceJson["special_abilities"],
-                            piece.special_abilities);
+    parsePieceAbilities(pieceJson, piece);
+
+    // Parse evaluation parameters
+    if (pieceJson.contains("evaluation")) {
+      parsePieceEvaluation(pieceJson["evaluation"], piece.evaluation);
     }
 
     m_config.pieces.push_back(piece);
@@ -278,9 +354,11 @@ void ConfigReader::parseCustomPieces(const nlohmann::json &json) {
     }
 
     // Parse special abilities
-    if (pieceJson.contains("special_abilities")) {
-      parseSpecialAbilities(pieceJson["special_abilities"],
-                            piece.special_abilities);
+    parsePieceAbilities(pieceJson, piece);
+
+    // Parse evaluation parameters
+    if (pieceJson.contains("evaluation")) {
+      parsePieceEvaluation(pieceJson["evaluation"], piece.evaluation);
     }
 
     m_config.custom_pieces.push_back(piece);
@@ -339,3 +417,42 @@ void ConfigReader::parsePortals(const nlohmann::json &json) {
     m_config.portals.push_back(portal);
   }
 }
+
+void ConfigReader::parsePieceEvaluation(const nlohmann::json &evaluation,
+                                        PieceEvaluation &pieceEvaluation) {
+  if (!evaluation.is_object()) {
+    return;
+  }
+
+  if (evaluation.contains("value")) {
+    pieceEvaluation.has_value = true;
+    pieceEvaluation.value = evaluation["value"].get<int>();
+  }
+
+  // Table may be flat or a list of rows (row 0 = y 0)
+  if (evaluation.contains("piece_square_table") &&
+      evaluation["piece_square_table"].is_array()) {
+    for (const auto &entry : evaluation["piece_square_table"]) {
+      if (entry.is_array()) {
+        for (const auto &cell : entry) {
+          pieceEvaluation.piece_square_table.push_back(cell.get<int>());
+        }
+      } else {
+        pieceEvaluation.piece_square_table.push_back(entry.get<int>());
+      }
+    }
+  }
+}
+
+void ConfigReader::parseEvaluationSettings(const nlohmann::json &json) {
+  if (!json.contains("evaluation") || !json["evaluation"].is_object()) {
+    return;
+  }
+
+  const auto &evaluation = json["evaluation"];
+  m_config.evaluation.portal_entry_bonus =
+      evaluation.value("portal_entry_bonus", 0);
+  m_config.evaluation.portal_exit_bonus =
+      evaluation.value("portal_exit_bonus", 0);
+  m_config.evaluation.nnue_file = evaluation.value("nnue", std::string());
+}
@@ -0,0 +1,114 @@
+// ConfigWatcher.cpp
+#include "ConfigWatcher.hpp"
+#include <cerrno>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+namespace {
+
+// Durdurma isteği en geç bu aralıkla fark edilir
+constexpr int kPollMilliseconds = 100;
+
+} // namespace
+
+ConfigWatcher::ConfigWatcher(std::string path, std::shared_ptr<const Ruleset> initial)
+    : path(std::move(path)), ruleset(std::move(initial)) {}
+
+ConfigWatcher::~ConfigWatcher() {
+  stop();
+}
+
+bool ConfigWatcher::start(Listener on_reload) {
+  stop();
+  std::filesystem::path file(path);
+  std::string directory = file.has_parent_path() ? file.parent_path().string() : ".";
+  std::string file_name = file.filename().string();
+
+  inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (inotify_fd < 0) {
+    std::cerr << "inotify başlatılamadı; config izlenmiyor" << std::endl;
+    return false;
+  }
+  if (inotify_add_watch(inotify_fd, directory.c_str(),
+                        IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE) < 0) {
+    std::cerr << "Config dizini izlenemiyor: " << directory << std::endl;
+    ::close(inotify_fd);
+    inotify_fd = -1;
+    return false;
+  }
+
+  listener = std::move(on_reload);
+  worker = std::jthread([this, file_name](std::stop_token stop) { watch(stop, file_name); });
+  return true;
+}
+
+void ConfigWatcher::stop() {
+  if (worker.joinable()) {
+    worker.request_stop();
+    worker.join();
+    worker = std::jthread();
+  }
+  if (inotify_fd >= 0) {
+    ::close(inotify_fd);
+    inotify_fd = -1;
+  }
+}
+
+void ConfigWatcher::watch(std::stop_token stop, std::string file_name) {
+  using Clock = std::chrono::steady_clock;
+  alignas(inotify_event) char buffer[4096];
+  bool pending = false;
+  Clock::time_point last_event;
+
+  while (!stop.stop_requested()) {
+    pollfd descriptor{inotify_fd, POLLIN, 0};
+    int ready = poll(&descriptor, 1, kPollMilliseconds);
+    if (ready < 0 && errno != EINTR) {
+      std::cerr << "Config izleme hatası; izleme durdu" << std::endl;
+      return;
+    }
+    if (ready > 0) {
+      ssize_t length;
+      while ((length = read(inotify_fd, buffer, sizeof(buffer))) > 0) {
+        for (char* cursor = buffer; cursor < buffer + length;) {
+          auto* event = reinterpret_cast<inotify_event*>(cursor);
+          if (event->len > 0 && file_name == event->name) {
+            pending = true;
+            last_event = Clock::now();
+          }
+          cursor += sizeof(inotify_event) + event->len;
+        }
+      }
+    }
+    // Yazma bitene kadar bekle: yarım dosya okunursa doğrulama boşuna hata verir
+    if (pending && Clock::now() - last_event >= std::chrono::milliseconds(kSettleMilliseconds)) {
+      pending = false;
+      reload();
+    }
+  }
+}
+
+bool ConfigWatcher::reload() {
+  std::lock_guard<std::mutex> lock(reload_mutex);
+  ConfigReader reader;
+  if (!reader.loadFromFile(path)) {
+    std::string error = "config doğrulanamadı, eski kurallar geçerli: ";
+    error += path;
+    if (listener) listener(nullptr, {}, error);
+    return false;
+  }
+
+  std::shared_ptr<const Ruleset> live = ruleset.load();
+  ConfigDiff diff = diffConfigs(live->config, reader.getConfig());
+  if (diff.empty()) {
+    return false;
+  }
+  std::shared_ptr<const Ruleset> next = Ruleset::update(*live, reader.getConfig(), diff);
+  ruleset.store(next);
+  if (listener) listener(next, diff, "");
+  return true;
+}
@@ -0,0 +1,469 @@
+// EngineProtocol.cpp
+#include "EngineProtocol.hpp"
+#include "MoveNotation.hpp"
+#include "MoveValidator.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <poll.h>
+#include <unistd.h>
+
+namespace {
+
+// stop ve quit en geç bu aralıkla okunur (girdi yokken)
+constexpr int kPollMilliseconds = 100;
+// Süreli oyunda kalan hamle sayısı bilinmiyorsa süre bu kadar hamleye bölünür
+constexpr int kDefaultMovesToGo = 30;
+// Süre aşımına karşı saatte bırakılan pay
+constexpr long long kMoveOverheadMs = 50;
+
+std::string scoreText(int score) {
+  // Mat skoru kMateScore - ply; hamle sayısı ply'den
+  int distance = Search::kMateScore - std::abs(score);
+  if (distance < MoveOrdering::kMaxPly) {
+    int moves = (distance + 1) / 2;
+    return "mate " + std::to_string(score > 0 ? moves : -moves);
+  }
+  return "cp " + std::to_string(score);
+}
+
+std::string colorsText(const std::vector<std::string>& colors) {
+  std::string text;
+  for (const auto& color : colors) {
+    if (!text.empty()) text += ",";
+    text += color;
+  }
+  return text.empty() ? "-" : text;
+}
+
+// infinite'te bestmove stop gelmeden yazılmaz
+void waitForStop(std::stop_token stop) {
+  std::mutex wait_mutex;
+  std::condition_variable_any stopped;
+  std::unique_lock<std::mutex> lock(wait_mutex);
+  stopped.wait(lock, stop, [] { return false; });
+}
+
+// ponderhit sonrası süre dolunca aramayı durdurur; stop gelirse erken çıkar
+void stopAt(std::stop_token stop, std::stop_source search,
+            std::chrono::steady_clock::time_point deadline) {
+  std::mutex wait_mutex;
+  std::condition_variable_any stopped;
+  std::unique_lock<std::mutex> lock(wait_mutex);
+  stopped.wait_until(lock, stop, deadline, [] { return false; });
+  if (!stop.stop_requested()) search.request_stop();
+}
+
+} // namespace
+
+EngineProtocol::EngineProtocol(std::string config_file, std::shared_ptr<const Ruleset> ruleset,
+                               std::FILE* output)
+    : config_file(std::move(config_file)), ruleset(std::move(ruleset)), output(output) {
+  parser = std::make_unique<PositionParser>(this->ruleset->config, this->ruleset->evaluation,
+                                            this->ruleset->network);
+  reset();
+}
+
+EngineProtocol::~EngineProtocol() {
+  stopSearch();
+}
+
+void EngineProtocol::send(const std::string& lines) {
+  std::lock_guard<std::mutex> lock(output_mutex);
+  std::fwrite(lines.data(), 1, lines.size(), output);
+  std::fflush(output);
+}
+
+void EngineProtocol::reset() {
+  mcts.reset();
+  if (mate_solver) mate_solver->clear();
+  std::string error;
+  parser->parse("startpos", position, error);
+  played_plies = 0;
+}
+
+int EngineProtocol::run(int input_fd) {
+  std::string pending;
+  char buffer[4096];
+  while (true) {
+    pollfd descriptor{input_fd, POLLIN, 0};
+    int ready = poll(&descriptor, 1, kPollMilliseconds);
+    if (ready < 0) {
+      if (errno == EINTR) continue;
+      break;
+    }
+    if (ready == 0) continue;
+    ssize_t length = read(input_fd, buffer, sizeof(buffer));
+    if (length < 0 && (errno == EINTR || errno == EAGAIN)) continue;
+    if (length <= 0) break;
+    pending.append(buffer, static_cast<size_t>(length));
+
+    size_t start = 0, end;
+    while ((end = pending.find('\n', start)) != std::string::npos) {
+      std::string line = pending.substr(start, end - start);
+      start = end + 1;
+      if (!line.empty() && line.back() == '\r') line.pop_back();
+      if (!handle(line)) {
+        stopSearch();
+        return 0;
+      }
+    }
+    pending.erase(0, start);
+  }
+  // Girdi kapandı: son satır ve süren arama tamamlanır; sonsuz arama
+  // stop beklediğinden quit gibi durdurulur
+  if (!pending.empty()) handle(pending);
+  if (infinite_search) stopSearch();
+  if (worker.joinable()) worker.join();
+  return 0;
+}
+
+bool EngineProtocol::handle(const std::string& line) {
+  std::istringstream args(line);
+  std::string command;
+  if (!(args >> command)) return true;
+
+  if (command == "uci") {
+    std::string reply = "id name Portal Chess\nid author Portal Chess\n";
+    reply += "option name Config type string default " + config_file + "\n";
+    reply += "option name Engine type combo default AlphaBeta var AlphaBeta var MCTS\n";
+    reply += "option name Threads type spin default 0 min 0 max 256\nuciok\n";
+    send(reply);
+  } else if (command == "isready") {
+    send("readyok\n");
+  } else if (command == "ucinewgame") {
+    stopSearch();
+    reset();
+  } else if (command == "setoption") {
+    setOption(args);
+  } else if (command == "position") {
+    setPosition(args);
+  } else if (command == "go") {
+    go(args);
+  } else if (command == "ponderhit") {
+    ponderHit();
+  } else if (command == "stop") {
+    stopSearch();
+  } else if (command == "portals") {
+    send(portalState());
+  } else if (command == "quit") {
+    return false;
+  } else {
+    send("info string bilinmeyen komut: " + command + "\n");
+  }
+  return true;
+}
+
+bool EngineProtocol::loadConfig(const std::string& path, std::string& error) {
+  ConfigReader reader;
+  if (!reader.loadFromFile(path)) {
+    error = "config yüklenemedi: " + path;
+    return false;
+  }
+  int size = reader.getConfig().game_settings.board_size;
+  if (size <= 0 || size > 26) {
+    error = "geçersiz tahta boyutu: " + path;
+    return false;
+  }
+  ruleset = Ruleset::create(reader.getConfig());
+  parser = std::make_unique<PositionParser>(ruleset->config, ruleset->evaluation,
+                                            ruleset->network);
+  config_file = path;
+  return true;
+}
+
+void EngineProtocol::setOption(std::istringstream& args) {
+  // setoption name <ad...> value <değer...>; adlar ve değerler boşluk içerebilir
+  std::string token, name, value;
+  std::string* target = nullptr;
+  while (args >> token) {
+    if (token == "name") {
+      target = &name;
+    } else if (token == "value") {
+      target = &value;
+    } else if (target) {
+      if (!target->empty()) *target += " ";
+      *target += token;
+    }
+  }
+  if (name == "Engine" && (value == "AlphaBeta" || value == "MCTS")) {
+    stopSearch();
+    use_mcts = value == "MCTS";
+    return;
+  }
+  if (name == "Threads") {
+    int threads = 0;
+    std::istringstream(value) >> threads;
+    stopSearch();
+    mcts_threads = static_cast<unsigned>(std::clamp(threads, 0, 256));
+    mcts.reset();
+    return;
+  }
+  if (name != "Config") {
+    send("info string bilinmeyen seçenek: " + name + "\n");
+    return;
+  }
+  stopSearch();
+  std::string error;
+  if (!loadConfig(value, error)) {
+    send("info string " + error + "\n");
+    return;
+  }
+  reset();
+}
+
+void EngineProtocol::setPosition(std::istringstream& args) {
+  // PositionParser'ın satır biçimine çevrilir; FEN'in rok, en passant ve
+  // sayaç alanları bu tahtada tarihten türetilmediği için atlanır
+  // Tam hamle sayacı yalnızca oynanmış yarım hamleleri bulmak için okunur
+  std::string kind, token, text;
+  args >> kind;
+  int plies = 0;
+  bool black_to_move = false;
+  if (kind == "startpos") {
+    text = "startpos";
+  } else if (kind == "board" || kind == "fen") {
+    std::string placement, side;
+    args >> placement >> side;
+    text = "board " + placement + " " + side;
+    black_to_move = side == "b";
+  } else {
+    send("info string position: startpos, board veya fen bekleniyor\n");
+    return;
+  }
+  bool in_moves = false;
+  int fen_field = 0;
+  while (args >> token) {
+    if (token == "moves") {
+      in_moves = true;
+    } else if (in_moves) {
+      text += " " + token;
+      ++plies;
+    } else if (++fen_field == 4) {
+      int fullmove = 0;
+      std::istringstream(token) >> fullmove;
+      if (fullmove > 0) plies += 2 * (fullmove - 1) + (black_to_move ? 1 : 0);
+    }
+  }
+
+  stopSearch();
+  PositionParser::Setup next;
+  std::string error;
+  if (!parser->parse(text, next, error)) {
+    send("info string " + error + "\n");
+    return;
+  }
+  position = std::move(next);
+  played_plies = plies;
+}
+
+void EngineProtocol::go(std::istringstream& args) {
+  stopSearch();
+  Clock::time_point start = Clock::now();
+  SearchLimits limits;
+  bool infinite = false, ponder = false;
+  long long movetime = -1, time_left = -1, increment = 0, moves_to_go = kDefaultMovesToGo;
+  long long rollouts = 0;
+  int mate_moves = 0;
+  std::string token;
+  while (args >> token) {
+    long long value = 0;
+    if (token == "infinite") {
+      infinite = true;
+    } else if (token == "ponder") {
+      // ponderhit gelene kadar saat işlemez; süre o an başlar
+      infinite = true;
+      ponder = true;
+    } else if (args >> value) {
+      bool white = position.is_white;
+      if (token == "depth") {
+        limits.max_depth =
+            std::clamp(static_cast<int>(value), 1, MoveOrdering::kMaxPly - 1);
+      } else if (token == "movetime") {
+        movetime = value;
+      } else if (token == (white ? "wtime" : "btime")) {
+        time_left = value;
+      } else if (token == (white ? "winc" : "binc")) {
+        increment = value;
+      } else if (token == "movestogo" && value > 0) {
+        moves_to_go = value;
+      } else if (token == "nodes" && value > 0) {
+        rollouts = value;
+      } else if (token == "mate" && value > 0) {
+        mate_moves = static_cast<int>(std::min(value, 50LL));
+      }
+    }
+  }
+  infinite_search = infinite;
+  if (time_left >= 0) {
+    long long budget = time_left / moves_to_go + increment * 3 / 4;
+    budget = std::min(budget, time_left - kMoveOverheadMs);
+    movetime = std::max(budget, 1LL);
+  }
+  ponder_movetime = ponder ? movetime : -1;
+  if (!infinite && movetime >= 0) {
+    limits.deadline = start + std::chrono::milliseconds(std::max(movetime, 1LL));
+  }
+
+  if (mate_moves > 0) {
+    MateSolver::Limits mate_limits;
+    mate_limits.deadline = limits.deadline;
+    mate_limits.max_nodes = static_cast<uint64_t>(rollouts);
+    goMate(mate_moves, mate_limits, infinite, start);
+    return;
+  }
+  if (use_mcts) {
+    Mcts::Limits mcts_limits;
+    mcts_limits.deadline = limits.deadline;
+    mcts_limits.max_rollouts = static_cast<uint64_t>(rollouts);
+    // Oyun tur sınırında biter; rastgele oyunlar kalan yarım hamle kadar sürer
+    mcts_limits.rollout_plies =
+        std::max(0, 2 * ruleset->config.game_settings.turn_limit - played_plies);
+    goMcts(mcts_limits, infinite, start);
+    return;
+  }
+
+  ChessBoard board = *position.board;
+  board.setVerbose(false);
+  PortalSystem portals = *position.portals;
+  portals.setVerbose(false);
+  bool is_white = position.is_white;
+  std::shared_ptr<const Evaluation> evaluation = ruleset->evaluation;
+
+  worker = std::jthread([this, board, portals, is_white, limits, infinite, start,
+                         evaluation](std::stop_token stop) mutable {
+    MoveValidator validator;
+    validator.setVerbose(false);
+    Search search(*evaluation, validator);
+    limits.stop = stop;
+
+    SearchResult result = search.iterate(
+        board, portals, is_white, limits, [&](const SearchResult& r) {
+          long long ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                             Clock::now() - start).count();
+          std::string info = "info depth " + std::to_string(r.depth) + " score " +
+                             scoreText(r.score) + " nodes " + std::to_string(r.nodes) +
+                             " time " + std::to_string(ms) + " nps " +
+                             std::to_string(r.nodes * 1000 / static_cast<uint64_t>(ms + 1));
+          if (r.has_move) info += " pv " + formatCoordinateMove(r.best_move);
+          send(info + "\n");
+        });
+
+    if (infinite) waitForStop(stop);
+    send("bestmove " + (result.has_move ? formatCoordinateMove(result.best_move)
+                                        : std::string("0000")) + "\n");
+  });
+}
+
+void EngineProtocol::goMcts(Mcts::Limits limits, bool infinite, Clock::time_point start) {
+  if (!mcts) {
+    Mcts::Options options;
+    options.threads = mcts_threads;
+    options.rollout_plies = 2 * ruleset->config.game_settings.turn_limit;
+    mcts = std::make_unique<Mcts>(options);
+  }
+  ChessBoard board = *position.board;
+  board.setVerbose(false);
+  PortalSystem portals = *position.portals;
+  portals.setVerbose(false);
+  bool is_white = position.is_white;
+
+  worker = std::jthread([this, board, portals, is_white, limits, infinite,
+                         start](std::stop_token stop) mutable {
+    limits.stop = stop;
+    auto report = [&](const Mcts::Result& r) {
+      long long ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                         Clock::now() - start).count();
+      std::string info = "info time " + std::to_string(ms) + " rollouts " +
+                         std::to_string(r.rollouts) + " rps " +
+                         std::to_string(r.rollouts * 1000 / static_cast<uint64_t>(ms + 1)) +
+                         " tree " + std::to_string(r.tree_nodes) + " reused " +
+                         std::to_string(r.reused_nodes) + " winrate " +
+                         std::to_string(static_cast<int>(r.win_rate * 1000));
+      if (r.has_move) info += " pv " + formatCoordinateMove(r.best_move);
+      send(info + "\n");
+    };
+    Mcts::Result result = mcts->search(board, portals, is_white, limits, report);
+    report(result);
+    if (infinite) waitForStop(stop);
+    send("bestmove " + (result.has_move ? formatCoordinateMove(result.best_move)
+                                        : std::string("0000")) + "\n");
+  });
+}
+
+void EngineProtocol::goMate(int moves, MateSolver::Limits limits, bool infinite,
+                            Clock::time_point start) {
+  if (!mate_solver) mate_solver = std::make_unique<MateSolver>();
+  ChessBoard board = *position.board;
+  PortalSystem portals = *position.portals;
+  bool is_white = position.is_white;
+
+  worker = std::jthread([this, board, portals, is_white, moves, limits, infinite,
+                         start](std::stop_token stop) mutable {
+    limits.stop = stop;
+    MateSolver::Result result = mate_solver->solve(board, portals, is_white, moves, limits);
+    long long ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                       Clock::now() - start).count();
+    std::string stats = " nodes " + std::to_string(result.nodes) + " time " +
+                        std::to_string(ms) + " nps " +
+                        std::to_string(result.nodes * 1000 / static_cast<uint64_t>(ms + 1));
+    if (result.outcome == MateSolver::Outcome::Mate) {
+      std::string pv;
+      for (const auto& move : result.line) pv += " " + formatCoordinateMove(move);
+      send("info depth " + std::to_string(2 * result.moves - 1) + " score mate " +
+           std::to_string(result.moves) + stats + " pv" + pv + "\n");
+    } else if (result.outcome == MateSolver::Outcome::NoMate) {
+      send("info string " + std::to_string(moves) + " hamlede şah çekerek mat yok" + stats + "\n");
+    } else {
+      std::string proven = result.moves > 0 ? ", " + std::to_string(result.moves) +
+                                                  " hamleye kadar mat yok" : "";
+      send("info string mat aranırken sınıra ulaşıldı" + proven + stats + "\n");
+    }
+    if (infinite) waitForStop(stop);
+    send("bestmove " + (result.line.empty() ? std::string("0000")
+                                            : formatCoordinateMove(result.line.front())) + "\n");
+  });
+}
+
+void EngineProtocol::ponderHit() {
+  // Tahmin tuttu: ponder araması normal aramaya döner. Süresiz ponder
+  // (go ponder infinite gibi) stop'a kadar sürer.
+  if (!worker.joinable() || ponder_movetime < 0) return;
+  infinite_search = false;
+  auto deadline = Clock::now() + std::chrono::milliseconds(std::max(ponder_movetime, 1LL));
+  ponder_timer = std::jthread(stopAt, worker.get_stop_source(), deadline);
+  ponder_movetime = -1;
+}
+
+void EngineProtocol::stopSearch() {
+  ponder_timer = std::jthread();
+  if (!worker.joinable()) return;
+  worker.request_stop();
+  worker.join();
+  worker = std::jthread();
+}
+
+std::string EngineProtocol::portalState() const {
+  const PortalSystem& portals = *position.portals;
+  std::vector<int> cooldowns = portals.getCooldownState();
+  std::string text;
+  const auto& list = portals.getPortals();
+  for (size_t i = 0; i < list.size(); ++i) {
+    const PortalConfig& portal = list[i];
+    std::string open;
+    for (bool white : {true, false}) {
+      if (cooldowns[i] == 0 && portals.getRules()->allows(static_cast<int>(i), white)) {
+        if (!open.empty()) open += ",";
+        open += white ? "white" : "black";
+      }
+    }
+    text += "portal id " + portal.id + " entry " + squareToText(portal.positions.entry) +
+            " exit " + squareToText(portal.positions.exit) + " cooldown " +
+            std::to_string(cooldowns[i]) + "/" +
+            std::to_string(portal.properties.cooldown) + " colors " +
+            colorsText(portal.properties.allowed_colors) + " preserve " +
+            (portal.properties.preserve_direction ? "1" : "0") + " open " +
+            (open.empty() ? "-" : open) + "\n";
+  }
+  return text + "portalsok\n";
+}
@@ -0,0 +1,158 @@
+// Evaluation.cpp
+#include "Evaluation.hpp"
+#include "ChessBoard.hpp"
+#include <algorithm>
+#include <cctype>
+
+Evaluation::Evaluation(const GameConfig& config)
+    : board_size(config.game_settings.board_size),
+      portal_entry_bonus(config.evaluation.portal_entry_bonus),
+      portal_exit_bonus(config.evaluation.portal_exit_bonus) {
+  size_t square_count = static_cast<size_t>(board_size) * board_size;
+
+  // Portal kontrolü: sadece portalı kullanabilen renk bonus alır
+  white_portal_bonus.assign(square_count, 0);
+  black_portal_bonus.assign(square_count, 0);
+  for (const auto& portal : config.portals) {
+    applyPortal(portal, 1);
+  }
+
+  for (const auto& piece : config.pieces) {
+    addPieceType(piece);
+  }
+  for (const auto& piece : config.custom_pieces) {
+    addPieceType(piece);
+  }
+
+  // Terfi taşları config'de olmasa da değerlendirilebilsin
+  for (const char* promoted : {"Queen", "Rook", "Bishop", "Knight"}) {
+    if (type_index.find(promoted) == type_index.end()) {
+      PieceConfig piece;
+      piece.type = promoted;
+      addPieceType(piece);
+    }
+  }
+}
+
+int Evaluation::defaultPieceValue(const std::string& piece) {
+  std::string lower = piece;
+  std::transform(lower.begin(), lower.end(), lower.begin(),
+                 [](unsigned char c) { return std::tolower(c); });
+  if (lower == "pawn") return 100;
+  if (lower == "knight") return 320;
+  if (lower == "bishop") return 330;
+  if (lower == "rook") return 500;
+  if (lower == "queen") return 900;
+  if (lower == "king") return 0; // şah tahtadan çıkmaz
+  return 300;                    // özel taşlar
+}
+
+void Evaluation::buildTables(const PieceConfig& piece, int& value, std::vector<int>& white,
+                             std::vector<int>& black) const {
+  value = piece.evaluation.has_value ? piece.evaluation.value : defaultPieceValue(piece.type);
+  const auto& pst = piece.evaluation.piece_square_table;
+  size_t square_count = white_portal_bonus.size();
+
+  white.assign(square_count, 0);
+  black.assign(square_count, 0);
+  for (int y = 0; y < board_size; ++y) {
+    for (int x = 0; x < board_size; ++x) {
+      size_t index = static_cast<size_t>(y) * board_size + x;
+      size_t mirrored = static_cast<size_t>(board_size - 1 - y) * board_size + x;
+      int white_pst = pst.empty() ? 0 : pst[index];
+      int black_pst = pst.empty() ? 0 : pst[mirrored];
+      white[index] = value + white_pst + white_portal_bonus[index];
+      black[index] = -(value + black_pst + black_portal_bonus[index]);
+    }
+  }
+}
+
+void Evaluation::addPieceType(const PieceConfig& piece) {
+  if (type_index.find(piece.type) != type_index.end()) {
+    return;
+  }
+  int value = 0;
+  std::vector<int> white, black;
+  buildTables(piece, value, white, black);
+  type_index[piece.type] = static_cast<int>(values.size());
+  values.push_back(value);
+  white_tables.push_back(std::move(white));
+  black_tables.push_back(std::move(black));
+}
+
+void Evaluation::updatePieceType(const PieceConfig& piece) {
+  auto it = type_index.find(piece.type);
+  if (it == type_index.end()) {
+    addPieceType(piece);
+    return;
+  }
+  // Tip ID'si korunur; yalnızca bu tipin tabloları yeniden hesaplanır
+  buildTables(piece, values[it->second], white_tables[it->second], black_tables[it->second]);
+}
+
+void Evaluation::updatePortal(const PortalConfig* removed, const PortalConfig* added) {
+  if (removed != nullptr) applyPortal(*removed, -1);
+  if (added != nullptr) applyPortal(*added, 1);
+}
+
+void Evaluation::applyPortal(const PortalConfig& portal, int sign) {
+  const auto& colors = portal.properties.allowed_colors;
+  size_t entry = static_cast<size_t>(portal.positions.entry.y) * board_size +
+                 portal.positions.entry.x;
+  size_t exit = static_cast<size_t>(portal.positions.exit.y) * board_size +
+                portal.positions.exit.x;
+  int entry_delta = sign * portal_entry_bonus;
+  int exit_delta = sign * portal_exit_bonus;
+
+  // Bonus dizileri ve mevcut tipler için birleştirilmiş tablolarda sadece iki kare değişir
+  if (std::find(colors.begin(), colors.end(), "white") != colors.end()) {
+    white_portal_bonus[entry] += entry_delta;
+    white_portal_bonus[exit] += exit_delta;
+    for (auto& table : white_tables) {
+      table[entry] += entry_delta;
+      table[exit] += exit_delta;
+    }
+  }
+  if (std::find(colors.begin(), colors.end(), "black") != colors.end()) {
+    black_portal_bonus[entry] += entry_delta;
+    black_portal_bonus[exit] += exit_delta;
+    for (auto& table : black_tables) {
+      table[entry] -= entry_delta;
+      table[exit] -= exit_delta;
+    }
+  }
+}
+
+int Evaluation::pieceValue(const std::string& piece) const {
+  auto it = type_index.find(piece);
+  return it != type_index.end() ? values[it->second] : defaultPieceValue(piece);
+}
+
+int Evaluation::typeId(const std::string& piece) const {
+  auto it = type_index.find(piece);
+  return it != type_index.end() ? it->second : -1;
+}
+
+int Evaluation::squareScore(const std::string& piece, bool is_white,
+                            const Position& pos) const {
+  if (piece.empty()) {
+    return 0;
+  }
+  auto it = type_index.find(piece);
+  if (it == type_index.end()) {
+    return 0;
+  }
+  size_t index = static_cast<size_t>(pos.y) * board_size + pos.x;
+  return is_white ? white_tables[it->second][index] : black_tables[it->second][index];
+}
+
+int Evaluation::fullScore(const ChessBoard& board) const {
+  int score = 0;
+  for (int y = 0; y < board.getBoardSize(); ++y) {
+    for (int x = 0; x < board.getBoardSize(); ++x) {
+      const auto& square = board.getSquare({x, y});
+      score += squareScore(square.piece, square.is_white, {x, y});
+    }
+  }
+  return score;
+}
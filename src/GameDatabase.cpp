@@ -0,0 +1,566 @@
+// GameDatabase.cpp
+#include "GameDatabase.hpp"
+#include "ChessBoard.hpp"
+#include "GameManager.hpp"
+#include "MoveGenerator.hpp"
+#include "MoveValidator.hpp"
+#include "PortalSystem.hpp"
+#include "Zobrist.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static_assert(sizeof(GameDatabase::Header) == 32, "depo başlığı sabit boyutlu olmalı");
+static_assert(sizeof(GameDatabase::RecordHeader) == 32, "oyun başlığı sabit boyutlu olmalı");
+static_assert(sizeof(GameDatabase::IndexHeader) == 32, "indeks başlığı sabit boyutlu olmalı");
+static_assert(sizeof(GameDatabase::IndexEntry) == 16, "indeks girişi sabit boyutlu olmalı");
+
+namespace {
+const char kMagic[8] = {'P', 'C', 'G', 'A', 'M', 'E', 'S', '\0'};
+const char kIndexMagic[8] = {'P', 'C', 'G', 'I', 'D', 'X', '\0', '\0'};
+
+size_t paddedRecordSize(size_t ply_count, size_t metadata_size) {
+  size_t size = sizeof(GameDatabase::RecordHeader) + ply_count * sizeof(uint32_t) + metadata_size;
+  return (size + 7) & ~static_cast<size_t>(7);
+}
+
+// Başlıktan sonraki eksiksiz kayıtların yerlerini toplar; yarım kalmış bir
+// son kaydın (fsync'ten önce çöken yazıcı) başladığı yeri döndürür
+size_t scanRecords(const char* data, size_t size, std::vector<size_t>* offsets) {
+  size_t offset = sizeof(GameDatabase::Header);
+  while (offset + sizeof(GameDatabase::RecordHeader) <= size) {
+    GameDatabase::RecordHeader record;
+    std::memcpy(&record, data + offset, sizeof(record));
+    if (record.record_size == 0 || record.record_size % 8 != 0 ||
+        record.record_size > size - offset ||
+        record.record_size < paddedRecordSize(record.ply_count, record.metadata_size)) {
+      break;
+    }
+    if (offsets != nullptr) offsets->push_back(offset);
+    offset += record.record_size;
+  }
+  return offset;
+}
+
+bool validHeader(const GameDatabase::Header& header) {
+  return std::memcmp(header.magic, kMagic, sizeof(kMagic)) == 0 &&
+         header.version == GameDatabase::kVersion;
+}
+
+bool writeAll(int fd, const char* data, size_t size) {
+  while (size > 0) {
+    ssize_t written = ::write(fd, data, size);
+    if (written < 0) {
+      if (errno == EINTR) continue;
+      return false;
+    }
+    data += written;
+    size -= static_cast<size_t>(written);
+  }
+  return true;
+}
+
+// PGN etiket değerinde tırnak ve ters bölü kaçışlanır
+std::string escapeTag(const std::string& value) {
+  std::string escaped;
+  for (char c : value) {
+    if (c == '"' || c == '\\') escaped += '\\';
+    escaped += c;
+  }
+  return escaped;
+}
+
+} // namespace
+
+GameDatabase::Writer::Writer(size_t sync_every) : sync_every(std::max<size_t>(1, sync_every)) {}
+
+GameDatabase::Writer::~Writer() {
+  close();
+}
+
+bool GameDatabase::Writer::open(const std::string& file_path) {
+  close();
+  int file = ::open(file_path.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+  if (file < 0) {
+    std::cerr << "Oyun deposu açılamadı: " << file_path << std::endl;
+    return false;
+  }
+  struct stat info;
+  if (fstat(file, &info) != 0) {
+    std::cerr << "Oyun deposu okunamadı: " << file_path << std::endl;
+    ::close(file);
+    return false;
+  }
+
+  size_t size = static_cast<size_t>(info.st_size);
+  if (size == 0) {
+    Header header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.created = static_cast<int64_t>(std::time(nullptr));
+    if (!writeAll(file, reinterpret_cast<const char*>(&header), sizeof(header)) ||
+        fsync(file) != 0) {
+      std::cerr << "Oyun deposu yazılamadı: " << file_path << std::endl;
+      ::close(file);
+      return false;
+    }
+  } else {
+    void* data = size >= sizeof(Header)
+                     ? mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0)
+                     : MAP_FAILED;
+    if (data == MAP_FAILED || !validHeader(*static_cast<const Header*>(data))) {
+      std::cerr << "Oyun deposu biçimi tanınmadı: " << file_path << std::endl;
+      if (data != MAP_FAILED) munmap(data, size);
+      ::close(file);
+      return false;
+    }
+    size_t valid = scanRecords(static_cast<const char*>(data), size, nullptr);
+    munmap(data, size);
+    if (valid != size) {
+      std::cerr << "Oyun deposunun sonundaki yarım kayıt atıldı (" << (size - valid)
+                << " bayt): " << file_path << std::endl;
+      if (ftruncate(file, static_cast<off_t>(valid)) != 0) {
+        ::close(file);
+        return false;
+      }
+    }
+  }
+
+  fd = file;
+  path = file_path;
+  return true;
+}
+
+bool GameDatabase::Writer::append(const GameRecord& game) {
+  if (fd < 0) {
+    return false;
+  }
+
+  std::string metadata;
+  for (const auto& [key, value] : game.metadata) {
+    // Anahtarda '=', değerde satır sonu olamaz
+    std::string clean_key = key, clean_value = value;
+    std::replace(clean_key.begin(), clean_key.end(), '=', '_');
+    std::replace(clean_key.begin(), clean_key.end(), '\n', ' ');
+    std::replace(clean_value.begin(), clean_value.end(), '\n', ' ');
+    metadata += clean_key + "=" + clean_value + "\n";
+  }
+  metadata.resize(std::min<size_t>(metadata.size(), UINT16_MAX));
+
+  RecordHeader record{};
+  record.record_size = static_cast<uint32_t>(paddedRecordSize(game.moves.size(), metadata.size()));
+  record.ply_count = static_cast<uint32_t>(game.moves.size());
+  record.config_hash = game.config_hash;
+  record.timestamp = game.timestamp != 0 ? game.timestamp : static_cast<int64_t>(std::time(nullptr));
+  record.metadata_size = static_cast<uint16_t>(metadata.size());
+  record.board_size = static_cast<uint8_t>(game.board_size);
+  record.result = static_cast<uint8_t>(game.result);
+
+  size_t start = buffer.size();
+  buffer.append(reinterpret_cast<const char*>(&record), sizeof(record));
+  for (const auto& move : game.moves) {
+    uint32_t packed = packMove(move, game.board_size);
+    buffer.append(reinterpret_cast<const char*>(&packed), sizeof(packed));
+  }
+  buffer += metadata;
+  buffer.resize(start + record.record_size, '\0');
+
+  if (++pending >= sync_every) {
+    return flush();
+  }
+  return true;
+}
+
+bool GameDatabase::Writer::flush() {
+  if (fd < 0) {
+    return false;
+  }
+  if (buffer.empty()) {
+    return true;
+  }
+  if (!writeAll(fd, buffer.data(), buffer.size()) || fsync(fd) != 0) {
+    std::cerr << "Oyun deposuna yazılamadı: " << path << std::endl;
+    return false;
+  }
+  buffer.clear();
+  pending = 0;
+  return true;
+}
+
+void GameDatabase::Writer::close() {
+  if (fd < 0) {
+    return;
+  }
+  flush();
+  ::close(fd);
+  fd = -1;
+  buffer.clear();
+  pending = 0;
+}
+
+GameDatabase::~GameDatabase() {
+  close();
+}
+
+void GameDatabase::close() {
+  closeIndex();
+  if (mapping != nullptr) {
+    munmap(mapping, mapping_size);
+  }
+  mapping = nullptr;
+  mapping_size = 0;
+  offsets.clear();
+}
+
+void GameDatabase::closeIndex() {
+  if (index_mapping != nullptr) {
+    munmap(index_mapping, index_mapping_size);
+  }
+  index_mapping = nullptr;
+  index_mapping_size = 0;
+  index_entries = nullptr;
+  index_entry_count = 0;
+}
+
+bool GameDatabase::open(const std::string& path) {
+  close();
+
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    std::cerr << "Oyun deposu açılamadı: " << path << std::endl;
+    return false;
+  }
+  struct stat info;
+  if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(Header)) {
+    std::cerr << "Oyun deposu bozuk: " << path << std::endl;
+    ::close(fd);
+    return false;
+  }
+
+  void* data = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (data == MAP_FAILED) {
+    std::cerr << "Oyun deposu eşlenemedi: " << path << std::endl;
+    return false;
+  }
+  if (!validHeader(*static_cast<const Header*>(data))) {
+    std::cerr << "Oyun deposu biçimi tanınmadı: " << path << std::endl;
+    munmap(data, info.st_size);
+    return false;
+  }
+
+  mapping = data;
+  mapping_size = info.st_size;
+  size_t valid = scanRecords(static_cast<const char*>(data), mapping_size, &offsets);
+  if (valid != mapping_size) {
+    // Yazıcı hâlâ çalışıyor olabilir; tamamlanmamış kayıt görmezden gelinir
+    std::cerr << "Oyun deposunun sonundaki yarım kayıt okunmadı: " << path << std::endl;
+  }
+  return true;
+}
+
+GameDatabase::GameView GameDatabase::game(size_t id) const {
+  GameView view;
+  if (id >= offsets.size()) {
+    return view;
+  }
+  const char* record = static_cast<const char*>(mapping) + offsets[id];
+  view.header = reinterpret_cast<const RecordHeader*>(record);
+  const auto* moves = reinterpret_cast<const uint32_t*>(record + sizeof(RecordHeader));
+  view.moves = {moves, view.header->ply_count};
+  view.metadata = {reinterpret_cast<const char*>(moves + view.header->ply_count),
+                   view.header->metadata_size};
+  return view;
+}
+
+bool GameDatabase::writeIndex(const std::string& path, const GameConfig& config) const {
+  int board_size = config.game_settings.board_size;
+  std::vector<PieceConfig> all_pieces = config.pieces;
+  all_pieces.insert(all_pieces.end(), config.custom_pieces.begin(), config.custom_pieces.end());
+
+  ChessBoard initial(board_size);
+  initial.initializeBoard(all_pieces);
+  initial.setVerbose(false);
+  MoveValidator validator;
+  validator.setVerbose(false);
+  MoveGenerator generator(validator);
+  auto portal_rules = std::make_shared<const PortalRules>(config.portals);
+
+  std::vector<IndexEntry> entries;
+  size_t skipped = 0;
+  for (size_t id = 0; id < size(); ++id) {
+    GameView view = game(id);
+    if (view.header->config_hash != config.config_hash || view.header->board_size != board_size) {
+      ++skipped;
+      continue;
+    }
+
+    ChessBoard board = initial;
+    PortalSystem portal_system(portal_rules);
+    portal_system.setVerbose(false);
+    bool is_white_turn = true;
+    size_t plies = std::min<size_t>(view.moves.size(), UINT16_MAX);
+    for (size_t ply = 0; ply <= plies; ++ply) {
+      IndexEntry entry{};
+      entry.key = zobrist::positionKey(board.getHash(), portal_system.stateHash(), is_white_turn);
+      entry.game = static_cast<uint32_t>(id);
+      entry.ply = static_cast<uint16_t>(ply);
+      entries.push_back(entry);
+      if (ply == plies) break;
+
+      CoordinateMove move = unpackMove(view.moves[ply], board_size);
+      const auto& square = board.getSquare(move.from);
+      if (square.is_empty() || square.is_white != is_white_turn) {
+        std::cerr << "Oyun " << id << ", yarım hamle " << ply
+                  << ": geçersiz hamle, indeksleme durdu: " << formatCoordinateMove(move) << "\n";
+        break;
+      }
+      if (!generator.tryMakeMove(board, portal_system, move)) {
+        std::cerr << "Oyun " << id << ", yarım hamle " << ply
+                  << ": geçersiz hamle, indeksleme durdu: " << formatCoordinateMove(move) << "\n";
+        break;
+      }
+      is_white_turn = !is_white_turn;
+    }
+  }
+  if (skipped > 0) {
+    std::cerr << skipped << " oyun başka bir config ile oynandığı için indekslenmedi\n";
+  }
+
+  // Anahtar, oyun, yarım hamle sırası; oyun içindeki tekrarlarda ilk ulaşılan kalır
+  std::sort(entries.begin(), entries.end(), [](const IndexEntry& a, const IndexEntry& b) {
+    if (a.key != b.key) return a.key < b.key;
+    if (a.game != b.game) return a.game < b.game;
+    return a.ply < b.ply;
+  });
+  entries.erase(std::unique(entries.begin(), entries.end(),
+                            [](const IndexEntry& a, const IndexEntry& b) {
+                              return a.key == b.key && a.game == b.game;
+                            }),
+                entries.end());
+
+  IndexHeader header{};
+  std::memcpy(header.magic, kIndexMagic, sizeof(kIndexMagic));
+  header.version = kIndexVersion;
+  header.game_count = size();
+  header.entry_count = entries.size();
+
+  // Açık okuyucuların eşlemesi bozulmasın diye geçici dosyaya yazıp yer değiştir
+  std::string temporary = path + ".tmp";
+  {
+    std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+      std::cerr << "Oyun indeksi yazılamadı: " << path << std::endl;
+      return false;
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(entries.data()),
+              static_cast<std::streamsize>(entries.size() * sizeof(IndexEntry)));
+    if (!out) {
+      std::cerr << "Oyun indeksi yazılamadı: " << path << std::endl;
+      return false;
+    }
+  }
+  if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+    std::cerr << "Oyun indeksi yazılamadı: " << path << std::endl;
+    return false;
+  }
+  return true;
+}
+
+bool GameDatabase::openIndex(const std::string& path) {
+  closeIndex();
+
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    std::cerr << "Oyun indeksi açılamadı: " << path << std::endl;
+    return false;
+  }
+  struct stat info;
+  if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(IndexHeader)) {
+    std::cerr << "Oyun indeksi bozuk: " << path << std::endl;
+    ::close(fd);
+    return false;
+  }
+
+  void* data = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (data == MAP_FAILED) {
+    std::cerr << "Oyun indeksi eşlenemedi: " << path << std::endl;
+    return false;
+  }
+
+  const auto* header = static_cast<const IndexHeader*>(data);
+  size_t expected = sizeof(IndexHeader) + header->entry_count * sizeof(IndexEntry);
+  if (std::memcmp(header->magic, kIndexMagic, sizeof(kIndexMagic)) != 0 ||
+      header->version != kIndexVersion || expected != static_cast<size_t>(info.st_size)) {
+    std::cerr << "Oyun indeksi biçimi tanınmadı: " << path << std::endl;
+    munmap(data, info.st_size);
+    return false;
+  }
+  if (header->game_count > size()) {
+    std::cerr << "Oyun indeksi başka bir depoya ait: " << path << std::endl;
+    munmap(data, info.st_size);
+    return false;
+  }
+  if (header->game_count < size()) {
+    std::cerr << "Oyun indeksi eski; son " << (size() - header->game_count)
+              << " oyun aramalarda görünmez: " << path << std::endl;
+  }
+
+  index_mapping = data;
+  index_mapping_size = info.st_size;
+  index_entries = reinterpret_cast<const IndexEntry*>(static_cast<const char*>(data) +
+                                                      sizeof(IndexHeader));
+  index_entry_count = header->entry_count;
+  return true;
+}
+
+std::span<const GameDatabase::IndexEntry> GameDatabase::gamesReaching(uint64_t key) const {
+  if (index_entries == nullptr) {
+    return {};
+  }
+  const IndexEntry* end = index_entries + index_entry_count;
+  auto first = std::lower_bound(index_entries, end, key,
+                                [](const IndexEntry& entry, uint64_t k) { return entry.key < k; });
+  auto last = std::upper_bound(first, end, key,
+                               [](uint64_t k, const IndexEntry& entry) { return k < entry.key; });
+  return {first, static_cast<size_t>(last - first)};
+}
+
+std::string GameDatabase::toPgn(size_t id) const {
+  GameView view = game(id);
+  if (view.header == nullptr) {
+    return "";
+  }
+  Metadata metadata = parseMetadata(view.metadata);
+  auto tag = [&](const std::string& name, const std::string& fallback) {
+    for (const auto& [key, value] : metadata) {
+      if (key == name) return value;
+    }
+    return fallback;
+  };
+
+  std::string date = "????.??.??";
+  if (view.header->timestamp != 0) {
+    std::time_t time = static_cast<std::time_t>(view.header->timestamp);
+    std::tm parts{};
+    char text[16];
+    if (gmtime_r(&time, &parts) != nullptr &&
+        std::strftime(text, sizeof(text), "%Y.%m.%d", &parts) > 0) {
+      date = text;
+    }
+  }
+  char hash[17];
+  std::snprintf(hash, sizeof(hash), "%016llx",
+                static_cast<unsigned long long>(view.header->config_hash));
+  const char* result = resultText(static_cast<Result>(view.header->result));
+
+  // Standart yedi etiketin ardından varyanta özgü etiketler
+  std::string pgn;
+  auto appendTag = [&pgn](const std::string& name, const std::string& value) {
+    pgn += "[" + name + " \"" + escapeTag(value) + "\"]\n";
+  };
+  appendTag("Event", tag("Event", "?"));
+  appendTag("Site", tag("Site", "?"));
+  appendTag("Date", date);
+  appendTag("Round", tag("Round", "?"));
+  appendTag("White", tag("White", "?"));
+  appendTag("Black", tag("Black", "?"));
+  appendTag("Result", result);
+  appendTag("BoardSize", std::to_string(view.header->board_size));
+  appendTag("ConfigHash", hash);
+  for (const auto& [key, value] : metadata) {
+    if (key == "Event" || key == "Site" || key == "Round" || key == "White" ||
+        key == "Black" || key == "Date" || key == "Result") {
+      continue;
+    }
+    appendTag(key, value);
+  }
+  pgn += "\n";
+
+  // Hamle metni 80 sütunda satır atlar
+  std::string line;
+  auto appendToken = [&](const std::string& token) {
+    if (!line.empty() && line.size() + 1 + token.size() > 79) {
+      pgn += line + "\n";
+      line.clear();
+    }
+    if (!line.empty()) line += ' ';
+    line += token;
+  };
+  for (size_t ply = 0; ply < view.moves.size(); ++ply) {
+    if (ply % 2 == 0) appendToken(std::to_string(ply / 2 + 1) + ".");
+    appendToken(formatCoordinateMove(unpackMove(view.moves[ply], view.header->board_size)));
+  }
+  appendToken(result);
+  pgn += line + "\n";
+  return pgn;
+}
+
+GameDatabase::Metadata GameDatabase::parseMetadata(std::string_view text) {
+  Metadata metadata;
+  while (!text.empty()) {
+    size_t end = text.find('\n');
+    std::string_view line = text.substr(0, end);
+    size_t separator = line.find('=');
+    if (separator != std::string_view::npos) {
+      metadata.emplace_back(std::string(line.substr(0, separator)),
+                            std::string(line.substr(separator + 1)));
+    }
+    if (end == std::string_view::npos) break;
+    text.remove_prefix(end + 1);
+  }
+  return metadata;
+}
+
+const char* GameDatabase::resultText(Result result) {
+  switch (result) {
+  case Result::WhiteWins:
+    return "1-0";
+  case Result::BlackWins:
+    return "0-1";
+  case Result::Draw:
+    return "1/2-1/2";
+  case Result::Unknown:
+    break;
+  }
+  return "*";
+}
+
+uint32_t GameDatabase::packMove(const CoordinateMove& move, int board_size) {
+  uint32_t from = static_cast<uint32_t>(move.from.y * board_size + move.from.x);
+  uint32_t to = static_cast<uint32_t>(move.to.y * board_size + move.to.x);
+  return from | (to << 10) | (static_cast<uint32_t>(static_cast<uint8_t>(move.promotion)) << 24);
+}
+
+CoordinateMove GameDatabase::unpackMove(uint32_t packed, int board_size) {
+  int from = static_cast<int>(packed & 0x3FF);
+  int to = static_cast<int>((packed >> 10) & 0x3FF);
+  CoordinateMove move;
+  move.from = {from % board_size, from / board_size};
+  move.to = {to % board_size, to / board_size};
+  move.promotion = static_cast<char>(packed >> 24);
+  return move;
+}
+
+std::vector<CoordinateMove> GameDatabase::movesFromHistory(const GameManager& game_manager) {
+  std::vector<CoordinateMove> moves;
+  for (const auto& entry : game_manager.getMoveHistory()) {
+    if (entry.portal_teleport) continue;
+    CoordinateMove move;
+    move.from = entry.start;
+    move.to = entry.end;
+    move.promotion = promotionLetter(entry.promoted_to);
+    moves.push_back(move);
+  }
+  return moves;
+}
@@ -1,137 +1,230 @@
 #include "GameManager.hpp"
+#include "BoardKernels.hpp"
 #include "ChessBoard.hpp"
+#include "MoveGenerator.hpp"
 #include "MoveValidator.hpp"
 #include "PortalSystem.hpp"
+#include "Tablebase.hpp"
+#include "Zobrist.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
 #include <stdexcept>
 #include <iostream>
 
+namespace {
+
+constexpr int kDirX[8] = {0, 0, 1, -1, 1, 1, -1, -1};
+constexpr int kDirY[8] = {1, -1, 0, 0, 1, -1, 1, -1};
+constexpr int kKnightX[8] = {2, 2, -2, -2, 1, 1, -1, -1};
+constexpr int kKnightY[8] = {1, -1, 1, -1, 2, -2, 2, -2};
+
+} // namespace
+
 GameManager::GameManager(ChessBoard& board, MoveValidator& validator, PortalSystem& portal_system)
     : chess_board(board), validator(validator), portal_system(portal_system) {
 }
 
 bool GameManager::isInCheck(bool is_white_turn) const {
-    
     Position king_position;
-    bool king_found = false;
-
-    //şah kısmı
-    for (int y = 0; y < chess_board.getBoardSize() && !king_found; ++y) {
-        for (int x = 0; x < chess_board.getBoardSize() && !king_found; ++x) {
-            const auto& square = chess_board.getSquare({x, y});
-            if (validator.toLowerCase(square.piece) == "king" && square.is_white == is_white_turn) {
-                king_position = {x, y};
-                king_found = true;
-            }
-        }
+    if (!chess_board.findRoyal(is_white_turn, king_position)) {
+        return false;
     }
+    return isSquareAttacked(king_position, !is_white_turn);
+}
 
-    if (!king_found) {
+bool GameManager::isSquareAttacked(const Position& square, bool by_white) const {
+    const ChessBoard& board = chess_board;
+    if (!board.isInBounds(square)) {
         return false;
     }
+    const PortalRules& rules = *portal_system.getRules();
+
+    // Şah çeken tipler; kral ve özel taşlar sayılmaz
+    auto attackerAt = [&](const Position& p) {
+        const auto& piece_square = board.getSquare(p);
+        if (piece_square.is_empty() || piece_square.is_white != by_white) {
+            return PieceKind::Other;
+        }
+        PieceKind kind = board.kindAt(p);
+        return kind == PieceKind::King ? PieceKind::Other : kind;
+    };
+
+    // Bulunan yol isValidMove'un sırasıyla süzülür: rok hedefi alınamaz, terfi
+    // sırasına giden terfi yetenekli taş yalnızca kenarlarını kullanır, girişteki
+    // taşın çıkışa hamlesinde yalnızca portalın açık olması belirleyicidir
+    enum class Route { Edge, Passage, Portal };
+    auto attacks = [&](const Position& from, Route route) {
+        abilities::Mask mask = board.abilitiesAt(from);
+        if (abilities::has(mask, abilities::Royal) && abilities::has(mask, abilities::Castling) &&
+            std::abs(square.x - from.x) == 2 && square.y == from.y) {
+            return false;
+        }
+        if (abilities::has(mask, abilities::Promotion) && square.y == (by_white ? 7 : 0)) {
+            return route == Route::Edge;
+        }
+        int portal = rules.find(from, square);
+        if (portal >= 0) {
+            return portal_system.cooldownOf(portal) == 0 && rules.allows(portal, by_white);
+        }
+        return route != Route::Portal;
+    };
 
-    // Tehdit 
-    const std::vector<std::string> threatening_pieces = {"queen", "rook", "bishop", "knight", "pawn"};
-    
-    for (int y = 0; y < chess_board.getBoardSize(); ++y) {
-        for (int x = 0; x < chess_board.getBoardSize(); ++x) {
-            const auto& square = chess_board.getSquare({x, y});
-            // Sadece rakip taşları kontrol edicek
-            if (!square.is_empty() && square.is_white != is_white_turn) {
-                std::string piece_lower = validator.toLowerCase(square.piece);
-                // Sadece tehditler
-                if (std::find(threatening_pieces.begin(), threatening_pieces.end(), piece_lower) != threatening_pieces.end()) {
-                    Position start = {x, y};
-                    // Taşın şahı tehdit ediyor mu
-                    if (validator.isValidMove(square.piece, start, king_position, !is_white_turn, 
-                                           chess_board, portal_system)) {
-                        return true;
-                    }
-                }
-            }
+    for (int i = 0; i < 8; ++i) {
+        Position p{square.x - kKnightX[i], square.y - kKnightY[i]};
+        if (board.isInBounds(p) && attackerAt(p) == PieceKind::Knight && attacks(p, Route::Edge)) {
+            return true;
+        }
+    }
+    int forward = by_white ? 1 : -1;
+    for (int dx : {-1, 1}) {
+        Position p{square.x + dx, square.y - forward};
+        if (board.isInBounds(p) && attackerAt(p) == PieceKind::Pawn && attacks(p, Route::Edge)) {
+            return true;
+        }
+    }
+    auto slides = [](PieceKind kind, bool diagonal) {
+        return kind == PieceKind::Queen || kind == (diagonal ? PieceKind::Bishop : PieceKind::Rook);
+    };
+    for (int dir = 0; dir < 8; ++dir) {
+        Position p{square.x + kDirX[dir], square.y + kDirY[dir]};
+        while (board.isInBounds(p) && board.getSquare(p).is_empty()) {
+            p = {p.x + kDirX[dir], p.y + kDirY[dir]};
+        }
+        if (board.isInBounds(p) && slides(attackerAt(p), dir >= 4) && attacks(p, Route::Edge)) {
+            return true;
+        }
+    }
+
+    // Girişteki taş çıkışa sıçrar
+    for (const auto& portal : rules.portals) {
+        const Position& entry = portal.positions.entry;
+        if (portal.positions.exit.x == square.x && portal.positions.exit.y == square.y &&
+            board.isInBounds(entry) && attackerAt(entry) != PieceKind::Other &&
+            attacks(entry, Route::Portal)) {
+            return true;
         }
     }
 
+    // Açık geçiş: çıkıştan kareye boş bir hat varsa ışın girişten geriye yürünür
+    if (!portal_system.hasOpenPassage(by_white)) {
+        return false;
+    }
+    for (const auto& entry : portal_system.getPassageEntries()) {
+        int portal = portal_system.passageAt(entry, by_white);
+        if (portal < 0 || !board.isInBounds(entry) || !board.getSquare(entry).is_empty() ||
+            (entry.x == square.x && entry.y == square.y)) {
+            continue;
+        }
+        const Position& exit = rules.portals[portal].positions.exit;
+        int dx = square.x - exit.x, dy = square.y - exit.y;
+        if ((dx == 0 && dy == 0) || (dx != 0 && dy != 0 && std::abs(dx) != std::abs(dy)) ||
+            !board.isInBounds(exit) || !board.getSquare(exit).is_empty()) {
+            continue;
+        }
+        int step_x = (dx > 0) - (dx < 0), step_y = (dy > 0) - (dy < 0);
+        Position p{exit.x + step_x, exit.y + step_y};
+        while ((p.x != square.x || p.y != square.y) && board.getSquare(p).is_empty()) {
+            p = {p.x + step_x, p.y + step_y};
+        }
+        if (p.x != square.x || p.y != square.y) {
+            continue;
+        }
+        // Hedef kare dolu sayılır: geriye yürüyen ışını keser
+        p = {entry.x - step_x, entry.y - step_y};
+        while (board.isInBounds(p) && (p.x != square.x || p.y != square.y) &&
+               board.getSquare(p).is_empty()) {
+            p = {p.x - step_x, p.y - step_y};
+        }
+        if (board.isInBounds(p) && (p.x != square.x || p.y != square.y) &&
+            slides(attackerAt(p), step_x != 0 && step_y != 0) && attacks(p, Route::Passage)) {
+            return true;
+        }
+    }
     return false;
 }
 
 bool GameManager::isCheckmate(bool is_white_turn) {
-    // Önce şah mı
-    if (!isInCheck(is_white_turn)) {
-        return false;
-    }
+    return evaluateStatus(is_white_turn).outcome == GameStatus::Outcome::Checkmate;
+}
 
-    // Tüm taşları ve olası hamleleri 
-    for (int y = 0; y < chess_board.getBoardSize(); ++y) {
-        for (int x = 0; x < chess_board.getBoardSize(); ++x) {
-            const auto& square = chess_board.getSquare({x, y});
-            if (!square.is_empty() && square.is_white == is_white_turn) {
-                Position start = {x, y};
-                
-                // Tüm olası hedef kareleri 
-                for (int dy = 0; dy < chess_board.getBoardSize(); ++dy) {
-                    for (int dx = 0; dx < chess_board.getBoardSize(); ++dx) {
-                        Position end = {dx, dy};
-                        if (start.x == end.x && start.y == end.y) continue;
-                        
-                        // Hamle geçerli mi 
-                        if (validator.isValidMove(square.piece, start, end, is_white_turn,
-                                               chess_board, portal_system)) {
-                            // Geçici tahta oluştur 
-                            ChessBoard temp_board = chess_board;
-                            try {
-                                // Hamleyi yap
-                                auto captured_piece = temp_board.getSquare(end);
-                                temp_board.placePiece(square.piece, square.is_white, end.x, end.y);
-                                temp_board.placePiece("", false, start.x, start.y);
-                                
-                                // Yeni durumda şah devam ediyor mu kontrol et
-                                GameManager temp_manager(temp_board, validator, portal_system);
-                                if (!temp_manager.isInCheck(is_white_turn)) {
-                                    return false; // Kurtarıcı hamle var
-                                }
-                            } catch (const std::exception& e) {
-                                continue;
-                            }
-                        }
-                    }
-                }
-            }
-        }
-    }
-
-    return true; // kurtarıcı yok
+bool GameManager::isStalemate(bool is_white_turn) {
+    return evaluateStatus(is_white_turn).outcome == GameStatus::Outcome::Stalemate;
 }
 
-bool GameManager::isStalemate(bool is_white_turn) const {
-    if (isInCheck(is_white_turn)) {
-        return false;
+const GameManager::GameStatus& GameManager::evaluateStatus(bool is_white_turn, bool count_moves) {
+    uint64_t key = zobrist::positionKey(chess_board.getHash(), portal_system.stateHash(),
+                                        is_white_turn);
+    size_t history = move_history.size();
+    if (status_valid && status_key == key && status_history == history &&
+        (status.counted || !count_moves)) {
+        return status;
     }
 
-    for (int y = 0; y < chess_board.getBoardSize(); ++y) {
-        for (int x = 0; x < chess_board.getBoardSize(); ++x) {
-            const auto& square = chess_board.getSquare({x, y});
-            if (!square.is_empty() && square.is_white == is_white_turn) {
-                Position start = {x, y};
-                for (int dy = -chess_board.getBoardSize(); dy <= chess_board.getBoardSize(); ++dy) {
-                    for (int dx = -chess_board.getBoardSize(); dx <= chess_board.getBoardSize(); ++dx) {
-                        if (dx == 0 && dy == 0) continue;
-                        Position end = {x + dx, y + dy};
-                        if (chess_board.isInBounds(end) && 
-                            validator.isValidMove(square.piece, start, end, is_white_turn, 
-                                                 chess_board, portal_system)) {
-                            return false;
-                        }
-                    }
-                }
-            }
-        }
+    // Geri alınan hamlelerin pozisyonları sayılmaz
+    while (!seen_positions.empty() && seen_positions.back().first > history) {
+        seen_positions.pop_back();
     }
+    if (seen_positions.empty() || seen_positions.back().first != history) {
+        seen_positions.push_back({history, key});
+    }
+
+    MoveGenerator generator(validator);
+    MoveGenerator::CheckInfo info = generator.analyzeChecks(chess_board, portal_system, is_white_turn);
+    status = GameStatus();
+    status.in_check = info.inCheck();
+    status.counted = count_moves;
+    status.legal_moves = generator.countLegalMoves(chess_board, portal_system, is_white_turn, info,
+                                                   count_moves ? std::numeric_limits<int>::max() : 1);
 
-    return true;
+    long repeats = std::count_if(seen_positions.begin(), seen_positions.end(),
+                                 [key](const auto& seen) { return seen.second == key; });
+    if (status.legal_moves == 0) {
+        status.outcome = status.in_check ? GameStatus::Outcome::Checkmate
+                                         : GameStatus::Outcome::Stalemate;
+    } else if (repeats >= 3) {
+        status.outcome = GameStatus::Outcome::Repetition;
+    } else if (turn_limit > 0 && played_moves / 2 >= turn_limit) {
+        status.outcome = GameStatus::Outcome::TurnLimit;
+    }
+
+    status_key = key;
+    status_history = history;
+    status_valid = true;
+    return status;
+}
+
+void GameManager::setTablebase(const Tablebase* tb) {
+    tablebase = tb;
+}
+
+bool GameManager::probeTablebase(bool is_white_turn, TablebaseResult& result) const {
+    if (tablebase == nullptr) {
+        return false;
+    }
+    return tablebase->probe(chess_board, portal_system, is_white_turn, result);
 }
 
 void GameManager::addToMoveHistory(const Move& move) {
     move_history.push(move);
+    if (!move.portal_teleport) ++played_moves;
+}
+
+std::vector<GameManager::Move> GameManager::getMoveHistory() const {
+    std::stack<Move> copy = move_history;
+    std::vector<Move> moves(copy.size());
+    for (size_t i = moves.size(); i > 0; --i) {
+        moves[i - 1] = copy.top();
+        copy.pop();
+    }
+    return moves;
+}
+
+void GameManager::clearHistory() {
+    move_history = std::stack<Move>();
+    played_moves = 0;
+    seen_positions.clear();
+    status_valid = false;
 }
 
 void GameManager::undoMove() {
@@ -142,6 +235,7 @@ void GameManager::undoMove() {
 
     Move last_move = move_history.top();
     move_history.pop();
+    if (!last_move.portal_teleport) --played_moves;
 
     try {
         // Önce taşı geri alacak.
@@ -165,6 +259,7 @@ void GameManager::undoMove() {
     } catch (const std::exception& e) {
         // Hata durumunda hamleyi geri alıcak ve hatayı bildiricek
         move_history.push(last_move);
+        if (!last_move.portal_teleport) ++played_moves;
         std::cerr << "Error undoing move: " << e.what() << std::endl;
     }
 }
\ No newline at end of file
@@ -0,0 +1,257 @@
+// GameSnapshot.cpp
+#include "GameSnapshot.hpp"
+#include "BoardKernels.hpp"
+#include "MoveValidator.hpp"
+#include "Zobrist.hpp"
+#include <algorithm>
+#include <cstdlib>
+
+GameSnapshot::GameSnapshot(const ChessBoard& board, const PortalSystem& portal_system,
+                           bool is_white, const std::vector<GameManager::Move>& history)
+    : context(std::make_shared<const Context>(Context{
+          board.getBoardSize(), board.getEvaluationTables(), board.getNetwork(),
+          portal_system.getRules()})),
+      types(board.getTypes()),
+      cooldowns(std::make_shared<const std::vector<int>>(portal_system.getCooldownState())),
+      board_hash(board.getHash()), portal_hash(portal_system.stateHash()), is_white(is_white) {
+  int size = board.getBoardSize();
+  std::vector<Cell> cells = cellsOf(board);
+  auto all = std::make_shared<Rows>(size);
+  for (int y = 0; y < size; ++y) {
+    (*all)[y] = std::make_shared<const Row>(cells.begin() + y * size,
+                                            cells.begin() + (y + 1) * size);
+  }
+  rows = std::move(all);
+  for (const auto& move : history) {
+    pushHistory(move);
+  }
+}
+
+std::vector<GameSnapshot::Cell> GameSnapshot::cellsOf(const ChessBoard& board) {
+  std::vector<Cell> cells(static_cast<size_t>(board.getBoardSize()) * board.getBoardSize());
+  for (bool white : {false, true}) {
+    const auto& pieces = board.getPieces(white);
+    for (size_t i = 0; i < pieces.size(); ++i) {
+      cells[pieces.squares[i]] = Cell{static_cast<int16_t>(pieces.types[i]), white};
+    }
+  }
+  return cells;
+}
+
+void GameSnapshot::pushHistory(const GameManager::Move& move) {
+  size_t length = historyLength() + 1;
+  history_head = std::make_shared<const HistoryNode>(HistoryNode{move, history_head, length});
+}
+
+Expected<GameSnapshot, MoveError> GameSnapshot::play(const CoordinateMove& move,
+                                                     MoveValidator& validator) const {
+  int size = context->board_size;
+  for (const Position& pos : {move.from, move.to}) {
+    if (pos.x < 0 || pos.x >= size || pos.y < 0 || pos.y >= size) {
+      return unexpected(MoveError::OutOfBounds);
+    }
+  }
+  const Cell& moving = at(move.from);
+  if (moving.type < 0) {
+    return unexpected(MoveError::EmptySquare);
+  }
+  if (moving.is_white != is_white) {
+    return unexpected(MoveError::WrongPiece);
+  }
+
+  GameSnapshot next = *this;
+  if (playDirect(move, next)) {
+    return next;
+  }
+
+  ChessBoard current = board();
+  current.setVerbose(false);
+  PortalSystem current_portals = portals();
+  current_portals.setVerbose(false);
+  GameManager scratch(current, validator, current_portals);
+  std::string promotion = promotionPieceName(move.promotion);
+  auto played = current.tryMovePiece(move.from, move.to, validator, current_portals, scratch,
+                                     promotion.empty() ? "Queen" : promotion);
+  if (!played) {
+    return unexpected(played.error());
+  }
+
+  // Yol kopyalama: değişmeyen satırlar paylaşılır, satır dizisi bir kez kopyalanır
+  std::vector<Cell> cells = cellsOf(current);
+  std::shared_ptr<Rows> changed;
+  for (int y = 0; y < size; ++y) {
+    auto begin = cells.begin() + y * size;
+    const Row& old = *(*rows)[y];
+    if (std::equal(old.begin(), old.end(), begin)) continue;
+    if (!changed) changed = std::make_shared<Rows>(*rows);
+    (*changed)[y] = std::make_shared<const Row>(begin, begin + size);
+  }
+  if (changed) next.rows = std::move(changed);
+  if (current.getTypes() != types) next.types = current.getTypes();
+  std::vector<int> state = current_portals.getCooldownState();
+  if (state != *cooldowns) {
+    next.cooldowns = std::make_shared<const std::vector<int>>(std::move(state));
+  }
+  // Portal ışınlaması geçmişe ayrı kayıt olarak girer
+  for (const auto& recorded : scratch.getMoveHistory()) {
+    next.pushHistory(recorded);
+  }
+  next.board_hash = current.getHash();
+  next.portal_hash = current_portals.stateHash();
+  next.is_white = !is_white;
+  return next;
+}
+
+bool GameSnapshot::playDirect(const CoordinateMove& move, GameSnapshot& next) const {
+  const Position& from = move.from;
+  const Position& to = move.to;
+  const Cell moving = at(from);
+  const Cell captured = at(to);
+  if (captured.type >= 0 && captured.is_white == moving.is_white) {
+    return false;
+  }
+  const abilities::Mask mask = types->abilities[moving.type];
+  const PieceKind kind = types->kinds[moving.type];
+  const PortalRules& rules = *context->portal_rules;
+  int dx = to.x - from.x, dy = to.y - from.y;
+
+  // isValidMove'un önce baktığı özel hamleler (rok, en passant, portal) ve
+  // hedefi portal girişi olan hamleler (ışınlama) tahtada oynanır
+  if ((abilities::has(mask, abilities::Royal) && abilities::has(mask, abilities::Castling) &&
+       std::abs(dx) == 2 && dy == 0) ||
+      (abilities::has(mask, abilities::EnPassant) && std::abs(dx) == 1 && captured.type < 0) ||
+      rules.find(from, to) >= 0 || rules.firstAt(to) >= 0) {
+    return false;
+  }
+
+  // getMoveEdges kuralları; kenarda olmayan hedef (portal geçişi olabilir) tahtaya kalır
+  bool reaches = false;
+  int forward = moving.is_white ? 1 : -1;
+  switch (kind) {
+  case PieceKind::Pawn:
+    if (dx == 0 && dy == forward) {
+      reaches = captured.type < 0;
+    } else if (dx == 0 && dy == 2 * forward && from.y == (moving.is_white ? 1 : 6)) {
+      reaches = captured.type < 0 && at({from.x, from.y + forward}).type < 0;
+    } else {
+      reaches = std::abs(dx) == 1 && dy == forward && captured.type >= 0;
+    }
+    break;
+  case PieceKind::Knight:
+    reaches = std::abs(dx * dy) == 2;
+    break;
+  case PieceKind::King:
+    reaches = std::max(std::abs(dx), std::abs(dy)) == 1;
+    break;
+  case PieceKind::Bishop:
+  case PieceKind::Rook:
+  case PieceKind::Queen: {
+    bool straight = dx == 0 || dy == 0;
+    bool diagonal = std::abs(dx) == std::abs(dy);
+    if ((dx == 0 && dy == 0) || !(straight || diagonal) ||
+        (kind == PieceKind::Bishop && straight) || (kind == PieceKind::Rook && !straight)) {
+      break;
+    }
+    int step_x = (dx > 0) - (dx < 0), step_y = (dy > 0) - (dy < 0);
+    Position p{from.x + step_x, from.y + step_y};
+    while ((p.x != to.x || p.y != to.y) && at(p).type < 0) {
+      p = {p.x + step_x, p.y + step_y};
+    }
+    reaches = p.x == to.x && p.y == to.y;
+    break;
+  }
+  case PieceKind::Other:
+    break;
+  }
+  if (!reaches) {
+    return false;
+  }
+
+  Cell landed = moving;
+  if (abilities::has(mask, abilities::Promotion) && to.y == (moving.is_white ? 7 : 0)) {
+    std::string promotion = promotionPieceName(move.promotion);
+    int promoted = types->find(promotion.empty() ? "Queen" : promotion);
+    if (promoted < 0) {
+      return false;  // tip tablosu büyüyecek
+    }
+    landed.type = static_cast<int16_t>(promoted);
+  }
+
+  // Yalnızca başlangıç ve hedef satırları kopyalanır
+  int size = context->board_size;
+  auto from_row = std::make_shared<Row>(*(*rows)[from.y]);
+  auto to_row = from.y == to.y ? from_row : std::make_shared<Row>(*(*rows)[to.y]);
+  (*from_row)[from.x] = Cell{};
+  (*to_row)[to.x] = landed;
+  auto changed = std::make_shared<Rows>(*rows);
+  (*changed)[from.y] = std::move(from_row);
+  (*changed)[to.y] = std::move(to_row);
+  next.rows = std::move(changed);
+
+  auto keyOf = [&](const Cell& cell, const Position& pos) {
+    return cell.type < 0 ? 0
+                         : zobrist::pieceKey(types->names[cell.type], cell.is_white,
+                                             pos.y * size + pos.x);
+  };
+  next.board_hash ^= keyOf(moving, from) ^ keyOf(captured, to) ^ keyOf(landed, to);
+
+  const std::string& moved_name = types->names[moving.type];
+  next.pushHistory({from, to, moved_name, moving.is_white,
+                    captured.type < 0 ? "" : types->names[captured.type], captured.is_white,
+                    landed.type != moving.type ? types->names[landed.type] : ""});
+  // tryMovePiece gibi hamle sonunda cooldown'lar bir tur azalır
+  if (std::any_of(cooldowns->begin(), cooldowns->end(), [](int turns) { return turns > 0; })) {
+    PortalSystem ticked = portals();
+    ticked.setVerbose(false);
+    ticked.updateCooldowns();
+    next.cooldowns = std::make_shared<const std::vector<int>>(ticked.getCooldownState());
+    next.portal_hash = ticked.stateHash();
+  }
+  next.is_white = !is_white;
+  return true;
+}
+
+ChessBoard GameSnapshot::board(const std::string& display_format) const {
+  int size = context->board_size;
+  ChessBoard result(size, types, display_format);
+  for (int y = 0; y < size; ++y) {
+    const Row& row = *(*rows)[y];
+    for (int x = 0; x < size; ++x) {
+      if (row[x].type >= 0) {
+        result.placePiece(types->names[row[x].type], row[x].is_white, x, y);
+      }
+    }
+  }
+  // Yerleştirme bitince: skor bir kez baştan hesaplanır
+  result.attachEvaluation(context->evaluation);
+  result.attachNetwork(context->network);
+  return result;
+}
+
+PortalSystem GameSnapshot::portals() const {
+  PortalSystem result(context->portal_rules);
+  result.setCooldownState(*cooldowns);
+  return result;
+}
+
+std::vector<GameManager::Move> GameSnapshot::history() const {
+  std::vector<GameManager::Move> moves(historyLength());
+  size_t i = moves.size();
+  for (const HistoryNode* node = history_head.get(); node; node = node->parent.get()) {
+    moves[--i] = node->move;
+  }
+  return moves;
+}
+
+uint64_t GameSnapshot::key() const {
+  return zobrist::positionKey(board_hash, portal_hash, is_white);
+}
+
+size_t GameSnapshot::sharedRows(const GameSnapshot& other) const {
+  if (rows == other.rows) return rows->size();
+  size_t shared = 0;
+  for (size_t y = 0; y < rows->size() && y < other.rows->size(); ++y) {
+    if ((*rows)[y] == (*other.rows)[y]) ++shared;
+  }
+  return shared;
+}
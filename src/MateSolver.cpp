@@ -0,0 +1,192 @@
+// MateSolver.cpp
+#include "MateSolver.hpp"
+#include "Zobrist.hpp"
+#include <algorithm>
+
+MateSolver::MateSolver(size_t hash_mb) : generator(validator) {
+  validator.setVerbose(false);
+  size_t count = 1;
+  while ((count * 2) * sizeof(Entry) <= (std::max<size_t>(hash_mb, 1) << 20)) count *= 2;
+  table.resize(count);
+  mask = count - 1;
+}
+
+void MateSolver::clear() {
+  std::fill(table.begin(), table.end(), Entry{});
+}
+
+uint64_t MateSolver::keyOf(const Node& node) {
+  return zobrist::positionKey(node.board.getHash(), node.portals.stateHash(), node.is_white) ^
+         zobrist::mix(static_cast<uint64_t>(node.plies));
+}
+
+bool MateSolver::probe(uint64_t key, uint32_t& phi, uint32_t& delta) {
+  const Entry& entry = table[key & mask];
+  if (entry.key != key) return false;
+  phi = entry.phi;
+  delta = entry.delta;
+  return true;
+}
+
+void MateSolver::store(uint64_t key, uint32_t phi, uint32_t delta) {
+  table[key & mask] = Entry{key, phi, delta};
+}
+
+bool MateSolver::checkLimits() {
+  if (aborted) return true;
+  if (limits.max_nodes > 0 && nodes >= limits.max_nodes) aborted = true;
+  if ((nodes & 1023) == 0 && (limits.stop.stop_requested() ||
+                              std::chrono::steady_clock::now() >= limits.deadline)) {
+    aborted = true;
+  }
+  return aborted;
+}
+
+std::vector<std::pair<CoordinateMove, MateSolver::Node>> MateSolver::children(
+    const Node& node) const {
+  std::vector<std::pair<CoordinateMove, Node>> result;
+  PortalSystem portals = node.portals;
+  bool attacker = node.plies % 2 == 1;
+  if (!attacker) {
+    for (const auto& move : generator.legalMoves(node.board, portals, node.is_white)) {
+      Node child{node.board, node.portals, !node.is_white, node.plies - 1};
+      generator.makeMove(child.board, child.portals, move);
+      result.emplace_back(move, std::move(child));
+    }
+    return result;
+  }
+  // Saldıran: yalnızca şah çekebilecek adaylar oynanır; hamle sonrası kendi şahı
+  // açıkta kalmamalı (yasallık) ve rakip şahta olmalı
+  for (const auto& move : generator.checkCandidates(node.board, portals, node.is_white)) {
+    Node child{node.board, node.portals, !node.is_white, node.plies - 1};
+    generator.makeMove(child.board, child.portals, move);
+    if (!generator.inCheck(child.board, child.portals, child.is_white) ||
+        generator.inCheck(child.board, child.portals, node.is_white)) {
+      continue;
+    }
+    result.emplace_back(move, std::move(child));
+  }
+  return result;
+}
+
+std::pair<uint32_t, uint32_t> MateSolver::mid(const Node& node, uint32_t threshold_phi,
+                                              uint32_t threshold_delta) {
+  ++nodes;
+  uint64_t key = keyOf(node);
+  uint32_t phi = 1, delta = 1;
+  if (probe(key, phi, delta)) {
+    ++hash_hits;
+    if (phi >= threshold_phi || delta >= threshold_delta) return {phi, delta};
+  }
+  if (checkLimits()) return {phi, delta};
+
+  // Uçlar: sıradaki taraf kaybettiyse (kInfinity, 0), kazandıysa (0, kInfinity)
+  bool attacker = node.plies % 2 == 1;
+  if (!attacker && node.plies == 0) {
+    PortalSystem portals = node.portals;
+    bool mated = !generator.hasLegalMove(node.board, portals, node.is_white) &&
+                 generator.inCheck(node.board, portals, node.is_white);
+    std::pair<uint32_t, uint32_t> result = mated ? std::make_pair(kInfinity, 0u)
+                                                 : std::make_pair(0u, kInfinity);
+    store(key, result.first, result.second);
+    return result;
+  }
+  auto kids = children(node);
+  if (kids.empty()) {
+    PortalSystem portals = node.portals;
+    // Saldıranın şah çeken hamlesi yok; savunanda mat veya pat
+    bool lost = attacker || generator.inCheck(node.board, portals, node.is_white);
+    std::pair<uint32_t, uint32_t> result = lost ? std::make_pair(kInfinity, 0u)
+                                                : std::make_pair(0u, kInfinity);
+    store(key, result.first, result.second);
+    return result;
+  }
+
+  std::vector<std::pair<uint32_t, uint32_t>> values(kids.size(), {1, 1});
+  for (size_t i = 0; i < kids.size(); ++i) {
+    probe(keyOf(kids[i].second), values[i].first, values[i].second);
+  }
+  while (true) {
+    size_t best = 0;
+    uint32_t min_delta = kInfinity, second_delta = kInfinity;
+    uint64_t sum_phi = 0;
+    for (size_t i = 0; i < values.size(); ++i) {
+      uint32_t child_delta = values[i].second;
+      if (child_delta < min_delta) {
+        second_delta = min_delta;
+        min_delta = child_delta;
+        best = i;
+      } else if (child_delta < second_delta) {
+        second_delta = child_delta;
+      }
+      sum_phi += values[i].first;
+    }
+    phi = min_delta;
+    delta = static_cast<uint32_t>(std::min<uint64_t>(sum_phi, kInfinity));
+    if (phi >= threshold_phi || delta >= threshold_delta || aborted) break;
+
+    // Çocuğun phi'si bizim delta toplamımıza, delta'sı phi minimumumuza girer
+    uint64_t child_phi = static_cast<uint64_t>(threshold_delta) - delta + values[best].first;
+    uint32_t child_threshold_phi = static_cast<uint32_t>(std::min<uint64_t>(child_phi, kInfinity));
+    uint32_t child_threshold_delta =
+        std::min(threshold_phi, second_delta == kInfinity ? kInfinity : second_delta + 1);
+    values[best] = mid(kids[best].second, child_threshold_phi, child_threshold_delta);
+  }
+  store(key, phi, delta);
+  return {phi, delta};
+}
+
+std::vector<CoordinateMove> MateSolver::principalLine(Node node) {
+  std::vector<CoordinateMove> line;
+  while (!aborted) {
+    bool attacker = node.plies % 2 == 1;
+    auto kids = children(node);
+    // Saldıran mat ettiren, savunan kanıtlanmış bir hamleyi seçer
+    const std::pair<CoordinateMove, Node>* chosen = nullptr;
+    for (const auto& kid : kids) {
+      auto [phi, delta] = mid(kid.second, kInfinity, kInfinity);
+      if ((attacker && delta == 0) || (!attacker && phi == 0)) {
+        chosen = &kid;
+        break;
+      }
+    }
+    if (!chosen) break;
+    line.push_back(chosen->first);
+    node = chosen->second;
+  }
+  return line;
+}
+
+MateSolver::Result MateSolver::solve(const ChessBoard& board, const PortalSystem& portal_system,
+                                     bool is_white, int max_moves, const Limits& limits) {
+  auto start = std::chrono::steady_clock::now();
+  this->limits = limits;
+  nodes = 0;
+  hash_hits = 0;
+  aborted = false;
+
+  Result result;
+  Node root{board, portal_system, is_white, 0};
+  root.board.setVerbose(false);
+  root.portals.setVerbose(false);
+  for (int moves = 1; moves <= max_moves; ++moves) {
+    root.plies = 2 * moves - 1;
+    auto [phi, delta] = mid(root, kInfinity, kInfinity);
+    if (aborted) {
+      result.outcome = Outcome::Unknown;
+      break;
+    }
+    result.moves = moves;
+    if (phi == 0) {
+      result.outcome = Outcome::Mate;
+      result.line = principalLine(root);
+      break;
+    }
+    result.outcome = Outcome::NoMate;
+  }
+  result.nodes = nodes;
+  result.hash_hits = hash_hits;
+  result.elapsed_ms = std::chrono::duration<double, std::milli>(
+                          std::chrono::steady_clock::now() - start).count();
+  return result;
+}
@@ -0,0 +1,404 @@
+// Mcts.cpp
+#include "Mcts.hpp"
+#include "MoveGenerator.hpp"
+#include "MoveValidator.hpp"
+#include "Zobrist.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr uint8_t kLeaf = 0;
+constexpr uint8_t kExpanding = 1;
+constexpr uint8_t kExpanded = 2;
+
+using Clock = std::chrono::steady_clock;
+
+uint64_t keyOf(const ChessBoard& board, const PortalSystem& portals, bool is_white) {
+  return zobrist::positionKey(board.getHash(), portals.stateHash(), is_white);
+}
+
+// Sonuç beyazın bakışıyla: +1 beyaz kazandı, -1 siyah kazandı, 0 berabere
+int winnerWhenStuck(bool side_to_move, bool in_check) {
+  if (!in_check) return 0;
+  return side_to_move ? -1 : 1;
+}
+
+} // namespace
+
+// Değerler düğüme gelen hamleyi yapan tarafın bakışıyla, yarım puan cinsinden
+// (kazanç 2, beraberlik 1). visits inmekte olan thread'lerin sanal kaybını içerir.
+struct Mcts::Node {
+  CoordinateMove move{{-1, -1}, {-1, -1}, 0};
+  Node* parent = nullptr;
+  Node* first_child = nullptr;
+  Node* next_sibling = nullptr;   // havuzda boş liste bağı olarak da kullanılır
+  std::atomic<uint32_t> visits{0};
+  std::atomic<uint64_t> value{0};
+  std::atomic<uint8_t> state{kLeaf};
+  bool terminal = false;          // state kExpanded olduktan sonra okunur
+  int8_t terminal_winner = 0;
+
+  void reset() {
+    move = CoordinateMove{{-1, -1}, {-1, -1}, 0};
+    parent = first_child = next_sibling = nullptr;
+    visits.store(0, std::memory_order_relaxed);
+    value.store(0, std::memory_order_relaxed);
+    state.store(kLeaf, std::memory_order_relaxed);
+    terminal = false;
+    terminal_winner = 0;
+  }
+};
+
+// Sabit boyutlu düğüm havuzu: bloklar bir kez ayrılır, bırakılan düğümler boş
+// listeye döner. Genişletme tüm çocukları tek kilitte alır; bırakma yalnızca
+// arama dışında (tek thread) yapılır.
+class Mcts::NodePool {
+public:
+  explicit NodePool(size_t capacity) : capacity(std::max<size_t>(capacity, 1)) {}
+
+  // count düğümlük kardeş zinciri; kapasite yetmezse nullptr
+  Node* allocateChain(size_t count) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (count == 0 || in_use.load(std::memory_order_relaxed) + count > capacity) {
+      return nullptr;
+    }
+    Node* head = nullptr;
+    for (size_t i = 0; i < count; ++i) {
+      Node* node = free_list;
+      if (node) {
+        free_list = node->next_sibling;
+      } else {
+        if (next_in_block == kBlockSize) {
+          blocks.push_back(std::make_unique<Node[]>(kBlockSize));
+          next_in_block = 0;
+        }
+        node = &blocks.back()[next_in_block++];
+      }
+      node->reset();
+      node->next_sibling = head;
+      head = node;
+    }
+    in_use.fetch_add(count, std::memory_order_relaxed);
+    return head;
+  }
+
+  void release(Node* node) {
+    node->next_sibling = free_list;
+    free_list = node;
+    in_use.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  size_t used() const { return in_use.load(std::memory_order_relaxed); }
+  bool full() const { return used() >= capacity; }
+
+private:
+  static constexpr size_t kBlockSize = 4096;
+  std::mutex mutex;
+  std::vector<std::unique_ptr<Node[]>> blocks;
+  size_t next_in_block = kBlockSize;
+  Node* free_list = nullptr;
+  size_t capacity;
+  std::atomic<size_t> in_use{0};
+};
+
+class Mcts::Worker {
+public:
+  Worker(Mcts& owner, uint64_t seed) : owner(owner), generator(validator), rng(seed) {
+    validator.setVerbose(false);
+  }
+
+  // Bir yineleme: seçim, genişletme, rastgele oyun, geri yayılım
+  void iterate() {
+    const Options& options = owner.options;
+    ChessBoard board = *owner.root_board;
+    PortalSystem portals = *owner.root_portals;
+    bool side = owner.root_white;
+    path.clear();
+    path.push_back(owner.root);
+
+    Node* node = owner.root;
+    int winner = 0;
+    bool decided = false;
+    while (true) {
+      uint8_t state = node->state.load(std::memory_order_acquire);
+      if (state == kLeaf) {
+        uint8_t expected = kLeaf;
+        if (owner.pool->full() ||
+            !node->state.compare_exchange_strong(expected, kExpanding,
+                                                 std::memory_order_acq_rel)) {
+          break;
+        }
+        if (!expand(node, board, portals, side)) break;
+      } else if (state == kExpanding) {
+        // Başka thread genişletiyor: buradan oynanır
+        break;
+      }
+      if (node->terminal) {
+        winner = node->terminal_winner;
+        decided = true;
+        break;
+      }
+      Node* child = selectChild(node, options.exploration);
+      uint32_t previous = child->visits.fetch_add(options.virtual_loss, std::memory_order_relaxed);
+      generator.makeMove(board, portals, child->move);
+      side = !side;
+      path.push_back(child);
+      node = child;
+      // Hiç ziyaret edilmemiş düğümde ağaçtan çıkılır; genişletme ikinci ziyarette
+      if (previous == 0) break;
+    }
+    if (!decided) {
+      int budget = owner.rollout_plies - static_cast<int>(path.size() - 1);
+      winner = rollout(board, portals, side, budget);
+    }
+    backpropagate(winner, options.virtual_loss);
+  }
+
+private:
+  Mcts& owner;
+  MoveValidator validator;
+  MoveGenerator generator;
+  std::mt19937_64 rng;
+  std::vector<Node*> path;
+  std::vector<size_t> captures;
+
+  // node kExpanding iken çağrılır; havuz yetmezse yaprağa döner
+  bool expand(Node* node, const ChessBoard& board, PortalSystem& portals, bool side) {
+    auto moves = generator.legalMoves(board, portals, side);
+    if (moves.empty()) {
+      node->terminal = true;
+      node->terminal_winner =
+          static_cast<int8_t>(winnerWhenStuck(side, generator.inCheck(board, portals, side)));
+      node->state.store(kExpanded, std::memory_order_release);
+      return true;
+    }
+    Node* chain = owner.pool->allocateChain(moves.size());
+    if (!chain) {
+      node->state.store(kLeaf, std::memory_order_release);
+      return false;
+    }
+    // Ziyaret edilmemiş çocuklar sırayla denendiği için sıra karıştırılır
+    std::shuffle(moves.begin(), moves.end(), rng);
+    Node* child = chain;
+    for (const auto& move : moves) {
+      child->move = move;
+      child->parent = node;
+      child = child->next_sibling;
+    }
+    node->first_child = chain;
+    node->state.store(kExpanded, std::memory_order_release);
+    return true;
+  }
+
+  static Node* selectChild(Node* node, double exploration) {
+    double log_parent =
+        std::log(static_cast<double>(std::max(node->visits.load(std::memory_order_relaxed), 1u)));
+    Node* best = nullptr;
+    double best_score = -std::numeric_limits<double>::infinity();
+    for (Node* child = node->first_child; child; child = child->next_sibling) {
+      uint32_t visits = child->visits.load(std::memory_order_relaxed);
+      if (visits == 0) return child;
+      double mean = child->value.load(std::memory_order_relaxed) / (2.0 * visits);
+      double score = mean + exploration * std::sqrt(log_parent / visits);
+      if (score > best_score) {
+        best_score = score;
+        best = child;
+      }
+    }
+    return best;
+  }
+
+  int rollout(ChessBoard& board, PortalSystem& portals, bool side, int budget) {
+    for (int ply = 0; ply < budget; ++ply) {
+      auto moves = generator.legalMoves(board, portals, side);
+      if (moves.empty()) {
+        return winnerWhenStuck(side, generator.inCheck(board, portals, side));
+      }
+      size_t pick = rng() % moves.size();
+      if (owner.options.light_policy && (rng() & 1)) {
+        captures.clear();
+        for (size_t i = 0; i < moves.size(); ++i) {
+          if (!board.getSquare(moves[i].to).is_empty()) captures.push_back(i);
+        }
+        if (!captures.empty()) pick = captures[rng() % captures.size()];
+      }
+      generator.makeMove(board, portals, moves[pick]);
+      side = !side;
+    }
+    return 0;
+  }
+
+  void backpropagate(int winner, int virtual_loss) {
+    bool mover_white = owner.root_white;
+    path[0]->visits.fetch_add(1, std::memory_order_relaxed);
+    for (size_t i = 1; i < path.size(); ++i) {
+      Node* node = path[i];
+      uint64_t score = winner == 0 ? 1 : ((winner > 0) == mover_white ? 2 : 0);
+      node->value.fetch_add(score, std::memory_order_relaxed);
+      node->visits.fetch_add(1, std::memory_order_relaxed);
+      node->visits.fetch_sub(virtual_loss, std::memory_order_relaxed);
+      mover_white = !mover_white;
+    }
+  }
+};
+
+Mcts::Mcts(const Options& options)
+    : options(options), pool(std::make_unique<NodePool>(options.max_nodes)) {
+  this->options.virtual_loss = std::max(this->options.virtual_loss, 0);
+}
+
+Mcts::~Mcts() = default;
+
+void Mcts::clear() {
+  if (root) releaseExcept(root, nullptr);
+  root = nullptr;
+  root_board.reset();
+  root_portals.reset();
+}
+
+void Mcts::releaseExcept(Node* node, Node* keep) {
+  std::vector<Node*> stack{node};
+  while (!stack.empty()) {
+    Node* current = stack.back();
+    stack.pop_back();
+    if (current == keep) continue;
+    if (current->state.load(std::memory_order_relaxed) == kExpanded) {
+      for (Node* child = current->first_child; child; child = child->next_sibling) {
+        stack.push_back(child);
+      }
+    }
+    pool->release(current);
+  }
+}
+
+size_t Mcts::reuse(const ChessBoard& board, const PortalSystem& portal_system, bool is_white) {
+  if (!root) return 0;
+  uint64_t target = keyOf(board, portal_system, is_white);
+  Node* found = nullptr;
+  if (root_white == is_white && keyOf(*root_board, *root_portals, root_white) == target) {
+    found = root;
+  } else if (root->state.load() == kExpanded) {
+    // Kendi hamlemiz ve rakibin cevabı: çocuklar ve torunlar
+    MoveValidator validator;
+    validator.setVerbose(false);
+    MoveGenerator generator(validator);
+    for (Node* child = root->first_child; child && !found; child = child->next_sibling) {
+      ChessBoard next = *root_board;
+      PortalSystem next_portals = *root_portals;
+      generator.makeMove(next, next_portals, child->move);
+      if (!root_white == is_white) {
+        if (keyOf(next, next_portals, is_white) == target) found = child;
+        continue;
+      }
+      if (child->state.load() != kExpanded) continue;
+      for (Node* grandchild = child->first_child; grandchild && !found;
+           grandchild = grandchild->next_sibling) {
+        ChessBoard after = next;
+        PortalSystem after_portals = next_portals;
+        generator.makeMove(after, after_portals, grandchild->move);
+        if (keyOf(after, after_portals, is_white) == target) found = grandchild;
+      }
+    }
+  }
+  if (!found) {
+    clear();
+    return 0;
+  }
+  if (found != root) {
+    releaseExcept(root, found);
+    found->parent = nullptr;
+    root = found;
+  }
+  return pool->used();
+}
+
+Mcts::Result Mcts::summarize(uint64_t rollouts, size_t reused, double elapsed_ms) const {
+  Result result;
+  result.rollouts = rollouts;
+  result.reused_nodes = reused;
+  result.tree_nodes = pool->used();
+  result.elapsed_ms = elapsed_ms;
+  if (!root || root->state.load(std::memory_order_acquire) != kExpanded || root->terminal) {
+    return result;
+  }
+  for (Node* child = root->first_child; child; child = child->next_sibling) {
+    uint32_t visits = child->visits.load(std::memory_order_relaxed);
+    if (!result.has_move || visits > result.best_visits) {
+      result.has_move = true;
+      result.best_move = child->move;
+      result.best_visits = visits;
+      result.win_rate =
+          visits ? child->value.load(std::memory_order_relaxed) / (2.0 * visits) : 0.5;
+    }
+  }
+  return result;
+}
+
+Mcts::Result Mcts::search(const ChessBoard& board, const PortalSystem& portal_system,
+                          bool is_white, const Limits& limits,
+                          const std::function<void(const Result&)>& report,
+                          std::chrono::milliseconds report_interval) {
+  Clock::time_point start = Clock::now();
+  auto elapsed = [&start] {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+  };
+
+  rollout_plies = limits.rollout_plies >= 0 ? limits.rollout_plies : options.rollout_plies;
+  size_t reused = reuse(board, portal_system, is_white);
+  root_board = std::make_unique<ChessBoard>(board);
+  root_board->setVerbose(false);
+  root_portals = std::make_unique<PortalSystem>(portal_system);
+  root_portals->setVerbose(false);
+  root_white = is_white;
+  uint64_t seed = keyOf(board, portal_system, is_white);
+
+  // Kök aramadan önce genişletilir; havuz eski ağaçla doluysa ağaç atılır
+  for (int attempt = 0; attempt < 2; ++attempt) {
+    if (!root) root = pool->allocateChain(1);
+    if (root->state.load() == kExpanded) break;
+    Worker(*this, seed).iterate();
+    if (root->state.load() == kExpanded) break;
+    clear();
+    root_board = std::make_unique<ChessBoard>(board);
+    root_board->setVerbose(false);
+    root_portals = std::make_unique<PortalSystem>(portal_system);
+    root_portals->setVerbose(false);
+    reused = 0;
+  }
+  if (root->terminal) return summarize(0, reused, elapsed());
+
+  unsigned thread_count =
+      options.threads > 0 ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+  std::atomic<uint64_t> started{0};
+  std::atomic<bool> done{false};
+  {
+    std::vector<std::jthread> threads;
+    for (unsigned index = 0; index < thread_count; ++index) {
+      threads.emplace_back([&, index] {
+        Worker worker(*this, zobrist::mix(seed + index + 1));
+        Clock::time_point next_report = start + report_interval;
+        while (!done.load(std::memory_order_relaxed)) {
+          if (limits.stop.stop_requested() || Clock::now() >= limits.deadline) break;
+          if (started.fetch_add(1) >= limits.max_rollouts && limits.max_rollouts > 0) {
+            started.fetch_sub(1);
+            break;
+          }
+          worker.iterate();
+          if (index == 0 && report && Clock::now() >= next_report) {
+            report(summarize(started.load(), reused, elapsed()));
+            next_report += report_interval;
+          }
+        }
+        done = true;
+      });
+    }
+  }
+  return summarize(started.load(), reused, elapsed());
+}
@@ -0,0 +1,411 @@
+// MoveGenerator.cpp
+#include "MoveGenerator.hpp"
+#include "BoardKernels.hpp"
+#include "GameManager.hpp"
+#include <cstdlib>
+
+MoveGenerator::MoveGenerator(MoveValidator& validator) : validator(validator) {}
+
+bool MoveGenerator::isPromotion(const ChessBoard& board, const Position& from, const Position& to) {
+  const auto& square = board.getSquare(from);
+  if (!board.hasAbility(from, abilities::Promotion)) {
+    return false;
+  }
+  // ChessBoard::movePiece ile aynı terfi sırası
+  return (square.is_white && to.y == 7) || (!square.is_white && to.y == 0);
+}
+
+std::vector<CoordinateMove> MoveGenerator::pseudoLegalMoves(const ChessBoard& board,
+                                                            const PortalSystem& portal_system,
+                                                            bool is_white) const {
+  std::vector<CoordinateMove> moves;
+  const auto& pieces = board.getPieces(is_white);
+  for (size_t i = 0; i < pieces.size(); ++i) {
+    Position from = board.positionOf(pieces.squares[i]);
+    for (const auto& to : validator.generateTargets(board.typeName(pieces.types[i]), from,
+                                                    is_white, board, portal_system)) {
+      if (isPromotion(board, from, to)) {
+        for (char letter : {'q', 'r', 'b', 'n'}) {
+          moves.push_back({from, to, letter});
+        }
+      } else {
+        moves.push_back({from, to, 0});
+      }
+    }
+  }
+  return moves;
+}
+
+void MoveGenerator::makeMove(ChessBoard& board, PortalSystem& portal_system,
+                             const CoordinateMove& move) const {
+  GameManager scratch(board, validator, portal_system);
+  std::string promotion = promotionPieceName(move.promotion);
+  board.movePiece(move.from, move.to, validator, portal_system, scratch,
+                  promotion.empty() ? "Queen" : promotion);
+}
+
+Expected<void, MoveError> MoveGenerator::tryMakeMove(ChessBoard& board,
+                                                     PortalSystem& portal_system,
+                                                     const CoordinateMove& move) const {
+  GameManager scratch(board, validator, portal_system);
+  std::string promotion = promotionPieceName(move.promotion);
+  return board.tryMovePiece(move.from, move.to, validator, portal_system, scratch,
+                            promotion.empty() ? "Queen" : promotion);
+}
+
+bool MoveGenerator::inCheck(const ChessBoard& board, PortalSystem& portal_system,
+                            bool is_white) const {
+  GameManager manager(const_cast<ChessBoard&>(board), validator, portal_system);
+  return manager.isInCheck(is_white);
+}
+
+namespace {
+
+constexpr int kDirX[8] = {0, 0, 1, -1, 1, 1, -1, -1};
+constexpr int kDirY[8] = {1, -1, 0, 0, 1, -1, 1, -1};
+constexpr int kKnightX[8] = {2, 2, -2, -2, 1, 1, -1, -1};
+constexpr int kKnightY[8] = {1, -1, 1, -1, 2, -2, 2, -2};
+
+bool samePosition(const Position& a, const Position& b) { return a.x == b.x && a.y == b.y; }
+
+bool contains(const std::vector<Position>& list, const Position& pos) {
+  for (const auto& p : list) {
+    if (samePosition(p, pos)) return true;
+  }
+  return false;
+}
+
+// GameManager::isInCheck'in şah çeken saydığı türler
+bool isThreatening(PieceKind kind) {
+  return kind != PieceKind::King && kind != PieceKind::Other;
+}
+
+bool slides(PieceKind kind, bool diagonal) {
+  return kind == PieceKind::Queen || kind == (diagonal ? PieceKind::Bishop : PieceKind::Rook);
+}
+
+} // namespace
+
+MoveGenerator::CheckInfo MoveGenerator::analyzeChecks(const ChessBoard& board,
+                                                      const PortalSystem& portal_system,
+                                                      bool is_white) const {
+  CheckInfo info;
+  if (!board.findRoyal(is_white, info.king)) {
+    return info;
+  }
+  info.has_king = true;
+  const Position king = info.king;
+
+  auto addChecker = [&](const Position& from) {
+    const auto& square = board.getSquare(from);
+    if (square.is_empty() || square.is_white == is_white || contains(info.checkers, from)) {
+      return false;
+    }
+    if (!isThreatening(board.kindAt(from)) ||
+        !validator.isValidMove(square.piece, from, king, !is_white, board, portal_system)) {
+      return false;
+    }
+    info.checkers.push_back(from);
+    return true;
+  };
+
+  // Kayan taşlar: her yönde ilk taş rakipse şah çeker, kendimizse arkasına bakılır.
+  // Şah çekmeyen ilk rakip taşın arkasında rakip kayan taş varsa o taş açarak şah çeker
+  for (int dir = 0; dir < 8; ++dir) {
+    bool diagonal = dir >= 4;
+    std::vector<Position> between;
+    Position own{-1, -1};
+    Position screen{-1, -1};
+    for (Position p{king.x + kDirX[dir], king.y + kDirY[dir]}; board.isInBounds(p);
+         p = {p.x + kDirX[dir], p.y + kDirY[dir]}) {
+      const auto& square = board.getSquare(p);
+      if (square.is_empty()) {
+        if (own.x < 0 && screen.x < 0) between.push_back(p);
+        continue;
+      }
+      bool slider = slides(board.kindAt(p), diagonal);
+      if (square.is_white == is_white) {
+        if (own.x >= 0 || screen.x >= 0) break;
+        own = p;
+        continue;
+      }
+      if (screen.x >= 0) {
+        if (slider) info.discoverers.push_back(screen);
+      } else if (own.x < 0) {
+        if (addChecker(p)) {
+          if (slider) info.blocks.insert(info.blocks.end(), between.begin(), between.end());
+        } else {
+          screen = p;
+          continue;
+        }
+      } else if (slider) {
+        info.pinned.push_back(own);
+      }
+      break;
+    }
+  }
+
+  // Atlar ve piyonlar araya girilemeyen şah çeker
+  for (int i = 0; i < 8; ++i) {
+    Position p{king.x - kKnightX[i], king.y - kKnightY[i]};
+    if (board.isInBounds(p)) addChecker(p);
+  }
+  int enemy_forward = is_white ? -1 : 1;
+  for (int dx : {-1, 1}) {
+    Position p{king.x + dx, king.y - enemy_forward};
+    if (board.isInBounds(p)) addChecker(p);
+  }
+
+  // Portal: girişteki rakip taş çıkıştaki şahı alabilir (ışın portaldan geçmez,
+  // taşın kendisi sıçrar; araya girilemez)
+  for (const auto& portal : portal_system.getPortals()) {
+    if (!samePosition(portal.positions.exit, king)) continue;
+    const auto& square = board.getSquare(portal.positions.entry);
+    if (!square.is_empty() && square.is_white != is_white &&
+        isThreatening(board.kindAt(portal.positions.entry))) {
+      info.portal_threat = true;
+      addChecker(portal.positions.entry);
+    }
+  }
+  // Portaldan geçen ışınlar: şah açık bir geçişin çıkış hattındaysa ışın
+  // girişten geriye yürünür. Çıkış, giriş ve aradaki boş kareler araya girme karesidir
+  for (const auto& entry : portal_system.getPassageEntries()) {
+    int portal = portal_system.passageAt(entry, !is_white);
+    if (portal < 0 || !board.isInBounds(entry) || !board.getSquare(entry).is_empty()) continue;
+    const Position& exit = portal_system.getPortals()[portal].positions.exit;
+    int dx = king.x - exit.x, dy = king.y - exit.y;
+    if ((dx == 0 && dy == 0) || (dx != 0 && dy != 0 && std::abs(dx) != std::abs(dy))) continue;
+    int step_x = (dx > 0) - (dx < 0), step_y = (dy > 0) - (dy < 0);
+    bool diagonal = step_x != 0 && step_y != 0;
+    std::vector<Position> between;
+    bool open = board.isInBounds(exit) && board.getSquare(exit).is_empty();
+    for (Position p = exit; open && !samePosition(p, king); p = {p.x + step_x, p.y + step_y}) {
+      open = board.getSquare(p).is_empty();
+      between.push_back(p);
+    }
+    if (!open) continue;
+    for (Position p = entry; board.isInBounds(p); p = {p.x - step_x, p.y - step_y}) {
+      const auto& square = board.getSquare(p);
+      if (square.is_empty()) {
+        between.push_back(p);
+        continue;
+      }
+      // Taş başka bir yönden de şah çekiyor olabilir (ışını geçişe de uzanır);
+      // geçiş hattının kareleri yine de araya girme karesidir
+      if (slides(board.kindAt(p), diagonal) && (addChecker(p) || contains(info.checkers, p))) {
+        info.blocks.insert(info.blocks.end(), between.begin(), between.end());
+      }
+      break;
+    }
+  }
+  // Geçiş hattındaki açmazlar ve cooldown'u biten geçişler yukarıda görünmez:
+  // şah bir geçiş çıkışının hattındaysa kısayol kullanılmaz
+  if (portal_system.passageMayReach(king, !is_white)) {
+    info.portal_threat = true;
+  }
+  return info;
+}
+
+std::vector<CoordinateMove> MoveGenerator::evasionCandidates(const ChessBoard& board,
+                                                             const PortalSystem& portal_system,
+                                                             bool is_white,
+                                                             const CheckInfo& info) const {
+  std::vector<CoordinateMove> moves;
+  auto add = [&](const Position& from, const Position& to) {
+    if (isPromotion(board, from, to)) {
+      for (char letter : {'q', 'r', 'b', 'n'}) moves.push_back({from, to, letter});
+    } else {
+      moves.push_back({from, to, 0});
+    }
+  };
+
+  // Şah çekeni alan veya araya giren kareler; bir portal girişine inen taş
+  // çıkışa ışınlandığı için çıkışı bu kümede olan girişler de hedeftir
+  // Aynı kare birden fazla yoldan gelebilir; hamleler tekrarlanmasın diye tekilleştirilir.
+  // Çıkışı şahın karesi olan girişe inen taş şahın yerine ışınlanır (movePiece)
+  std::vector<Position> targets;
+  for (const auto* list : {&info.checkers, &info.blocks}) {
+    for (const auto& p : *list) {
+      if (!contains(targets, p)) targets.push_back(p);
+    }
+  }
+  for (const auto& portal : portal_system.getPortals()) {
+    const Position& exit = portal.positions.exit;
+    if ((contains(targets, exit) || samePosition(exit, info.king)) &&
+        !contains(targets, portal.positions.entry)) {
+      targets.push_back(portal.positions.entry);
+    }
+  }
+
+  const auto& pieces = board.getPieces(is_white);
+  for (size_t i = 0; i < pieces.size(); ++i) {
+    const std::string& piece = board.typeName(pieces.types[i]);
+    Position from = board.positionOf(pieces.squares[i]);
+    if (samePosition(from, info.king)) {
+      for (const auto& to : validator.generateTargets(piece, from, is_white, board, portal_system)) {
+        add(from, to);
+      }
+      continue;
+    }
+    // Portal girişindeki taşın çıkışa sıçraması da isValidMove ile kapsanır
+    for (const auto& to : targets) {
+      if (validator.isValidMove(piece, from, to, is_white, board, portal_system)) {
+        add(from, to);
+      }
+    }
+  }
+  return moves;
+}
+
+std::vector<CoordinateMove> MoveGenerator::checkCandidates(const ChessBoard& board,
+                                                           const PortalSystem& portal_system,
+                                                           bool is_white) const {
+  CheckInfo target = analyzeChecks(board, portal_system, !is_white);
+  if (!target.has_king) {
+    return {};
+  }
+  if (target.portal_threat) {
+    return pseudoLegalMoves(board, portal_system, is_white);
+  }
+  const Position king = target.king;
+
+  // Türe göre şah çekilen kareler; hatlar ilk taşta (alınabiliyorsa dahil) biter
+  std::vector<Position> knight_squares, pawn_squares, line_squares[2];
+  for (int i = 0; i < 8; ++i) {
+    Position p{king.x - kKnightX[i], king.y - kKnightY[i]};
+    if (board.isInBounds(p)) knight_squares.push_back(p);
+  }
+  int forward = is_white ? 1 : -1;
+  for (int dx : {-1, 1}) {
+    Position p{king.x + dx, king.y - forward};
+    if (board.isInBounds(p)) pawn_squares.push_back(p);
+  }
+  for (int dir = 0; dir < 8; ++dir) {
+    for (Position p{king.x + kDirX[dir], king.y + kDirY[dir]}; board.isInBounds(p);
+         p = {p.x + kDirX[dir], p.y + kDirY[dir]}) {
+      const auto& square = board.getSquare(p);
+      if (square.is_empty() || square.is_white != is_white) line_squares[dir >= 4].push_back(p);
+      if (!square.is_empty()) break;
+    }
+  }
+  // Girişe inen taş çıkışa ışınlanır; oradan çekilen şah hedefe bakılarak görünmez
+  std::vector<Position> entries;
+  for (const auto& portal : portal_system.getPortals()) {
+    if (!contains(entries, portal.positions.entry)) entries.push_back(portal.positions.entry);
+  }
+
+  std::vector<CoordinateMove> moves;
+  auto add = [&](const Position& from, const Position& to) {
+    if (isPromotion(board, from, to)) {
+      for (char letter : {'q', 'r', 'b', 'n'}) moves.push_back({from, to, letter});
+    } else {
+      moves.push_back({from, to, 0});
+    }
+  };
+  const auto& pieces = board.getPieces(is_white);
+  for (size_t i = 0; i < pieces.size(); ++i) {
+    const std::string& piece = board.typeName(pieces.types[i]);
+    Position from = board.positionOf(pieces.squares[i]);
+    PieceKind kind = board.kindAt(from);
+    abilities::Mask mask = board.abilitiesAt(from);
+    // Açarak şah, rok (kale de yer değiştirir), terfi ve en passant: tüm hedefler
+    bool every_target =
+        contains(target.discoverers, from) ||
+        (abilities::has(mask, abilities::Royal) && abilities::has(mask, abilities::Castling) &&
+         from.x == 4 && from.y == (is_white ? 0 : 7)) ||
+        (abilities::has(mask, abilities::Promotion) &&
+         (kind != PieceKind::Pawn || from.y == (is_white ? 6 : 1))) ||
+        (abilities::has(mask, abilities::EnPassant) && from.y == (is_white ? 4 : 3));
+    if (every_target) {
+      for (const auto& to : validator.generateTargets(piece, from, is_white, board, portal_system)) {
+        add(from, to);
+      }
+      continue;
+    }
+    std::vector<const std::vector<Position>*> lists;
+    if (kind == PieceKind::Knight) lists.push_back(&knight_squares);
+    if (kind == PieceKind::Pawn) lists.push_back(&pawn_squares);
+    if (slides(kind, false)) lists.push_back(&line_squares[0]);
+    if (slides(kind, true)) lists.push_back(&line_squares[1]);
+    lists.push_back(&entries);
+    for (size_t l = 0; l < lists.size(); ++l) {
+      for (const auto& to : *lists[l]) {
+        // Giriş aynı zamanda şah karesiyse iki kez eklenmesin
+        if (l + 1 < lists.size() && contains(entries, to)) continue;
+        if (validator.isValidMove(piece, from, to, is_white, board, portal_system)) {
+          add(from, to);
+        }
+      }
+    }
+  }
+  return moves;
+}
+
+bool MoveGenerator::isSafeWithoutCheck(const CheckInfo& info, const PortalSystem& portal_system,
+                                       const CoordinateMove& move) {
+  // Şah altında değilken açmazda olmayan, şah dışı bir taşın hamlesi şahı açamaz.
+  // Kalan riskler: şah hamleleri (rok dahil), açmazdaki taşlar, cooldown'u
+  // bitince şahı alabilecek portal tehdidi ve portal girişine inen taş (ışınlanınca
+  // hedef kare boşalır, alınan taşın kapattığı hat açılır)
+  if (!info.has_king || info.inCheck() || info.portal_threat ||
+      samePosition(move.from, info.king) || contains(info.pinned, move.from)) {
+    return false;
+  }
+  for (const auto& portal : portal_system.getPortals()) {
+    if (samePosition(portal.positions.entry, move.to)) return false;
+  }
+  return true;
+}
+
+bool MoveGenerator::leavesKingSafe(const ChessBoard& board, PortalSystem& portal_system,
+                                   bool is_white, const CoordinateMove& move,
+                                   const std::vector<int>& saved_cooldowns) const {
+  ChessBoard next = board;
+  next.setVerbose(false);
+  makeMove(next, portal_system, move);
+  bool safe = !inCheck(next, portal_system, is_white);
+  portal_system.setCooldownState(saved_cooldowns);
+  return safe;
+}
+
+template <typename Visit>
+void MoveGenerator::forEachLegal(const ChessBoard& board, PortalSystem& portal_system,
+                                 bool is_white, const CheckInfo& info, Visit&& visit) const {
+  const std::vector<int> saved_cooldowns = portal_system.getCooldownState();
+  std::vector<CoordinateMove> candidates =
+      info.inCheck() ? evasionCandidates(board, portal_system, is_white, info)
+                     : pseudoLegalMoves(board, portal_system, is_white);
+  for (const auto& move : candidates) {
+    if (isSafeWithoutCheck(info, portal_system, move) ||
+        leavesKingSafe(board, portal_system, is_white, move, saved_cooldowns)) {
+      if (!visit(move)) return;
+    }
+  }
+}
+
+std::vector<CoordinateMove> MoveGenerator::legalMoves(const ChessBoard& board,
+                                                      PortalSystem& portal_system,
+                                                      bool is_white) const {
+  std::vector<CoordinateMove> legal;
+  CheckInfo info = analyzeChecks(board, portal_system, is_white);
+  forEachLegal(board, portal_system, is_white, info, [&](const CoordinateMove& move) {
+    legal.push_back(move);
+    return true;
+  });
+  return legal;
+}
+
+bool MoveGenerator::hasLegalMove(const ChessBoard& board, PortalSystem& portal_system,
+                                 bool is_white) const {
+  return countLegalMoves(board, portal_system, is_white,
+                         analyzeChecks(board, portal_system, is_white), 1) > 0;
+}
+
+int MoveGenerator::countLegalMoves(const ChessBoard& board, PortalSystem& portal_system,
+                                   bool is_white, const CheckInfo& info, int limit) const {
+  int count = 0;
+  forEachLegal(board, portal_system, is_white, info, [&](const CoordinateMove&) {
+    return ++count < limit;
+  });
+  return count;
+}
@@ -0,0 +1,70 @@
+// MoveNotation.cpp
+#include "MoveNotation.hpp"
+#include <cctype>
+
+bool parseSquare(const std::string& text, size_t& offset, int board_size, Position& pos) {
+  if (offset >= text.size()) {
+    return false;
+  }
+  char file = static_cast<char>(std::tolower(static_cast<unsigned char>(text[offset])));
+  if (file < 'a' || file >= 'a' + board_size) {
+    return false;
+  }
+  size_t digits_start = ++offset;
+  int rank = 0;
+  while (offset < text.size() && std::isdigit(static_cast<unsigned char>(text[offset]))) {
+    rank = rank * 10 + (text[offset] - '0');
+    ++offset;
+  }
+  if (offset == digits_start || rank < 1 || rank > board_size) {
+    return false;
+  }
+  pos = {file - 'a', rank - 1};
+  return true;
+}
+
+bool parseCoordinateMove(const std::string& text, int board_size, CoordinateMove& move) {
+  size_t offset = 0;
+  if (!parseSquare(text, offset, board_size, move.from)) return false;
+  if (offset < text.size() && text[offset] == '-') ++offset;
+  if (!parseSquare(text, offset, board_size, move.to)) return false;
+  move.promotion = 0;
+  if (offset < text.size()) {
+    char letter = static_cast<char>(std::tolower(static_cast<unsigned char>(text[offset])));
+    if (promotionPieceName(letter).empty() || offset + 1 != text.size()) {
+      return false;
+    }
+    move.promotion = letter;
+  }
+  return true;
+}
+
+std::string squareToText(const Position& pos) {
+  return std::string(1, static_cast<char>('a' + pos.x)) + std::to_string(pos.y + 1);
+}
+
+std::string formatCoordinateMove(const CoordinateMove& move) {
+  std::string text = squareToText(move.from) + squareToText(move.to);
+  if (move.promotion != 0) {
+    text += move.promotion;
+  }
+  return text;
+}
+
+std::string promotionPieceName(char promotion) {
+  switch (promotion) {
+  case 'q': return "Queen";
+  case 'r': return "Rook";
+  case 'b': return "Bishop";
+  case 'n': return "Knight";
+  default: return "";
+  }
+}
+
+char promotionLetter(const std::string& piece) {
+  if (piece == "Queen") return 'q';
+  if (piece == "Rook") return 'r';
+  if (piece == "Bishop") return 'b';
+  if (piece == "Knight") return 'n';
+  return 0;
+}
@@ -0,0 +1,269 @@
+// MoveOrdering.cpp
+#include "MoveOrdering.hpp"
+#include "BoardKernels.hpp"
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+
+constexpr int kGoodCapture = 2000000;
+constexpr int kPromotion = 1800000;
+constexpr int kKiller = 1500000;
+constexpr int kBadCapture = -1000000;
+
+constexpr int kDirX[8] = {0, 0, 1, -1, 1, 1, -1, -1};
+constexpr int kDirY[8] = {1, -1, 0, 0, 1, -1, 1, -1};
+constexpr int kKnightX[8] = {2, 2, -2, -2, 1, 1, -1, -1};
+constexpr int kKnightY[8] = {1, -1, 1, -1, 2, -2, 2, -2};
+
+bool sameMove(const CoordinateMove& a, const CoordinateMove& b) {
+  return a.from.x == b.from.x && a.from.y == b.from.y && a.to.x == b.to.x &&
+         a.to.y == b.to.y && a.promotion == b.promotion;
+}
+
+} // namespace
+
+MoveOrdering::MoveOrdering(const Evaluation& evaluation)
+    : evaluation(evaluation), board_size(evaluation.getBoardSize()) {
+  size_t square_count = static_cast<size_t>(board_size) * board_size;
+  history.assign(static_cast<size_t>(evaluation.typeCount()) * 2 * square_count * square_count, 0);
+  clear();
+}
+
+void MoveOrdering::clear() {
+  std::fill(history.begin(), history.end(), 0);
+  for (auto& slots : killers) {
+    slots[0] = CoordinateMove{{-1, -1}, {-1, -1}, 0};
+    slots[1] = slots[0];
+  }
+}
+
+bool MoveOrdering::isCapture(const ChessBoard& board, const CoordinateMove& move) {
+  const auto& target = board.getSquare(move.to);
+  return !target.is_empty() && target.is_white != board.getSquare(move.from).is_white;
+}
+
+size_t MoveOrdering::historyIndex(const ChessBoard& board, const CoordinateMove& move) const {
+  const auto& square = board.getSquare(move.from);
+  int type = evaluation.typeId(square.piece);
+  if (type < 0) {
+    return history.size();
+  }
+  size_t square_count = static_cast<size_t>(board_size) * board_size;
+  size_t piece_id = static_cast<size_t>(type) * 2 + (square.is_white ? 1 : 0);
+  size_t from = static_cast<size_t>(move.from.y) * board_size + move.from.x;
+  size_t to = static_cast<size_t>(move.to.y) * board_size + move.to.x;
+  return (piece_id * square_count + from) * square_count + to;
+}
+
+int MoveOrdering::leastValuableAttacker(const ChessBoard& board,
+                                        const PortalSystem& portal_system,
+                                        const Position& target, bool is_white,
+                                        const std::vector<int>& vacated, Position& from) const {
+  const PortalRules& rules = *portal_system.getRules();
+  int size = board.getBoardSize();
+  // Alışı yapmış taşların kareleri boş sayılır; x-ray'ler böylece açılır
+  auto isEmpty = [&](const Position& p) {
+    return board.getSquare(p).is_empty() ||
+           std::find(vacated.begin(), vacated.end(), p.y * size + p.x) != vacated.end();
+  };
+  auto kindAt = [&](const Position& p) {
+    if (isEmpty(p) || board.getSquare(p).is_white != is_white) return PieceKind::Other;
+    return board.kindAt(p);
+  };
+  // isValidMove'un sırası (GameManager::isSquareAttacked ile aynı): rok hedefi
+  // alınamaz, terfi sırasına yalnızca kenarla gidilir, girişteki taşın çıkışa
+  // hamlesinde portalın açık olması belirleyicidir
+  enum class Route { Edge, Passage, Portal };
+  auto attacks = [&](const Position& p, Route route) {
+    abilities::Mask mask = board.abilitiesAt(p);
+    if (abilities::has(mask, abilities::Royal) && abilities::has(mask, abilities::Castling) &&
+        std::abs(target.x - p.x) == 2 && target.y == p.y) {
+      return false;
+    }
+    if (abilities::has(mask, abilities::Promotion) && target.y == (is_white ? 7 : 0)) {
+      return route == Route::Edge;
+    }
+    int portal = rules.find(p, target);
+    if (portal >= 0) {
+      return portal_system.cooldownOf(portal) == 0 && rules.allows(portal, is_white);
+    }
+    return route != Route::Portal;
+  };
+
+  int best_value = -1;
+  auto consider = [&](const Position& p, Route route) {
+    int value = evaluation.pieceValue(board.getSquare(p).piece);
+    if ((best_value < 0 || value < best_value) && attacks(p, route)) {
+      best_value = value;
+      from = p;
+    }
+  };
+  auto slides = [](PieceKind kind, bool diagonal) {
+    return kind == PieceKind::Queen || kind == (diagonal ? PieceKind::Bishop : PieceKind::Rook);
+  };
+
+  int forward = is_white ? 1 : -1;
+  for (int dx : {-1, 1}) {
+    Position p{target.x + dx, target.y - forward};
+    if (board.isInBounds(p) && kindAt(p) == PieceKind::Pawn) consider(p, Route::Edge);
+  }
+  for (int i = 0; i < 8; ++i) {
+    Position p{target.x - kKnightX[i], target.y - kKnightY[i]};
+    if (board.isInBounds(p) && kindAt(p) == PieceKind::Knight) consider(p, Route::Edge);
+  }
+  for (int dir = 0; dir < 8; ++dir) {
+    Position p{target.x + kDirX[dir], target.y + kDirY[dir]};
+    if (board.isInBounds(p) && kindAt(p) == PieceKind::King) consider(p, Route::Edge);
+    while (board.isInBounds(p) && isEmpty(p)) {
+      p = {p.x + kDirX[dir], p.y + kDirY[dir]};
+    }
+    if (board.isInBounds(p) && slides(kindAt(p), dir >= 4)) consider(p, Route::Edge);
+  }
+
+  // Girişteki herhangi bir taş çıkışa sıçrar
+  for (const auto& portal : rules.portals) {
+    const Position& entry = portal.positions.entry;
+    if (portal.positions.exit.x == target.x && portal.positions.exit.y == target.y &&
+        board.isInBounds(entry) && !isEmpty(entry) &&
+        board.getSquare(entry).is_white == is_white) {
+      consider(entry, Route::Portal);
+    }
+  }
+
+  // Açık geçiş: çıkıştan hedefe boş hat varsa ışın girişten geriye yürünür
+  if (!portal_system.hasOpenPassage(is_white)) {
+    return best_value;
+  }
+  for (const auto& entry : portal_system.getPassageEntries()) {
+    int portal = portal_system.passageAt(entry, is_white);
+    if (portal < 0 || !board.isInBounds(entry) || !isEmpty(entry) ||
+        (entry.x == target.x && entry.y == target.y)) {
+      continue;
+    }
+    const Position& exit = rules.portals[portal].positions.exit;
+    int dx = target.x - exit.x, dy = target.y - exit.y;
+    if ((dx == 0 && dy == 0) || (dx != 0 && dy != 0 && std::abs(dx) != std::abs(dy)) ||
+        !board.isInBounds(exit) || !isEmpty(exit)) {
+      continue;
+    }
+    int step_x = (dx > 0) - (dx < 0), step_y = (dy > 0) - (dy < 0);
+    Position p{exit.x + step_x, exit.y + step_y};
+    while ((p.x != target.x || p.y != target.y) && isEmpty(p)) {
+      p = {p.x + step_x, p.y + step_y};
+    }
+    if (p.x != target.x || p.y != target.y) {
+      continue;
+    }
+    // Hedef kare dolu sayılır: geriye yürüyen ışını keser
+    p = {entry.x - step_x, entry.y - step_y};
+    while (board.isInBounds(p) && (p.x != target.x || p.y != target.y) && isEmpty(p)) {
+      p = {p.x - step_x, p.y - step_y};
+    }
+    if (board.isInBounds(p) && (p.x != target.x || p.y != target.y) &&
+        slides(kindAt(p), step_x != 0 && step_y != 0)) {
+      consider(p, Route::Passage);
+    }
+  }
+  return best_value;
+}
+
+int MoveOrdering::staticExchange(const ChessBoard& board, const PortalSystem& portal_system,
+                                 const CoordinateMove& move) const {
+  // Tahta kopyalanmaz: hedefteki taşın değeri ve boşalan kareler yerelde tutulur
+  const Position target = move.to;
+  std::vector<int> gains;
+  gains.reserve(16);
+  std::vector<int> vacated;
+  vacated.reserve(16);
+
+  bool side = board.getSquare(move.from).is_white;
+  Position from = move.from;
+  int victim = board.getSquare(target).is_empty()
+                   ? 0 : evaluation.pieceValue(board.getSquare(target).piece);
+
+  for (;;) {
+    int gain = victim;
+    if (!gains.empty()) {
+      gain -= gains.back();
+    }
+
+    // Alan taş portal girişine düşerse çıkışa ışınlanır: çıkıştaki taş ezilir
+    // ve hedefte geri alınacak bir şey kalmaz
+    const PortalConfig* portal = portal_system.activePortalAt(target, side);
+    if (portal != nullptr) {
+      const Position& exit = portal->positions.exit;
+      const auto& at_exit = board.getSquare(exit);
+      if (!at_exit.is_empty() && std::find(vacated.begin(), vacated.end(),
+                                           exit.y * board_size + exit.x) == vacated.end()) {
+        int crushed = evaluation.pieceValue(at_exit.piece);
+        gain += (at_exit.is_white != side) ? crushed : -crushed;
+      }
+      gains.push_back(gain);
+      break;
+    }
+    gains.push_back(gain);
+
+    victim = evaluation.pieceValue(board.getSquare(from).piece);
+    vacated.push_back(from.y * board_size + from.x);
+    side = !side;
+
+    // Yeni karşı saldıran: x-ray'ler boşalan kareler üzerinden görünür
+    if (leastValuableAttacker(board, portal_system, target, side, vacated, from) < 0) {
+      break;
+    }
+  }
+
+  // Her taraf kaybettiren alışı yapmamayı seçebilir
+  for (size_t i = gains.size() - 1; i > 0; --i) {
+    gains[i - 1] = -std::max(-gains[i - 1], gains[i]);
+  }
+  return gains[0];
+}
+
+void MoveOrdering::order(const ChessBoard& board, const PortalSystem& portal_system,
+                         std::vector<CoordinateMove>& moves, int ply) const {
+  std::vector<std::pair<int, CoordinateMove>> scored;
+  scored.reserve(moves.size());
+  for (const auto& move : moves) {
+    int score = 0;
+    if (isCapture(board, move)) {
+      int see = staticExchange(board, portal_system, move);
+      score = (see >= 0 ? kGoodCapture : kBadCapture) + see;
+    } else if (move.promotion == 'q') {
+      score = kPromotion;
+    } else if (ply < kMaxPly && sameMove(move, killers[ply][0])) {
+      score = kKiller + 1;
+    } else if (ply < kMaxPly && sameMove(move, killers[ply][1])) {
+      score = kKiller;
+    } else {
+      size_t index = historyIndex(board, move);
+      score = index < history.size() ? history[index] : 0;
+    }
+    scored.push_back({score, move});
+  }
+  std::stable_sort(scored.begin(), scored.end(),
+                   [](const auto& a, const auto& b) { return a.first > b.first; });
+  for (size_t i = 0; i < moves.size(); ++i) {
+    moves[i] = scored[i].second;
+  }
+}
+
+void MoveOrdering::recordCutoff(const ChessBoard& board, const CoordinateMove& move, int ply,
+                                int depth) {
+  if (isCapture(board, move)) {
+    return;
+  }
+  if (ply < kMaxPly && !sameMove(move, killers[ply][0])) {
+    killers[ply][1] = killers[ply][0];
+    killers[ply][0] = move;
+  }
+  size_t index = historyIndex(board, move);
+  if (index < history.size()) {
+    history[index] += depth * depth;
+    // Taşmayı önlemek için tüm tabloyu yarıla
+    if (history[index] > kKiller / 2) {
+      for (auto& value : history) value /= 2;
+    }
+  }
+}
@@ -1,10 +1,47 @@
 // MoveValidator.cpp
 #include "MoveValidator.hpp"
+#include "BoardKernels.hpp"
+#include "RayScan.hpp"
 #include <algorithm>
 #include <cmath>
 #include <cctype>
 #include <iostream>
 
+namespace {
+
+constexpr int kDirX[8] = {0, 0, 1, -1, 1, 1, -1, -1};
+constexpr int kDirY[8] = {1, -1, 0, 0, 1, -1, 1, -1};
+
+// Rok yapan taraf hem royal hem castling yetenekli taştır; eşi royal olmayan castling'li taş
+bool isCastlingKing(abilities::Mask mask) {
+  return abilities::has(mask, abilities::Royal) && abilities::has(mask, abilities::Castling);
+}
+
+bool isSlider(PieceKind kind) {
+  return kind == PieceKind::Bishop || kind == PieceKind::Rook || kind == PieceKind::Queen;
+}
+
+// Kayan taşın tek hedefi: yalnızca o yöndeki ışın yürünür. Sonuç getMoveEdges'le
+// aynı (hedefteki kendi taşı çağıran eler), ama tüm kenarlar ve büyük tahtada
+// ışın tablosu kurulmaz; şah kontrolü gibi tek hamlelik sorgular için
+bool slidesTo(PieceKind kind, const Position& start, const Position& end,
+              const ChessBoard& board) {
+  int dx = end.x - start.x, dy = end.y - start.y;
+  bool straight = (dx == 0) != (dy == 0);
+  bool diagonal = dx != 0 && std::abs(dx) == std::abs(dy);
+  if (!(straight && kind != PieceKind::Bishop) && !(diagonal && kind != PieceKind::Rook)) {
+    return false;
+  }
+  int step_x = (dx > 0) - (dx < 0), step_y = (dy > 0) - (dy < 0);
+  for (Position p{start.x + step_x, start.y + step_y}; p.x != end.x || p.y != end.y;
+       p = {p.x + step_x, p.y + step_y}) {
+    if (!board.getSquare(p).is_empty()) return false;
+  }
+  return true;
+}
+
+} // namespace
+
 std::string MoveValidator::toLowerCase(const std::string& str) const {
   std::string lower = str;
   std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) { 
@@ -17,106 +54,68 @@ std::vector<Position> MoveValidator::getMoveEdges(const std::string& piece_lower
                                                   const Position& pos, bool is_white, 
                                                   const ChessBoard& board) const {
     std::vector<Position> edges;
-    int forward = is_white ? 1 : -1;  // Beyaz yukarı, siyah aşağı hareket eder
-
-    std::string piece_type = toLowerCase(piece_lower);
-
-    if (piece_type == "pawn") {
-        // Normal ileri hareket
-        Position forward_one = {pos.x, pos.y + forward};
-        if (board.isInBounds(forward_one) && board.getSquare(forward_one).is_empty()) {
-            edges.push_back(forward_one);
-            
-            // İlk harekette 2 kare ileri
-            if ((is_white && pos.y == 1) || (!is_white && pos.y == 6)) {
-                Position forward_two = {pos.x, pos.y + 2 * forward};
-                if (board.isInBounds(forward_two) && board.getSquare(forward_two).is_empty() &&
-                    board.getSquare(forward_one).is_empty()) {
-                    edges.push_back(forward_two);
-                }
-            }
-        }
+    if (!board.isInBounds(pos)) {
+        return edges;
+    }
+    // Piyon beyazda yukarı, siyahta aşağı; kayan taşlar ilk engelde durur.
+    // Kurallar tahta boyutuna göre seçilen çekirdekte (BoardKernels)
+    PieceKind kind = pieceKindOf(toLowerCase(piece_lower));
+    int size = board.getBoardSize();
+    if (isSlider(kind) && use_ray_tables && size >= RayTable::kMinBoardSize && RayTable::supports(size)) {
+        // Büyük tahtada ışınlar tüm kareler için bir kez (AVX2) hesaplanır
+        board.getRayTable().appendSliderEdges(kind, pos, edges);
+        return edges;
+    }
+    board.getKernels().edges(kind, pos, is_white, board.rawSquares(), edges);
+    return edges;
+}
 
-        // Çapraz yeme hareketleri
-        std::vector<Position> captures = {
-            {pos.x - 1, pos.y + forward},
-            {pos.x + 1, pos.y + forward}
-        };
-
-        for (const auto& capture : captures) {
-            if (board.isInBounds(capture)) {
-                const auto& target = board.getSquare(capture);
-                if (!target.is_empty() && target.is_white != is_white) {
-                    edges.push_back(capture);
-                }
-            }
-        }
-    } else if (piece_type == "knight") {
-        std::vector<std::pair<int, int>> knight_moves = {
-            {2, 1}, {2, -1}, {-2, 1}, {-2, -1}, {1, 2}, {1, -2}, {-1, 2}, {-1, -2}
-        };
-        for (const auto& move : knight_moves) {
-            Position p = {pos.x + move.first, pos.y + move.second};
-            if (board.isInBounds(p)) {
-                const auto& target_square = board.getSquare(p);
-                if (target_square.is_empty() || target_square.is_white != is_white) {
-                    edges.push_back(p);
-                }
-            }
-        }
-    } else if (piece_type == "bishop") {
-        std::vector<std::pair<int, int>> directions = {{1,1}, {1,-1}, {-1,1}, {-1,-1}};
-        for (const auto& dir : directions) {
-            for (int i = 1; i < board.getBoardSize(); ++i) {
-                Position p = {pos.x + i * dir.first, pos.y + i * dir.second};
-                if (!board.isInBounds(p)) break;
-                const auto& target = board.getSquare(p);
-                edges.push_back(p);
-                if (!target.is_empty()) break;
-            }
-        }
-    } else if (piece_type == "rook") {
-        std::vector<std::pair<int, int>> directions = {{0,1}, {0,-1}, {1,0}, {-1,0}};
-        for (const auto& dir : directions) {
-            for (int i = 1; i < board.getBoardSize(); ++i) {
-                Position p = {pos.x + i * dir.first, pos.y + i * dir.second};
-                if (!board.isInBounds(p)) break;
-                const auto& target = board.getSquare(p);
-                edges.push_back(p);
-                if (!target.is_empty()) break;
-            }
-        }
-    } else if (piece_type == "queen") {
-        std::vector<std::pair<int, int>> directions = {
-            {0,1}, {0,-1}, {1,0}, {-1,0},
-            {1,1}, {1,-1}, {-1,1}, {-1,-1}
-        };
-        for (const auto& dir : directions) {
-            for (int i = 1; i < board.getBoardSize(); ++i) {
-                Position p = {pos.x + i * dir.first, pos.y + i * dir.second};
-                if (!board.isInBounds(p)) break;
-                const auto& target = board.getSquare(p);
-                edges.push_back(p);
-                if (!target.is_empty()) break;
-            }
-        }
-    } else if (piece_type == "king") {
-        std::vector<std::pair<int, int>> directions = {
-            {0,1}, {0,-1}, {1,0}, {-1,0},
-            {1,1}, {1,-1}, {-1,1}, {-1,-1}
-        };
-        for (const auto& dir : directions) {
-            Position p = {pos.x + dir.first, pos.y + dir.second};
-            if (board.isInBounds(p)) {
-                const auto& target_square = board.getSquare(p);
-                if (target_square.is_empty() || target_square.is_white != is_white) {
-                    edges.push_back(p);
-                }
-            }
-        }
+// Işın boş karelerden ilerler; açık bir geçişe gelen ışın çıkış boşsa oradan
+// aynı yönde sürer (tek sıçrama). Geçişin ötesindeki asıl ışın da geçerli kalır.
+// preserve_direction'sız portalda taş girişe iner ve çıkışta durur (movePiece)
+std::vector<MoveValidator::PassageTarget> MoveValidator::passageTargets(
+    const std::string& piece_lower, const Position& start, bool is_white,
+    const ChessBoard& board, const PortalSystem& portal_system) const {
+  std::vector<PassageTarget> found;
+  if (!portal_system.hasOpenPassage(is_white)) {
+    return found;
+  }
+  PieceKind kind = pieceKindOf(piece_lower);
+  if (!isSlider(kind)) {
+    return found;
+  }
+  int first_dir = kind == PieceKind::Bishop ? 4 : 0;
+  int last_dir = kind == PieceKind::Rook ? 4 : 8;
+  for (int dir = first_dir; dir < last_dir; ++dir) {
+    for (Position p{start.x + kDirX[dir], start.y + kDirY[dir]};
+         board.isInBounds(p) && board.getSquare(p).is_empty();
+         p = {p.x + kDirX[dir], p.y + kDirY[dir]}) {
+      int portal = portal_system.passageAt(p, is_white);
+      if (portal < 0) continue;
+      const Position& exit = portal_system.getPortals()[portal].positions.exit;
+      if (!board.isInBounds(exit) || !board.getSquare(exit).is_empty()) continue;
+      for (Position q{exit.x + kDirX[dir], exit.y + kDirY[dir]}; board.isInBounds(q);
+           q = {q.x + kDirX[dir], q.y + kDirY[dir]}) {
+        const auto& square = board.getSquare(q);
+        if (!square.is_empty() && square.is_white == is_white) break;
+        found.push_back({q, portal});
+        if (!square.is_empty()) break;
+      }
     }
+  }
+  return found;
+}
 
-    return edges;
+int MoveValidator::passagePortal(const std::string& piece, const Position& start,
+                                 const Position& end, bool is_white, const ChessBoard& board,
+                                 const PortalSystem& portal_system) const {
+  std::string piece_lower = toLowerCase(piece);
+  PieceKind kind = pieceKindOf(piece_lower);
+  if (isSlider(kind) && slidesTo(kind, start, end, board)) return -1;
+  for (const auto& passage : passageTargets(piece_lower, start, is_white, board, portal_system)) {
+    if (passage.target.x == end.x && passage.target.y == end.y) return passage.portal;
+  }
+  return -1;
 }
 
 bool MoveValidator::bfsValidateMove(const std::string& piece_lower, const Position& start, 
@@ -156,7 +155,7 @@ bool MoveValidator::bfsValidateMove(const std::string& piece_lower, const Positi
     auto edges = getMoveEdges(piece_lower, current, is_white, board);
 
     // Portal bağlantıları
-    if (piece_lower == "teleporter" && portal_system.isPortalMove(current, end)) {
+    if (board.hasAbility(start, abilities::PortalMaster) && portal_system.isPortalMove(current, end)) {
       Position portal_exit = end; // Portal çıkış pozisyonu
       if (board.isInBounds(portal_exit)) {
         std::string exit_str = posToString(portal_exit);
@@ -187,6 +186,27 @@ bool MoveValidator::bfsValidateMove(const std::string& piece_lower, const Positi
   return false;
 }
 
+Expected<void, MoveError> MoveValidator::checkMove(const std::string& piece,
+                                                  const Position& start, const Position& end,
+                                                  bool is_white, const ChessBoard& board,
+                                                  const PortalSystem& portal_system) const {
+    auto start_square = board.tryGetSquare(start);
+    if (!start_square || !board.isInBounds(end)) {
+        return unexpected(MoveError::OutOfBounds);
+    }
+    if ((*start_square)->is_empty()) {
+        return unexpected(MoveError::EmptySquare);
+    }
+    if ((*start_square)->is_white != is_white ||
+        toLowerCase((*start_square)->piece) != toLowerCase(piece)) {
+        return unexpected(MoveError::WrongPiece);
+    }
+    if (!isValidMove(piece, start, end, is_white, board, portal_system)) {
+        return unexpected(MoveError::IllegalMove);
+    }
+    return {};
+}
+
 bool MoveValidator::isValidMove(const std::string& piece, const Position& start, 
                                const Position& end, bool is_white, 
                                const ChessBoard& board, 
@@ -216,19 +236,18 @@ bool MoveValidator::isValidMove(const std::string& piece, const Position& start,
     }
 
     std::string piece_lower = toLowerCase(piece);
+    const abilities::Mask mask = board.abilitiesAt(start);
 
     // Rok kontrolü
-    if (piece_lower == "king" && abs(end.x - start.x) == 2 && end.y == start.y) {
+    if (isCastlingKing(mask) && abs(end.x - start.x) == 2 && end.y == start.y) {
         return validateCastling(start, end, is_white, board);
     }
 
-    // Piyon özel hareketleri
-    if (piece_lower == "pawn") {
-        // En passant kontrolü
-        if (isEnPassantMove(start, end, is_white, board)) {
-            return true;
-        }
-        
+    // Piyon özel hareketleri: en passant ve terfi
+    if (abilities::has(mask, abilities::EnPassant) && isEnPassantMove(start, end, is_white, board)) {
+        return true;
+    }
+    if (abilities::has(mask, abilities::Promotion)) {
         // Terfi kontrolü - son sıraya ulaşma
         if ((is_white && end.y == 7) || (!is_white && end.y == 0)) {
             // Hareket geçerliyse terfi edilebilir
@@ -244,18 +263,32 @@ bool MoveValidator::isValidMove(const std::string& piece, const Position& start,
 
     // Portal hareketi kontrolü
     if (portal_system.isPortalMove(start, end)) {
-        std::cout << "\nPortal hareketi tespit edildi!" << std::endl;
+        if (verbose) std::cout << "\nPortal hareketi tespit edildi!" << std::endl;
         bool valid = portal_system.validatePortalMove(piece, start, end, is_white, board);
-        if (!valid) {
+        if (!valid && verbose) {
             std::cout << "Portal kullanılamıyor - Cooldown veya renk kısıtlaması olabilir." << std::endl;
         }
         return valid;
     }
 
     // Normal hareket kontrolü
-    auto valid_moves = getMoveEdges(piece_lower, start, is_white, board);
-    for (const auto& move : valid_moves) {
-        if (move.x == end.x && move.y == end.y) {
+    PieceKind kind = board.kindAt(start);
+    if (isSlider(kind)) {
+        if (slidesTo(kind, start, end, board)) {
+            return true;
+        }
+    } else {
+        auto valid_moves = getMoveEdges(piece_lower, start, is_white, board);
+        for (const auto& move : valid_moves) {
+            if (move.x == end.x && move.y == end.y) {
+                return true;
+            }
+        }
+    }
+
+    // Portaldan geçen ışın
+    for (const auto& passage : passageTargets(piece_lower, start, is_white, board, portal_system)) {
+        if (passage.target.x == end.x && passage.target.y == end.y) {
             return true;
         }
     }
@@ -263,6 +296,49 @@ bool MoveValidator::isValidMove(const std::string& piece, const Position& start,
     return false;
 }
 
+std::vector<Position> MoveValidator::generateTargets(const std::string& piece,
+                                                     const Position& start, bool is_white,
+                                                     const ChessBoard& board,
+                                                     const PortalSystem& portal_system) const {
+    std::string piece_lower = toLowerCase(piece);
+    std::vector<Position> candidates = getMoveEdges(piece_lower, start, is_white, board);
+    const abilities::Mask mask = board.abilitiesAt(start);
+
+    // Kenar listesinde olmayan özel hedefler
+    if (isCastlingKing(mask)) {
+        candidates.push_back({start.x + 2, start.y});
+        candidates.push_back({start.x - 2, start.y});
+    }
+    if (abilities::has(mask, abilities::EnPassant)) {
+        int forward = is_white ? 1 : -1;
+        candidates.push_back({start.x - 1, start.y + forward});
+        candidates.push_back({start.x + 1, start.y + forward});
+    }
+    for (const auto& portal : portal_system.getPortals()) {
+        if (portal.positions.entry.x == start.x && portal.positions.entry.y == start.y) {
+            candidates.push_back(portal.positions.exit);
+        }
+    }
+    for (const auto& passage : passageTargets(piece_lower, start, is_white, board, portal_system)) {
+        candidates.push_back(passage.target);
+    }
+
+    std::vector<Position> targets;
+    for (const auto& target : candidates) {
+        bool seen = false;
+        for (const auto& existing : targets) {
+            if (existing.x == target.x && existing.y == target.y) {
+                seen = true;
+                break;
+            }
+        }
+        if (!seen && isValidMove(piece, start, target, is_white, board, portal_system)) {
+            targets.push_back(target);
+        }
+    }
+    return targets;
+}
+
 bool MoveValidator::validateCastling(const Position& start, const Position& end, 
                                    bool is_white, const ChessBoard& board) const {
     // Şah hareket etmiş mi kontrol et
@@ -277,8 +353,9 @@ bool MoveValidator::validateCastling(const Position& start, const Position& end,
     // Kale yerinde mi ve hareket etmemiş mi?
     Position rook_pos = {rook_x, start.y};
     const auto& rook_square = board.getSquare(rook_pos);
-    if (rook_square.is_empty() || toLowerCase(rook_square.piece) != "rook" || 
-        rook_square.is_white != is_white) {
+    abilities::Mask partner = board.abilitiesAt(rook_pos);
+    if (rook_square.is_empty() || !abilities::has(partner, abilities::Castling) ||
+        abilities::has(partner, abilities::Royal) || rook_square.is_white != is_white) {
         return false;
     }
 
@@ -313,7 +390,7 @@ bool MoveValidator::isEnPassantMove(const Position& start, const Position& end,
     // Yenilecek piyon son hamlede 2 kare ilerlemiş olmalı
     Position captured_pos = {end.x, start.y};
     const auto& captured_square = board.getSquare(captured_pos);
-    if (captured_square.is_empty() || toLowerCase(captured_square.piece) != "pawn" ||
+    if (captured_square.is_empty() || !board.hasAbility(captured_pos, abilities::EnPassant) ||
         captured_square.is_white == is_white) {
         return false;
     }
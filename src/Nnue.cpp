@@ -0,0 +1,442 @@
+// Nnue.cpp
+#include "Nnue.hpp"
+#include "ChessBoard.hpp"
+#include "Evaluation.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <random>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <type_traits>
+#include <unistd.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define NNUE_X86 1
+#include <immintrin.h>
+#endif
+
+static_assert(sizeof(NnueNetwork::Header) == 32, "ağ başlığı sabit boyutlu olmalı");
+
+namespace {
+
+const char kMagic[8] = {'P', 'C', 'N', 'N', 'U', 'E', '1', '\0'};
+
+int16_t activate(int32_t sum, int shift) {
+  return static_cast<int16_t>(std::clamp(sum >> shift, 0, NnueNetwork::kActivationMax));
+}
+
+// Çekirdekler: n her zaman 16'nın katı. removed/added boş olabilir.
+struct KernelSet {
+  void (*update)(int16_t* accumulator, const int16_t* removed, const int16_t* added, int n);
+  void (*clip)(const int16_t* in, int16_t* out, int n);
+  int32_t (*dot)(const int16_t* a, const int16_t* b, int n);
+};
+
+namespace scalar {
+
+// int16 taşması SIMD'deki gibi sarar
+void update(int16_t* accumulator, const int16_t* removed, const int16_t* added, int n) {
+  for (int i = 0; i < n; ++i) {
+    int value = accumulator[i];
+    if (removed) value -= removed[i];
+    if (added) value += added[i];
+    accumulator[i] = static_cast<int16_t>(value);
+  }
+}
+
+void clip(const int16_t* in, int16_t* out, int n) {
+  for (int i = 0; i < n; ++i) {
+    out[i] = static_cast<int16_t>(std::clamp<int>(in[i], 0, NnueNetwork::kActivationMax));
+  }
+}
+
+int32_t dot(const int16_t* a, const int16_t* b, int n) {
+  int32_t sum = 0;
+  for (int i = 0; i < n; ++i) sum += static_cast<int32_t>(a[i]) * b[i];
+  return sum;
+}
+
+constexpr KernelSet kKernels{update, clip, dot};
+
+} // namespace scalar
+
+#ifdef NNUE_X86
+namespace sse2 {
+
+__attribute__((target("sse2"))) void update(int16_t* accumulator, const int16_t* removed,
+                                            const int16_t* added, int n) {
+  for (int i = 0; i < n; i += 8) {
+    auto* slot = reinterpret_cast<__m128i*>(accumulator + i);
+    __m128i value = _mm_loadu_si128(slot);
+    if (removed) {
+      value = _mm_sub_epi16(value,
+                            _mm_loadu_si128(reinterpret_cast<const __m128i*>(removed + i)));
+    }
+    if (added) {
+      value = _mm_add_epi16(value, _mm_loadu_si128(reinterpret_cast<const __m128i*>(added + i)));
+    }
+    _mm_storeu_si128(slot, value);
+  }
+}
+
+__attribute__((target("sse2"))) void clip(const int16_t* in, int16_t* out, int n) {
+  const __m128i low = _mm_setzero_si128();
+  const __m128i high = _mm_set1_epi16(NnueNetwork::kActivationMax);
+  for (int i = 0; i < n; i += 8) {
+    __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+    value = _mm_min_epi16(_mm_max_epi16(value, low), high);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), value);
+  }
+}
+
+__attribute__((target("sse2"))) int32_t dot(const int16_t* a, const int16_t* b, int n) {
+  __m128i sum = _mm_setzero_si128();
+  for (int i = 0; i < n; i += 8) {
+    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+    __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+    sum = _mm_add_epi32(sum, _mm_madd_epi16(x, y));
+  }
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0x4E));
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0xB1));
+  return _mm_cvtsi128_si32(sum);
+}
+
+constexpr KernelSet kKernels{update, clip, dot};
+
+} // namespace sse2
+
+namespace avx2 {
+
+__attribute__((target("avx2"))) void update(int16_t* accumulator, const int16_t* removed,
+                                            const int16_t* added, int n) {
+  for (int i = 0; i < n; i += 16) {
+    auto* slot = reinterpret_cast<__m256i*>(accumulator + i);
+    __m256i value = _mm256_loadu_si256(slot);
+    if (removed) {
+      value = _mm256_sub_epi16(
+          value, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(removed + i)));
+    }
+    if (added) {
+      value = _mm256_add_epi16(
+          value, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(added + i)));
+    }
+    _mm256_storeu_si256(slot, value);
+  }
+}
+
+__attribute__((target("avx2"))) void clip(const int16_t* in, int16_t* out, int n) {
+  const __m256i low = _mm256_setzero_si256();
+  const __m256i high = _mm256_set1_epi16(NnueNetwork::kActivationMax);
+  for (int i = 0; i < n; i += 16) {
+    __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+    value = _mm256_min_epi16(_mm256_max_epi16(value, low), high);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), value);
+  }
+}
+
+__attribute__((target("avx2"))) int32_t dot(const int16_t* a, const int16_t* b, int n) {
+  __m256i sum = _mm256_setzero_si256();
+  for (int i = 0; i < n; i += 16) {
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+    __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+    sum = _mm256_add_epi32(sum, _mm256_madd_epi16(x, y));
+  }
+  __m128i half = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+  half = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0x4E));
+  half = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0xB1));
+  return _mm_cvtsi128_si32(half);
+}
+
+constexpr KernelSet kKernels{update, clip, dot};
+
+} // namespace avx2
+#endif
+
+const KernelSet& kernelsFor(NnueNetwork::Backend backend) {
+#ifdef NNUE_X86
+  if (backend == NnueNetwork::Backend::Avx2 && NnueNetwork::supports(backend)) {
+    return avx2::kKernels;
+  }
+  if (backend == NnueNetwork::Backend::Sse2 && NnueNetwork::supports(backend)) {
+    return sse2::kKernels;
+  }
+#else
+  (void)backend;
+#endif
+  return scalar::kKernels;
+}
+
+size_t fileSizeFor(size_t types, size_t board_size, size_t hidden, size_t dense) {
+  size_t inputs = 2 * types * board_size * board_size;
+  return sizeof(NnueNetwork::Header) + types * NnueNetwork::kNameSize + inputs * 4 +
+         hidden * 2 + inputs * hidden * 2 + dense * 4 + dense * hidden * 2 + dense * 4 +
+         dense * dense * 2 + 4 + dense * 2;
+}
+
+bool validShape(int hidden, int dense) {
+  return hidden > 0 && hidden % 16 == 0 && hidden <= NnueNetwork::kMaxHidden && dense > 0 &&
+         dense % 16 == 0 && dense <= NnueNetwork::kMaxDense;
+}
+
+int16_t randomIn(std::mt19937_64& rng, int range) {
+  if (range <= 0) return 0;
+  return static_cast<int16_t>(static_cast<int>(rng() % (2 * range + 1)) - range);
+}
+
+} // namespace
+
+NnueNetwork::~NnueNetwork() {
+  if (mapping != nullptr) munmap(mapping, mapping_size);
+}
+
+bool NnueNetwork::supports(Backend backend) {
+#ifdef NNUE_X86
+  switch (backend) {
+    case Backend::Scalar: return true;
+    case Backend::Sse2: return __builtin_cpu_supports("sse2");
+    case Backend::Avx2: return __builtin_cpu_supports("avx2");
+  }
+  return false;
+#else
+  return backend == Backend::Scalar;
+#endif
+}
+
+NnueNetwork::Backend NnueNetwork::defaultBackend() {
+  static const Backend backend = supports(Backend::Avx2)   ? Backend::Avx2
+                                 : supports(Backend::Sse2) ? Backend::Sse2
+                                                           : Backend::Scalar;
+  return backend;
+}
+
+const char* NnueNetwork::backendName(Backend backend) {
+  switch (backend) {
+    case Backend::Scalar: return "skaler";
+    case Backend::Sse2: return "SSE2";
+    case Backend::Avx2: return "AVX2";
+  }
+  return "skaler";
+}
+
+std::shared_ptr<const NnueNetwork> NnueNetwork::open(const std::string& path, int board_size,
+                                                     std::string& error) {
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    error = "NNUE dosyası açılamadı: " + path;
+    return nullptr;
+  }
+  struct stat info;
+  if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(Header)) {
+    error = "NNUE dosyası bozuk: " + path;
+    ::close(fd);
+    return nullptr;
+  }
+  void* data = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (data == MAP_FAILED) {
+    error = "NNUE dosyası eşlenemedi: " + path;
+    return nullptr;
+  }
+
+  std::shared_ptr<NnueNetwork> network(new NnueNetwork());
+  network->mapping = data;
+  network->mapping_size = static_cast<size_t>(info.st_size);
+  const auto* header = static_cast<const Header*>(data);
+  int hidden = static_cast<int>(header->hidden);
+  int dense = static_cast<int>(header->dense);
+  if (std::memcmp(header->magic, kMagic, sizeof(kMagic)) != 0 ||
+      header->version != kVersion || header->type_count == 0 || !validShape(hidden, dense) ||
+      fileSizeFor(header->type_count, header->board_size, header->hidden, header->dense) !=
+          network->mapping_size) {
+    error = "NNUE dosyası biçimi tanınmadı: " + path;
+    return nullptr;
+  }
+  if (static_cast<int>(header->board_size) != board_size) {
+    error = "NNUE ağı " + std::to_string(header->board_size) + "x" +
+            std::to_string(header->board_size) + " tahta için: " + path;
+    return nullptr;
+  }
+
+  network->header = header;
+  const char* cursor = static_cast<const char*>(data) + sizeof(Header);
+  for (uint32_t i = 0; i < header->type_count; ++i) {
+    std::string name(cursor, strnlen(cursor, kNameSize));
+    network->type_slots.emplace(name, static_cast<int>(i));
+    cursor += kNameSize;
+  }
+  size_t squares = static_cast<size_t>(board_size) * board_size;
+  network->input_count = static_cast<int>(2 * header->type_count * squares);
+  auto take = [&cursor](auto*& target, size_t count) {
+    target = reinterpret_cast<std::remove_reference_t<decltype(target)>>(cursor);
+    cursor += count * sizeof(*target);
+  };
+  size_t inputs = static_cast<size_t>(network->input_count);
+  take(network->psqt, inputs);
+  take(network->feature_bias, header->hidden);
+  take(network->feature_weights, inputs * header->hidden);
+  take(network->dense1_bias, header->dense);
+  take(network->dense1_weights, static_cast<size_t>(header->dense) * header->hidden);
+  take(network->dense2_bias, header->dense);
+  take(network->dense2_weights, static_cast<size_t>(header->dense) * header->dense);
+  take(network->output_bias, 1);
+  take(network->output_weights, header->dense);
+  return network;
+}
+
+bool NnueNetwork::write(const std::string& path, const Weights& weights, std::string& error) {
+  size_t types = weights.types.size();
+  size_t hidden = static_cast<size_t>(weights.hidden);
+  size_t dense = static_cast<size_t>(weights.dense);
+  size_t inputs = 2 * types * weights.board_size * weights.board_size;
+  if (types == 0 || weights.board_size <= 0 || !validShape(weights.hidden, weights.dense) ||
+      weights.psqt.size() != inputs || weights.feature_bias.size() != hidden ||
+      weights.feature_weights.size() != inputs * hidden || weights.dense1_bias.size() != dense ||
+      weights.dense1_weights.size() != dense * hidden || weights.dense2_bias.size() != dense ||
+      weights.dense2_weights.size() != dense * dense || weights.output_weights.size() != dense) {
+    error = "NNUE ağırlıklarının boyutları tutarsız";
+    return false;
+  }
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file) {
+    error = "NNUE dosyası yazılamadı: " + path;
+    return false;
+  }
+  Header header{};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.board_size = static_cast<uint32_t>(weights.board_size);
+  header.type_count = static_cast<uint32_t>(types);
+  header.hidden = static_cast<uint32_t>(hidden);
+  header.dense = static_cast<uint32_t>(dense);
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  for (const auto& type : weights.types) {
+    char name[kNameSize] = {};
+    std::memcpy(name, type.data(), std::min(type.size(), kNameSize));
+    file.write(name, kNameSize);
+  }
+  auto put = [&file](const auto& values) {
+    file.write(reinterpret_cast<const char*>(values.data()),
+               static_cast<std::streamsize>(values.size() * sizeof(values[0])));
+  };
+  put(weights.psqt);
+  put(weights.feature_bias);
+  put(weights.feature_weights);
+  put(weights.dense1_bias);
+  put(weights.dense1_weights);
+  put(weights.dense2_bias);
+  put(weights.dense2_weights);
+  file.write(reinterpret_cast<const char*>(&weights.output_bias), sizeof(weights.output_bias));
+  put(weights.output_weights);
+  if (!file) {
+    error = "NNUE dosyası yazılamadı: " + path;
+    return false;
+  }
+  return true;
+}
+
+NnueNetwork::Weights NnueNetwork::initialWeights(const Evaluation& evaluation,
+                                                 const std::vector<std::string>& types,
+                                                 int hidden, int dense, uint64_t seed,
+                                                 int output_scale) {
+  Weights weights;
+  weights.board_size = evaluation.getBoardSize();
+  weights.hidden = hidden;
+  weights.dense = dense;
+  weights.types = types;
+  int size = weights.board_size;
+  size_t inputs = 2 * types.size() * size * size;
+  weights.psqt.resize(inputs);
+  for (int white = 0; white < 2; ++white) {
+    for (size_t type = 0; type < types.size(); ++type) {
+      for (int square = 0; square < size * size; ++square) {
+        size_t index = (white * types.size() + type) * size * size + square;
+        weights.psqt[index] = evaluation.squareScore(types[type], white == 1,
+                                                     {square % size, square / size});
+      }
+    }
+  }
+  // Aralıklar aktivasyonlar çoğunlukla 0..127 içinde kalacak şekilde seçildi
+  std::mt19937_64 rng(seed);
+  auto fill = [&rng](std::vector<int16_t>& values, size_t count, int range) {
+    values.resize(count);
+    for (auto& value : values) value = randomIn(rng, range);
+  };
+  fill(weights.feature_bias, hidden, 32);
+  for (auto& bias : weights.feature_bias) bias = static_cast<int16_t>(bias + 32);
+  fill(weights.feature_weights, inputs * hidden, 8);
+  weights.dense1_bias.assign(dense, 0);
+  fill(weights.dense1_weights, static_cast<size_t>(dense) * hidden, 4);
+  weights.dense2_bias.assign(dense, 1 << kDenseShift);
+  fill(weights.dense2_weights, static_cast<size_t>(dense) * dense, 8);
+  fill(weights.output_weights, dense, output_scale);
+  return weights;
+}
+
+int NnueNetwork::feature(const std::string& piece, bool is_white, int square) const {
+  if (piece.empty()) return -1;
+  auto it = type_slots.find(piece);
+  if (it == type_slots.end()) return -1;
+  int squares = getBoardSize() * getBoardSize();
+  return ((is_white ? 1 : 0) * static_cast<int>(header->type_count) + it->second) * squares +
+         square;
+}
+
+void NnueNetwork::refresh(const ChessBoard& board, Accumulator& accumulator) const {
+  accumulator.hidden.assign(feature_bias, feature_bias + header->hidden);
+  accumulator.psqt = 0;
+  for (bool is_white : {false, true}) {
+    const auto& pieces = board.getPieces(is_white);
+    for (size_t i = 0; i < pieces.size(); ++i) {
+      int index = feature(board.typeName(pieces.types[i]), is_white, pieces.squares[i]);
+      update(accumulator, -1, index);
+    }
+  }
+}
+
+void NnueNetwork::update(Accumulator& accumulator, int removed, int added) const {
+  update(accumulator, removed, added, defaultBackend());
+}
+
+void NnueNetwork::update(Accumulator& accumulator, int removed, int added,
+                         Backend backend) const {
+  if (removed < 0 && added < 0) return;
+  const int16_t* removed_row = nullptr;
+  const int16_t* added_row = nullptr;
+  size_t hidden = header->hidden;
+  if (removed >= 0) {
+    removed_row = feature_weights + static_cast<size_t>(removed) * hidden;
+    accumulator.psqt -= psqt[removed];
+  }
+  if (added >= 0) {
+    added_row = feature_weights + static_cast<size_t>(added) * hidden;
+    accumulator.psqt += psqt[added];
+  }
+  kernelsFor(backend).update(accumulator.hidden.data(), removed_row, added_row,
+                             static_cast<int>(hidden));
+}
+
+int NnueNetwork::evaluate(const Accumulator& accumulator) const {
+  return evaluate(accumulator, defaultBackend());
+}
+
+int NnueNetwork::evaluate(const Accumulator& accumulator, Backend backend) const {
+  const KernelSet& kernels = kernelsFor(backend);
+  int hidden = getHidden();
+  int dense = getDense();
+  alignas(32) int16_t input[kMaxHidden];
+  alignas(32) int16_t first[kMaxDense];
+  alignas(32) int16_t second[kMaxDense];
+  kernels.clip(accumulator.hidden.data(), input, hidden);
+  for (int j = 0; j < dense; ++j) {
+    int32_t sum = dense1_bias[j] + kernels.dot(input, dense1_weights + j * hidden, hidden);
+    first[j] = activate(sum, kDenseShift);
+  }
+  for (int j = 0; j < dense; ++j) {
+    int32_t sum = dense2_bias[j] + kernels.dot(first, dense2_weights + j * dense, dense);
+    second[j] = activate(sum, kDenseShift);
+  }
+  int32_t output = *output_bias + kernels.dot(second, output_weights, dense);
+  return accumulator.psqt + (output >> kOutputShift);
+}
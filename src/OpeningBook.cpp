@@ -0,0 +1,144 @@
+// OpeningBook.cpp
+#include "OpeningBook.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static_assert(sizeof(OpeningBook::Header) == 32, "kitap başlığı sabit boyutlu olmalı");
+static_assert(sizeof(OpeningBook::Entry) == 16, "kitap girişi sabit boyutlu olmalı");
+
+namespace {
+const char kMagic[8] = {'P', 'C', 'B', 'O', 'O', 'K', '1', '\0'};
+}
+
+OpeningBook::~OpeningBook() {
+  close();
+}
+
+void OpeningBook::close() {
+  if (mapping != nullptr) {
+    munmap(mapping, mapping_size);
+  }
+  mapping = nullptr;
+  mapping_size = 0;
+  entries = nullptr;
+  entry_count = 0;
+}
+
+bool OpeningBook::open(const std::string& path, uint64_t config_hash) {
+  close();
+
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    std::cerr << "Açılış kitabı açılamadı: " << path << std::endl;
+    return false;
+  }
+  struct stat info;
+  if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(Header)) {
+    std::cerr << "Açılış kitabı bozuk: " << path << std::endl;
+    ::close(fd);
+    return false;
+  }
+
+  void* data = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (data == MAP_FAILED) {
+    std::cerr << "Açılış kitabı eşlenemedi: " << path << std::endl;
+    return false;
+  }
+
+  const auto* header = static_cast<const Header*>(data);
+  size_t expected = sizeof(Header) + header->entry_count * sizeof(Entry);
+  if (std::memcmp(header->magic, kMagic, sizeof(kMagic)) != 0 ||
+      header->version != kVersion || expected != static_cast<size_t>(info.st_size)) {
+    std::cerr << "Açılış kitabı biçimi tanınmadı: " << path << std::endl;
+    munmap(data, info.st_size);
+    return false;
+  }
+  if (header->config_hash != config_hash) {
+    std::cerr << "Açılış kitabı başka bir config için oluşturulmuş: " << path << std::endl;
+    munmap(data, info.st_size);
+    return false;
+  }
+
+  mapping = data;
+  mapping_size = info.st_size;
+  entries = reinterpret_cast<const Entry*>(static_cast<const char*>(data) + sizeof(Header));
+  entry_count = header->entry_count;
+  board_size = static_cast<int>(header->board_size);
+  return true;
+}
+
+std::span<const OpeningBook::Entry> OpeningBook::lookup(uint64_t key) const {
+  if (entries == nullptr) {
+    return {};
+  }
+  const Entry* end = entries + entry_count;
+  auto first = std::lower_bound(entries, end, key,
+                                [](const Entry& entry, uint64_t k) { return entry.key < k; });
+  auto last = first;
+  while (last != end && last->key == key) {
+    ++last;
+  }
+  return {first, static_cast<size_t>(last - first)};
+}
+
+CoordinateMove OpeningBook::toMove(const Entry& entry) const {
+  CoordinateMove move;
+  move.from = {entry.from % board_size, entry.from / board_size};
+  move.to = {entry.to % board_size, entry.to / board_size};
+  move.promotion = entry.promotion;
+  return move;
+}
+
+bool OpeningBook::write(const std::string& path, uint64_t config_hash, int board_size,
+                        std::vector<Entry> entries) {
+  auto same_move = [](const Entry& a, const Entry& b) {
+    return a.key == b.key && a.from == b.from && a.to == b.to && a.promotion == b.promotion;
+  };
+  std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+    if (a.key != b.key) return a.key < b.key;
+    if (a.from != b.from) return a.from < b.from;
+    if (a.to != b.to) return a.to < b.to;
+    return a.promotion < b.promotion;
+  });
+
+  // Aynı pozisyondaki aynı hamleleri tek girişte topla
+  std::vector<Entry> merged;
+  for (const auto& entry : entries) {
+    if (!merged.empty() && same_move(merged.back(), entry)) {
+      uint32_t total = static_cast<uint32_t>(merged.back().count) + entry.count;
+      merged.back().count = static_cast<uint16_t>(std::min<uint32_t>(total, UINT16_MAX));
+    } else {
+      merged.push_back(entry);
+    }
+  }
+
+  // Her pozisyon içinde en sık oynanan hamle önce gelsin
+  std::stable_sort(merged.begin(), merged.end(), [](const Entry& a, const Entry& b) {
+    if (a.key != b.key) return a.key < b.key;
+    return a.count > b.count;
+  });
+
+  Header header{};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.board_size = static_cast<uint32_t>(board_size);
+  header.config_hash = config_hash;
+  header.entry_count = merged.size();
+
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (!out.is_open()) {
+    std::cerr << "Açılış kitabı yazılamadı: " << path << std::endl;
+    return false;
+  }
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  out.write(reinterpret_cast<const char*>(merged.data()),
+            static_cast<std::streamsize>(merged.size() * sizeof(Entry)));
+  return static_cast<bool>(out);
+}
@@ -0,0 +1,245 @@
+// Perft.cpp
+#include "Perft.hpp"
+#include "MoveGenerator.hpp"
+#include "MoveValidator.hpp"
+#include "WorkStealingQueue.hpp"
+#include "Zobrist.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+namespace {
+
+// Kilitsiz giriş: anahtar yaprak sayısıyla XOR'lanarak yazılır. İki alan ayrı
+// yazıldığından yarım kalan bir yazma doğrulamadan geçmez, yalnızca ıskalanır.
+struct LeafEntry {
+  std::atomic<uint64_t> check{0};
+  std::atomic<uint64_t> nodes{0};
+};
+
+class LeafTable {
+public:
+  explicit LeafTable(size_t megabytes) {
+    size_t count = 1;
+    while ((count * 2) * sizeof(LeafEntry) <= (megabytes << 20)) count *= 2;
+    entries = std::make_unique<LeafEntry[]>(count);
+    mask = count - 1;
+  }
+
+  bool probe(uint64_t key, uint64_t& nodes) const {
+    const LeafEntry& entry = entries[key & mask];
+    uint64_t stored = entry.nodes.load(std::memory_order_relaxed);
+    if ((entry.check.load(std::memory_order_relaxed) ^ stored) != key) {
+      return false;
+    }
+    nodes = stored;
+    return true;
+  }
+
+  void store(uint64_t key, uint64_t nodes) {
+    LeafEntry& entry = entries[key & mask];
+    entry.check.store(key ^ nodes, std::memory_order_relaxed);
+    entry.nodes.store(nodes, std::memory_order_relaxed);
+  }
+
+private:
+  std::unique_ptr<LeafEntry[]> entries;
+  size_t mask = 0;
+};
+
+// Bir alt ağaç: kendi tahta ve cooldown kopyası, hangi kök hamlesine sayılacağı
+struct Task {
+  ChessBoard board;
+  PortalSystem portals;
+  bool is_white;
+  int depth;
+  size_t root;
+};
+
+struct Shared {
+  std::vector<WorkStealingQueue<std::unique_ptr<Task>>> queues;
+  std::vector<std::atomic<uint64_t>> root_nodes;
+  std::atomic<uint64_t> pending{0};   // bitmemiş görevler; 0 olunca thread'ler çıkar
+  std::atomic<unsigned> idle{0};      // görev bulamayan thread sayısı
+  std::atomic<uint64_t> tasks{0};
+  std::atomic<uint64_t> steals{0};
+  std::atomic<uint64_t> hash_hits{0};
+  LeafTable* table = nullptr;
+  int split_depth = 3;
+
+  Shared(unsigned threads, size_t roots) : queues(threads), root_nodes(roots) {}
+};
+
+class Worker {
+public:
+  Worker(Shared& shared, unsigned index) : shared(shared), index(index), generator(validator) {
+    validator.setVerbose(false);
+  }
+
+  void run() {
+    std::unique_ptr<Task> task;
+    bool waiting = false;
+    while (shared.pending.load() > 0) {
+      if (!shared.queues[index].pop(task) && !steal(task)) {
+        if (!waiting) {
+          waiting = true;
+          ++shared.idle;
+        }
+        std::this_thread::yield();
+        continue;
+      }
+      if (waiting) {
+        waiting = false;
+        --shared.idle;
+      }
+      execute(*task);
+      task.reset();
+      --shared.pending;
+    }
+    if (waiting) --shared.idle;
+    shared.steals += steals;
+    shared.hash_hits += hash_hits;
+  }
+
+private:
+  Shared& shared;
+  unsigned index;
+  MoveValidator validator;
+  MoveGenerator generator;
+  uint64_t steals = 0;
+  uint64_t hash_hits = 0;
+  size_t current_root = 0;
+
+  bool steal(std::unique_ptr<Task>& task) {
+    size_t count = shared.queues.size();
+    for (size_t offset = 1; offset < count; ++offset) {
+      if (shared.queues[(index + offset) % count].steal(task)) {
+        ++steals;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void execute(Task& task) {
+    current_root = task.root;
+    bool complete = true;
+    shared.root_nodes[task.root] +=
+        count(task.board, task.portals, task.is_white, task.depth, complete);
+  }
+
+  // Kalan kardeş hamleler görev olup kendi kuyruğumuza girer; boştakiler
+  // oradan çalar, sayıları doğrudan kök hamlesine eklenir
+  void split(const ChessBoard& board, const PortalSystem& portals, bool is_white, int depth,
+             const std::vector<CoordinateMove>& moves, size_t first) {
+    shared.pending += moves.size() - first;
+    shared.tasks += moves.size() - first;
+    for (size_t i = first; i < moves.size(); ++i) {
+      auto child =
+          std::make_unique<Task>(Task{board, portals, !is_white, depth - 1, current_root});
+      generator.makeMove(child->board, child->portals, moves[i]);
+      shared.queues[index].push(std::move(child));
+    }
+  }
+
+  // Altında bir bölünme olduysa complete false olur: dönen sayı eksiktir ve
+  // bu düğüm ile tüm ataları tabloya yazılmaz
+  uint64_t count(const ChessBoard& board, PortalSystem& portals, bool is_white, int depth,
+                 bool& complete) {
+    if (depth == 0) {
+      return 1;
+    }
+    uint64_t key = 0;
+    uint64_t nodes = 0;
+    if (shared.table) {
+      key = zobrist::positionKey(board.getHash(), portals.stateHash(), is_white) ^
+            zobrist::mix(static_cast<uint64_t>(depth));
+      if (shared.table->probe(key, nodes)) {
+        ++hash_hits;
+        return nodes;
+      }
+    }
+
+    auto moves = generator.legalMoves(board, portals, is_white);
+    if (depth == 1) {
+      nodes = moves.size();
+    } else {
+      const std::vector<int> saved_cooldowns = portals.getCooldownState();
+      for (size_t i = 0; i < moves.size(); ++i) {
+        // Boşta thread varken büyük alt ağaçlar bölünür; kalan hamleler
+        // görevlerde sayılır
+        if (depth >= shared.split_depth && shared.idle.load(std::memory_order_relaxed) > 0) {
+          split(board, portals, is_white, depth, moves, i);
+          complete = false;
+          return nodes;
+        }
+        ChessBoard next = board;
+        generator.makeMove(next, portals, moves[i]);
+        nodes += count(next, portals, !is_white, depth - 1, complete);
+        portals.setCooldownState(saved_cooldowns);
+      }
+    }
+    if (shared.table && complete) shared.table->store(key, nodes);
+    return nodes;
+  }
+};
+
+} // namespace
+
+Perft::Result Perft::run(const ChessBoard& board, const PortalSystem& portal_system,
+                         bool is_white, int depth, const Options& options) {
+  Result result;
+  result.threads =
+      options.threads > 0 ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+  if (depth <= 0) {
+    result.nodes = 1;
+    return result;
+  }
+
+  MoveValidator validator;
+  validator.setVerbose(false);
+  MoveGenerator generator(validator);
+  ChessBoard root = board;
+  root.setVerbose(false);
+  PortalSystem portals = portal_system;
+  portals.setVerbose(false);
+  auto moves = generator.legalMoves(root, portals, is_white);
+
+  // Süreye tablonun ayrılması girmez
+  std::unique_ptr<LeafTable> table;
+  if (options.hash_mb > 0) table = std::make_unique<LeafTable>(options.hash_mb);
+  auto start = std::chrono::steady_clock::now();
+  Shared shared(result.threads, moves.size());
+  shared.table = table.get();
+  shared.split_depth = std::max(options.split_depth, 2);
+  shared.pending = moves.size();
+  shared.tasks = moves.size();
+
+  // Kök görevleri sırayla dağıtılır; dengesizliği çalma giderir
+  for (size_t i = 0; i < moves.size(); ++i) {
+    auto task = std::make_unique<Task>(Task{root, portals, !is_white, depth - 1, i});
+    generator.makeMove(task->board, task->portals, moves[i]);
+    shared.queues[i % result.threads].push(std::move(task));
+  }
+
+  {
+    std::vector<std::jthread> threads;
+    for (unsigned i = 0; i < result.threads; ++i) {
+      threads.emplace_back([&shared, i] { Worker(shared, i).run(); });
+    }
+  }
+
+  for (size_t i = 0; i < moves.size(); ++i) {
+    uint64_t nodes = shared.root_nodes[i].load();
+    result.divide.push_back({moves[i], nodes});
+    result.nodes += nodes;
+  }
+  result.tasks = shared.tasks;
+  result.steals = shared.steals;
+  result.hash_hits = shared.hash_hits;
+  result.elapsed_ms =
+      std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  return result;
+}
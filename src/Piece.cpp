@@ -1,7 +1,5 @@
 #include "Piece.hpp"
 #include "ConfigReader.hpp"
-#include <vector>
-#include <memory>
 
 // Piece sınıfının kurucu fonksiyonu
 /*Piece::Piece(const std::string& type,
@@ -19,51 +17,12 @@ void Piece::move(int newX, int newY) {
 }
 
 bool Piece::canUsePortal() const {
-    if (special_abilities.custom_abilities.find("portal_master") != special_abilities.custom_abilities.end()) {
-        return special_abilities.custom_abilities.at("portal_master");
-    }
-    return false;
+    return abilities::has(ability_mask, abilities::PortalMaster);
 }
 
 /*std::string Piece::getType() const {
     return type;
 }*/
 
-// ConfigReader'dan gelen taş bilgileriyle Piece nesneleri oluşturur
-std::vector<std::shared_ptr<Piece>> createPiecesFromConfig(const ConfigReader& configReader) {
-    std::vector<std::shared_ptr<Piece>> pieces;
- 
-    // Standart ve özel taş konfigürasyonlarını al
-    auto pieceConfigs = configReader.getConfig().pieces;
-    auto customPieceConfigs = configReader.getConfig().custom_pieces;
-
-    // Standart taşlar
-    for (const auto& pc : pieceConfigs) {
-        for (const auto& colorEntry : pc.positions) {
-            int color = (colorEntry.first == "white") ? 0 : 1;
-            for (const auto& pos : colorEntry.second) {
-                int x = pos.x;
-                int y = pos.y;
-                bool hasMoved = false;
-                auto piecePtr = std::make_shared<Piece>(pc.type, color, x, y, pc.movement, pc.special_abilities, hasMoved);
-                pieces.push_back(piecePtr);
-            }
-        }
-    }
-    // Özel taşlar
-    for (const auto& pc : customPieceConfigs) {
-        for (const auto& colorEntry : pc.positions) {
-            int color = (colorEntry.first == "white") ? 0 : 1;
-            for (const auto& pos : colorEntry.second) {
-                int x = pos.x;
-                int y = pos.y;
-                bool hasMoved = false;
-                auto piecePtr = std::make_shared<Piece>(pc.type, color, x, y, pc.movement, pc.special_abilities, hasMoved);
-                pieces.push_back(piecePtr);
-            }
-        }
-    }
-    return pieces;
-}
-
-
+// Taşların konumu ve tipi ChessBoard'un renk başına taş listelerinde tutulur
+// (ChessBoard::getPieces); tahtadaki her taş için ayrı Piece nesnesi üretilmez.
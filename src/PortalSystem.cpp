@@ -1,21 +1,89 @@
 #include "PortalSystem.hpp"
+#include "Zobrist.hpp"
 #include <algorithm>
+#include <cstdlib>
 #include <iostream>
 
-PortalSystem::PortalSystem(const std::vector<PortalConfig>& portals) : portals_(portals) {
-    for (const auto& portal : portals_) {
-        cooldowns_[portal.id] = 0;
+PortalRules::PortalRules(const std::vector<PortalConfig>& portals) : portals(portals) {
+    for (const auto& portal : portals) {
+        width = std::max({width, portal.positions.entry.x + 1, portal.positions.entry.y + 1});
+    }
+    first_at_entry.assign(static_cast<size_t>(width) * width, -1);
+    next_at_entry.assign(portals.size(), -1);
+    color_masks.assign(portals.size(), 0);
+
+    for (int i = static_cast<int>(portals.size()) - 1; i >= 0; --i) {
+        const auto& portal = portals[i];
+        const auto& colors = portal.properties.allowed_colors;
+        if (std::find(colors.begin(), colors.end(), "white") != colors.end()) color_masks[i] |= 1;
+        if (std::find(colors.begin(), colors.end(), "black") != colors.end()) color_masks[i] |= 2;
+
+        // Sondan başa eklenince zincir config sırasında kalır
+        const Position& entry = portal.positions.entry;
+        if (entry.x >= 0 && entry.y >= 0) {
+            int& head = first_at_entry[static_cast<size_t>(entry.y) * width + entry.x];
+            next_at_entry[i] = head;
+            head = i;
+        }
+    }
+
+    passage_at_entry.assign(first_at_entry.size(), -1);
+    for (const auto& portal : portals) {
+        const Position& entry = portal.positions.entry;
+        if (!portal.properties.preserve_direction || entry.x < 0 || entry.y < 0) continue;
+        int& passage = passage_at_entry[static_cast<size_t>(entry.y) * width + entry.x];
+        if (passage < 0) {
+            passage = static_cast<int>(passage_entries.size());
+            passage_entries.push_back(entry);
+        }
+    }
+
+    for (const auto& portal : portals) {
+        auto it = std::find(slot_ids.begin(), slot_ids.end(), portal.id);
+        if (it == slot_ids.end()) {
+            slots.push_back(static_cast<int>(slot_ids.size()));
+            slot_ids.push_back(portal.id);
+            slot_hashes.push_back(zobrist::fnv1a(portal.id));
+        } else {
+            slots.push_back(static_cast<int>(it - slot_ids.begin()));
+        }
     }
 }
 
-bool PortalSystem::isPortalMove(const Position& start, const Position& end) const {
-    for (const auto& portal : portals_) {
-        if (start.x == portal.positions.entry.x && start.y == portal.positions.entry.y &&
-            end.x == portal.positions.exit.x && end.y == portal.positions.exit.y) {
-            return true;
+int PortalRules::firstAt(const Position& entry) const {
+    if (entry.x < 0 || entry.y < 0 || entry.x >= width || entry.y >= width) {
+        return -1;
+    }
+    return first_at_entry[static_cast<size_t>(entry.y) * width + entry.x];
+}
+
+int PortalRules::passageSlotAt(const Position& entry) const {
+    if (entry.x < 0 || entry.y < 0 || entry.x >= width || entry.y >= width) {
+        return -1;
+    }
+    return passage_at_entry[static_cast<size_t>(entry.y) * width + entry.x];
+}
+
+int PortalRules::find(const Position& entry, const Position& exit) const {
+    for (int i = firstAt(entry); i >= 0; i = next_at_entry[i]) {
+        const Position& portal_exit = portals[i].positions.exit;
+        if (portal_exit.x == exit.x && portal_exit.y == exit.y) {
+            return i;
         }
     }
-    return false;
+    return -1;
+}
+
+PortalSystem::PortalSystem(std::shared_ptr<const PortalRules> rules)
+    : rules_(std::move(rules)), cooldowns_(rules_->slot_ids.size(), 0) {
+    refreshPassages();
+}
+
+PortalSystem::PortalSystem(const std::vector<PortalConfig>& portals)
+    : PortalSystem(std::make_shared<const PortalRules>(portals)) {}
+
+bool PortalSystem::isPortalMove(const Position& start, const Position& end) const {
+    return rules_->find(start, end) >= 0;
 }
 
 bool PortalSystem::validatePortalMove(const std::string& piece, const Position& start, 
@@ -26,107 +94,172 @@ bool PortalSystem::validatePortalMove(const std::string& piece, const Position&
         return false;
     }
 
-    for (const auto& portal : portals_) {
-        if (start.x == portal.positions.entry.x && start.y == portal.positions.entry.y &&
-            end.x == portal.positions.exit.x && end.y == portal.positions.exit.y) {
-            
-            // Önce cooldown kontrolü
-            if (isPortalInCooldown(start, end)) {
-                return false;
-            }
-            
-            // Renklere göre kurallara bkıyor
-            std::string color = is_white_turn ? "white" : "black";
-            auto it = std::find(portal.properties.allowed_colors.begin(), 
-                               portal.properties.allowed_colors.end(), color);
-            if (it == portal.properties.allowed_colors.end()) {
-                std::cout << "\nPortal Hatası: Bu portal " << color << " taşlar için kullanılamaz!" << std::endl;
-                return false;
-            }
-            
-            return true;
-        }
+    int portal = rules_->find(start, end);
+    if (portal < 0) {
+        return false;
     }
-    return false;
+
+    // Önce cooldown kontrolü
+    if (isPortalInCooldown(start, end)) {
+        return false;
+    }
+
+    // Renklere göre kurallara bkıyor
+    if (!rules_->allows(portal, is_white_turn)) {
+        if (verbose) std::cout << "\nPortal Hatası: Bu portal " << (is_white_turn ? "white" : "black")
+                               << " taşlar için kullanılamaz!" << std::endl;
+        return false;
+    }
+    return true;
 }
 
 void PortalSystem::handlePortalMove(const Position& start, const Position& end, ChessBoard& board) {
-    for (const auto& portal : portals_) {
-        if (start.x == portal.positions.entry.x && start.y == portal.positions.entry.y &&
-            end.x == portal.positions.exit.x && end.y == portal.positions.exit.y) {
-            auto square = board.getSquare(start);
-            if (!square.is_empty()) {
-                board.placePiece(square.piece, square.is_white, end.x, end.y);
-                board.placePiece("", false, start.x, start.y);
-                
-                // cooldown sayısı
-                cooldowns_[portal.id] = portal.properties.cooldown;
-                
-                //queueya ekliyor
-                for (int i = 0; i < portal.properties.cooldown; i++) {
-                    cooldown_queue_.push(portal.id);
-                }
+    int portal = rules_->find(start, end);
+    if (portal < 0) {
+        return;
+    }
+    auto square = board.getSquare(start);
+    if (!square.is_empty()) {
+        board.placePiece(square.piece, square.is_white, end.x, end.y);
+        board.placePiece("", false, start.x, start.y);
 
-                /*
-                std::cout << "\n--- Portal Kullanıldı ---";
-                std::cout << "\nPortal: " << portal.id;
-                std::cout << "\nCooldown: " << cooldowns_[portal.id] << " tur";
-                std::cout << "\nDurum: Bu portal " << cooldowns_[portal.id] 
-                         << " tur boyunca hiçbir taş tarafından kullanılamaz.";
-                std::cout << "\nGiriş: (" << start.x << "," << start.y << ")";
-                std::cout << "\nÇıkış: (" << end.x << "," << end.y << ")" << std::endl;*/
+        // cooldown sayısı
+        startCooldown(portal);
+    }
+}
+
+void PortalSystem::startCooldown(int portal) {
+    cooldowns_[rules_->slots[portal]] = rules_->portals[portal].properties.cooldown;
+    refreshPassages();
+}
+
+// Her geçiş girişi için config sırasıyla ilk açık (cooldown'da olmayan, rengin
+// kullanabildiği) preserve_direction'lı portal
+void PortalSystem::refreshPassages() {
+    passages_.assign(rules_->passage_entries.size() * 2, -1);
+    open_passages_[0] = open_passages_[1] = 0;
+    for (size_t passage = 0; passage < rules_->passage_entries.size(); ++passage) {
+        for (int color = 0; color < 2; ++color) {
+            for (int i = rules_->firstAt(rules_->passage_entries[passage]); i >= 0;
+                 i = rules_->next_at_entry[i]) {
+                if (rules_->portals[i].properties.preserve_direction &&
+                    cooldowns_[rules_->slots[i]] == 0 && rules_->allows(i, color == 1)) {
+                    passages_[passage * 2 + color] = i;
+                    ++open_passages_[color];
+                    break;
+                }
             }
-            break;
         }
     }
 }
 
+int PortalSystem::passageAt(const Position& entry, bool is_white) const {
+    int passage = rules_->passageSlotAt(entry);
+    return passage < 0 ? -1 : passages_[passage * 2 + (is_white ? 1 : 0)];
+}
+
+bool PortalSystem::passageMayReach(const Position& target, bool is_white) const {
+    for (size_t i = 0; i < rules_->portals.size(); ++i) {
+        const PortalConfig& portal = rules_->portals[i];
+        if (!portal.properties.preserve_direction || !rules_->allows(static_cast<int>(i), is_white)) {
+            continue;
+        }
+        int dx = target.x - portal.positions.exit.x;
+        int dy = target.y - portal.positions.exit.y;
+        if ((dx != 0 || dy != 0) && (dx == 0 || dy == 0 || std::abs(dx) == std::abs(dy))) {
+            return true;
+        }
+    }
+    return false;
+}
+
 bool PortalSystem::isPortalInCooldown(const Position& start, const Position& end) const {
-    for (const auto& portal : portals_) {
-        if (start.x == portal.positions.entry.x && start.y == portal.positions.entry.y &&
-            end.x == portal.positions.exit.x && end.y == portal.positions.exit.y) {
-            auto cooldown_it = cooldowns_.find(portal.id);
-            if (cooldown_it != cooldowns_.end() && cooldown_it->second > 0) {
-                std::cout << "\nPortal " << portal.id << "cooldownda! "
-                          << "Kalan tur: " << cooldown_it->second << " tur" << std::endl;
-                std::cout << "Bu portal şu anda hiçbir taş tarafından kullanılamaz." << std::endl;
-                return true;
-            }
-            return false;
+    int portal = rules_->find(start, end);
+    if (portal < 0) {
+        return false;
+    }
+    int remaining = cooldownOf(portal);
+    if (remaining > 0) {
+        if (verbose) {
+            std::cout << "\nPortal " << rules_->portals[portal].id << "cooldownda! "
+                      << "Kalan tur: " << remaining << " tur" << std::endl;
+            std::cout << "Bu portal şu anda hiçbir taş tarafından kullanılamaz." << std::endl;
         }
+        return true;
     }
     return false;
 }
 
-void PortalSystem::updateCooldowns() {
-    if (cooldown_queue_.empty()) {
-        return;
+const PortalConfig* PortalSystem::activePortalAt(const Position& entry, bool is_white) const {
+    for (int i = rules_->firstAt(entry); i >= 0; i = rules_->next_at_entry[i]) {
+        if (cooldowns_[rules_->slots[i]] == 0 && rules_->allows(i, is_white)) {
+            return &rules_->portals[i];
+        }
     }
+    return nullptr;
+}
 
-    // Her turda bir portal'ın cooldown'ını azalt
-    std::string portal_id = cooldown_queue_.front();
-    cooldown_queue_.pop();
-    
-    auto it = cooldowns_.find(portal_id);
-    if (it != cooldowns_.end() && it->second > 0) {
-        it->second--;
-        if (it->second == 0) {
-            std::cout << "\nPortal " << portal_id << " artık kullanıma hazır!" << std::endl;
+uint64_t PortalSystem::stateHash() const {
+    uint64_t hash = 0;
+    for (size_t slot = 0; slot < cooldowns_.size(); ++slot) {
+        if (cooldowns_[slot] > 0) {
+            hash ^= zobrist::mix(rules_->slot_hashes[slot] + static_cast<uint64_t>(cooldowns_[slot]));
+        }
+    }
+    return hash;
+}
+
+std::vector<int> PortalSystem::getCooldownState() const {
+    std::vector<int> state;
+    state.reserve(rules_->slots.size());
+    for (int slot : rules_->slots) {
+        state.push_back(cooldowns_[slot]);
+    }
+    return state;
+}
+
+void PortalSystem::setCooldownState(const std::vector<int>& state) {
+    for (size_t i = 0; i < rules_->slots.size() && i < state.size(); ++i) {
+        cooldowns_[rules_->slots[i]] = state[i];
+    }
+    refreshPassages();
+}
+
+void PortalSystem::updateCooldowns() {
+    // Her turda cooldown'daki tüm portallar birer azalır; portallar birbirini
+    // beklemez, böylece durum portal başına bir sayaçla tam tanımlanır
+    bool reopened = false;
+    for (size_t slot = 0; slot < cooldowns_.size(); ++slot) {
+        if (cooldowns_[slot] > 0) {
+            cooldowns_[slot]--;
+            if (cooldowns_[slot] == 0) {
+                reopened = true;
+                if (verbose) {
+                    std::cout << "\nPortal " << rules_->slot_ids[slot] << " artık kullanıma hazır!" << std::endl;
+                }
+            }
         }
     }
+    if (reopened) {
+        refreshPassages();
+    }
     
     // Cooldown durumlarını göster
+    if (!verbose) {
+        return;
+    }
     bool has_cooldowns = false;
-    for (const auto& pair : cooldowns_) {
-        if (pair.second > 0) {
+    for (size_t slot = 0; slot < cooldowns_.size(); ++slot) {
+        if (cooldowns_[slot] > 0) {
             if (!has_cooldowns) {
                 std::cout << "\n--- PORTAL COOLDOWN DURUMLARI ---";
                 has_cooldowns = true;
             }
-            std::cout << "\n" << pair.first << " -> Kalan bekleme süresi: " << pair.second << " tur";
+            std::cout << "\n" << rules_->slot_ids[slot] << " -> Kalan bekleme süresi: "
+                      << cooldowns_[slot] << " tur";
         }
     }
     if (has_cooldowns) {
         std::cout << "\n!!" << std::endl;
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,117 @@
+// PositionParser.cpp
+#include "PositionParser.hpp"
+#include "BoardRenderer.hpp"
+#include "MoveGenerator.hpp"
+#include "MoveNotation.hpp"
+#include "MoveValidator.hpp"
+#include <cctype>
+#include <sstream>
+
+PositionParser::PositionParser(const GameConfig& config,
+                               std::shared_ptr<const Evaluation> evaluation,
+                               std::shared_ptr<const NnueNetwork> network)
+    : board_size(config.game_settings.board_size), evaluation(std::move(evaluation)),
+      network(std::move(network)),
+      portal_rules(std::make_shared<const PortalRules>(config.portals)),
+      initial_board(config.game_settings.board_size) {
+  std::vector<PieceConfig> all_pieces = config.pieces;
+  all_pieces.insert(all_pieces.end(), config.custom_pieces.begin(), config.custom_pieces.end());
+  initial_board.initializeBoard(all_pieces);
+  initial_board.setVerbose(false);
+  initial_board.attachEvaluation(this->evaluation);
+  initial_board.attachNetwork(this->network);
+
+  // Dizilim harfleri tahta çizicisinin sembolleriyle aynı
+  BoardRenderer renderer(BoardRenderer::Mode::None);
+  renderer.registerPieceTypes(config);
+  for (const auto& piece : all_pieces) {
+    symbol_types.emplace(renderer.symbolFor(piece.type)[0], piece.type);
+  }
+  // Çizici atı A ile gösterir; FEN'den gelen N de ata eşlenir (boşsa)
+  for (const auto& piece : all_pieces) {
+    std::string lower = piece.type;
+    for (char& c : lower) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    if (lower == "knight") symbol_types.emplace('N', piece.type);
+  }
+}
+
+bool PositionParser::parse(const std::string& line, Setup& setup, std::string& error) const {
+  int size = board_size;
+  std::istringstream iss(line);
+  std::string token;
+  iss >> token;
+
+  setup.portals.emplace(portal_rules);
+  setup.portals->setVerbose(false);
+  setup.is_white = true;
+
+  if (token == "board") {
+    std::string placement, side;
+    if (!(iss >> placement >> side) || (side != "w" && side != "b")) {
+      error = "board satırı: dizilim ve sıra (w/b) bekleniyor";
+      return false;
+    }
+    setup.board.emplace(size, initial_board.getTypes());
+    setup.board->setVerbose(false);
+    setup.board->attachEvaluation(evaluation);
+    setup.board->attachNetwork(network);
+    int x = 0, y = size - 1;
+    for (size_t i = 0; i < placement.size(); ++i) {
+      char c = placement[i];
+      if (c == '/') {
+        if (x != size) break;
+        x = 0;
+        --y;
+      } else if (std::isdigit(static_cast<unsigned char>(c))) {
+        int run = 0;
+        while (i < placement.size() && std::isdigit(static_cast<unsigned char>(placement[i]))) {
+          run = run * 10 + (placement[i++] - '0');
+        }
+        --i;
+        x += run;
+      } else {
+        auto it = symbol_types.find(static_cast<char>(std::toupper(static_cast<unsigned char>(c))));
+        if (it == symbol_types.end() || x >= size || y < 0) {
+          error = std::string("dizilimde tanınmayan taş veya taşan sıra: ") + c;
+          return false;
+        }
+        setup.board->placePiece(it->second, std::isupper(static_cast<unsigned char>(c)), x, y);
+        ++x;
+      }
+      if (x > size) break;
+    }
+    if (x != size || y != 0) {
+      error = "dizilim " + std::to_string(size) + "x" + std::to_string(size) + " tahtayı doldurmuyor";
+      return false;
+    }
+    setup.is_white = side == "w";
+    token.clear();
+  } else {
+    setup.board.emplace(initial_board);
+    if (token == "startpos") token.clear();
+  }
+
+  // Kalan belirteçler pozisyondan oynanacak hamleler
+  MoveValidator validator;
+  validator.setVerbose(false);
+  MoveGenerator generator(validator);
+  do {
+    if (token.empty()) continue;
+    CoordinateMove move;
+    if (!parseCoordinateMove(token, size, move)) {
+      error = "hamle okunamadı: " + token;
+      return false;
+    }
+    const auto& square = setup.board->getSquare(move.from);
+    if (square.is_empty() || square.is_white != setup.is_white) {
+      error = "geçersiz hamle: " + token;
+      return false;
+    }
+    if (!generator.tryMakeMove(*setup.board, *setup.portals, move)) {
+      error = "geçersiz hamle: " + token;
+      return false;
+    }
+    setup.is_white = !setup.is_white;
+  } while (iss >> token);
+  return true;
+}
@@ -0,0 +1,245 @@
+// RayScan.cpp
+#include "RayScan.hpp"
+#include "RayCache.hpp"
+#include <algorithm>
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define RAY_SCAN_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+constexpr int kDirX[8] = {0, 0, 1, -1, 1, 1, -1, -1};
+constexpr int kDirY[8] = {1, -1, 0, 0, 1, -1, 1, -1};
+constexpr int kBishopDirs[] = {4, 5, 6, 7};
+constexpr int kRookDirs[] = {0, 1, 2, 3};
+constexpr int kQueenDirs[] = {0, 1, 2, 3, 4, 5, 6, 7};
+
+} // namespace
+
+RayTable::RayTable(int size) : board_size(size) {
+  size_t bytes = static_cast<size_t>(size + 4) * kStride;
+  occupied.assign(bytes, 0);
+  on_board.assign(bytes, 0);
+  for (auto& table : lengths) table.assign(bytes, 0);
+  for (int y = 0; y < size; ++y) {
+    std::memset(&on_board[rowOffset(y)], 0xFF, static_cast<size_t>(size));
+  }
+}
+
+bool RayTable::avx2Available() {
+#ifdef RAY_SCAN_X86
+  return __builtin_cpu_supports("avx2");
+#else
+  return false;
+#endif
+}
+
+RayTable::Backend RayTable::defaultBackend() {
+  static const Backend backend = avx2Available() ? Backend::Avx2 : Backend::Scalar;
+  return backend;
+}
+
+void RayTable::compute(const ChessBoard& board) { compute(board, defaultBackend()); }
+
+void RayTable::compute(const ChessBoard& board, Backend backend) {
+  fillOccupancy(board);
+  if (backend == Backend::Avx2 && avx2Available()) {
+    computeAvx2();
+  } else {
+    computeScalar();
+  }
+}
+
+// Taş listelerinden: tahta alanı değil taş sayısı kadar yazma
+void RayTable::fillOccupancy(const ChessBoard& board) {
+  std::fill(occupied.begin(), occupied.end(), 0);
+  for (bool is_white : {true, false}) {
+    const auto& pieces = board.getPieces(is_white);
+    for (int square : pieces.squares) {
+      int x = square % board_size, y = square / board_size;
+      occupied[rowOffset(y) + x] = 0xFF;
+    }
+  }
+}
+
+// Komşu kare t için: tahta dışı 0, dolu 1, boş 1 + t'nin uzunluğu
+void RayTable::computeScalar() {
+  const int n = board_size;
+  for (int dir = 0; dir < 8; ++dir) {
+    const int dx = kDirX[dir], dy = kDirY[dir];
+    uint8_t* len = lengths[dir].data();
+    if (dy != 0) {
+      // Satırlar bağımlılık sırasıyla: dy=+1 ise yukarıdan aşağı
+      for (int i = 0; i < n; ++i) {
+        int y = dy > 0 ? n - 1 - i : i;
+        size_t row = rowOffset(y);
+        size_t next = rowOffset(y + dy);
+        for (int x = 0; x < kStride; ++x) {
+          int tx = x + dx;
+          uint8_t value = 0;
+          if (on_board[row + x] && tx >= 0 && tx < kStride && on_board[next + tx]) {
+            value = occupied[next + tx] ? 1 : static_cast<uint8_t>(1 + len[next + tx]);
+          }
+          len[row + x] = value;
+        }
+      }
+    } else {
+      for (int y = 0; y < n; ++y) {
+        size_t row = rowOffset(y);
+        int x = dx > 0 ? n - 1 : 0;
+        for (int i = 0; i < n; ++i, x -= dx) {
+          int tx = x + dx;
+          uint8_t value = 0;
+          if (tx >= 0 && tx < n) {
+            value = occupied[row + tx] ? 1 : static_cast<uint8_t>(1 + len[row + tx]);
+          }
+          len[row + x] = value;
+        }
+      }
+    }
+  }
+}
+
+#ifdef RAY_SCAN_X86
+
+namespace {
+
+// w[x] = w[x + K], üst şeritler fill ile dolar
+template <int K>
+__attribute__((target("avx2"))) inline __m256i shiftDown(__m256i w, __m256i fill) {
+  __m256i upper = _mm256_permute2x128_si256(w, fill, 0x21);
+  if constexpr (K == 16) {
+    return upper;
+  } else {
+    return _mm256_alignr_epi8(upper, w, K);
+  }
+}
+
+// w[x] = w[x - K], alt şeritler fill ile dolar
+template <int K>
+__attribute__((target("avx2"))) inline __m256i shiftUp(__m256i w, __m256i fill) {
+  __m256i lower = _mm256_permute2x128_si256(w, fill, 0x02);
+  if constexpr (K == 16) {
+    return lower;
+  } else {
+    return _mm256_alignr_epi8(w, lower, 16 - K);
+  }
+}
+
+__attribute__((target("avx2"))) inline __m256i load(const uint8_t* p) {
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+}
+
+__attribute__((target("avx2"))) inline void store(uint8_t* p, __m256i v) {
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+}
+
+} // namespace
+
+__attribute__((target("avx2"))) void RayTable::computeAvx2() {
+  const int n = board_size;
+  const __m256i one = _mm256_set1_epi8(1);
+  const __m256i none = _mm256_set1_epi8(static_cast<char>(0xFF));
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i iota = _mm256_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+                                        16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29,
+                                        30, 31);
+  const __m256i last = _mm256_set1_epi8(static_cast<char>(n - 1));
+
+  // Dikey ve çapraz yönler: bir satırın 32 karesi tek adımda, bağımlı satırdan
+  for (int dir : {0, 1, 4, 5, 6, 7}) {
+    const int dx = kDirX[dir], dy = kDirY[dir];
+    uint8_t* len = lengths[dir].data();
+    for (int i = 0; i < n; ++i) {
+      int y = dy > 0 ? n - 1 - i : i;
+      size_t row = rowOffset(y);
+      size_t next = rowOffset(y + dy) + dx;
+      __m256i next_len = load(len + next);
+      __m256i next_occ = load(occupied.data() + next);
+      __m256i next_in = load(on_board.data() + next);
+      __m256i value = _mm256_blendv_epi8(_mm256_add_epi8(next_len, one), one, next_occ);
+      value = _mm256_and_si256(value, _mm256_and_si256(next_in, load(on_board.data() + row)));
+      store(len + row, value);
+    }
+  }
+
+  // Yatay yönler: satır içi önek taraması (en yakın engelin sütunu)
+  for (int y = 0; y < n; ++y) {
+    size_t row = rowOffset(y);
+    __m256i occ = load(occupied.data() + row);
+    __m256i in = load(on_board.data() + row);
+
+    // Doğu: x'ten büyük ilk dolu sütun; yoksa 0xFF
+    __m256i east = _mm256_blendv_epi8(none, iota, occ);
+    east = shiftDown<1>(east, none);
+    east = _mm256_min_epu8(east, shiftDown<1>(east, none));
+    east = _mm256_min_epu8(east, shiftDown<2>(east, none));
+    east = _mm256_min_epu8(east, shiftDown<4>(east, none));
+    east = _mm256_min_epu8(east, shiftDown<8>(east, none));
+    east = _mm256_min_epu8(east, shiftDown<16>(east, none));
+    __m256i to_edge = _mm256_sub_epi8(last, iota);
+    __m256i to_blocker = _mm256_sub_epi8(east, iota);
+    __m256i east_len = _mm256_blendv_epi8(to_blocker, to_edge, _mm256_cmpeq_epi8(east, none));
+    store(lengths[2].data() + row, _mm256_and_si256(east_len, in));
+
+    // Batı: x'ten küçük son dolu sütun + 1; yoksa 0
+    __m256i west = _mm256_and_si256(_mm256_add_epi8(iota, one), occ);
+    west = shiftUp<1>(west, zero);
+    west = _mm256_max_epu8(west, shiftUp<1>(west, zero));
+    west = _mm256_max_epu8(west, shiftUp<2>(west, zero));
+    west = _mm256_max_epu8(west, shiftUp<4>(west, zero));
+    west = _mm256_max_epu8(west, shiftUp<8>(west, zero));
+    west = _mm256_max_epu8(west, shiftUp<16>(west, zero));
+    __m256i west_blocker = _mm256_add_epi8(_mm256_sub_epi8(iota, west), one);
+    __m256i west_len = _mm256_blendv_epi8(west_blocker, iota, _mm256_cmpeq_epi8(west, zero));
+    store(lengths[3].data() + row, _mm256_and_si256(west_len, in));
+  }
+}
+
+#else
+
+void RayTable::computeAvx2() { computeScalar(); }
+
+#endif
+
+void RayTable::appendSliderEdges(PieceKind kind, const Position& pos,
+                                 std::vector<Position>& edges) const {
+  auto slide = [&](const auto& dirs) {
+    for (int dir : dirs) {
+      int count = length(pos.x, pos.y, dir);
+      for (int i = 1; i <= count; ++i) {
+        edges.push_back({pos.x + i * kDirX[dir], pos.y + i * kDirY[dir]});
+      }
+    }
+  };
+  if (kind == PieceKind::Bishop) {
+    slide(kBishopDirs);
+  } else if (kind == PieceKind::Rook) {
+    slide(kRookDirs);
+  } else if (kind == PieceKind::Queen) {
+    slide(kQueenDirs);
+  }
+}
+
+RayCache::RayCache() = default;
+RayCache::RayCache(const RayCache&) {}
+RayCache& RayCache::operator=(const RayCache&) {
+  valid = false;
+  return *this;
+}
+RayCache::~RayCache() = default;
+
+const RayTable& RayCache::get(const ChessBoard& board) {
+  if (!table || table->getBoardSize() != board.getBoardSize()) {
+    table = std::make_unique<RayTable>(board.getBoardSize());
+    valid = false;
+  }
+  if (!valid) {
+    table->compute(board);
+    valid = true;
+  }
+  return *table;
+}
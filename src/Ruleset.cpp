@@ -0,0 +1,229 @@
+// Ruleset.cpp
+#include "Ruleset.hpp"
+#include <algorithm>
+#include <iostream>
+#include <map>
+
+namespace {
+
+bool samePosition(const Position& a, const Position& b) {
+  return a.x == b.x && a.y == b.y;
+}
+
+bool samePositions(const std::unordered_map<std::string, std::vector<Position>>& a,
+                   const std::unordered_map<std::string, std::vector<Position>>& b) {
+  if (a.size() != b.size()) return false;
+  for (const auto& [color, list] : a) {
+    auto it = b.find(color);
+    if (it == b.end() || !std::equal(list.begin(), list.end(), it->second.begin(),
+                                     it->second.end(), samePosition)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool sameMovement(const Movement& a, const Movement& b) {
+  return a.forward == b.forward && a.sideways == b.sideways && a.diagonal == b.diagonal &&
+         a.l_shape == b.l_shape && a.diagonal_capture == b.diagonal_capture &&
+         a.first_move_forward == b.first_move_forward;
+}
+
+bool sameAbilities(const SpecialAbilities& a, const SpecialAbilities& b) {
+  return a.castling == b.castling && a.royal == b.royal && a.jump_over == b.jump_over &&
+         a.promotion == b.promotion && a.en_passant == b.en_passant &&
+         a.custom_abilities == b.custom_abilities;
+}
+
+bool sameEvaluation(const PieceEvaluation& a, const PieceEvaluation& b) {
+  return a.has_value == b.has_value && a.value == b.value &&
+         a.piece_square_table == b.piece_square_table;
+}
+
+bool samePortal(const PortalConfig& a, const PortalConfig& b) {
+  return a.type == b.type && samePosition(a.positions.entry, b.positions.entry) &&
+         samePosition(a.positions.exit, b.positions.exit) &&
+         a.properties.preserve_direction == b.properties.preserve_direction &&
+         a.properties.allowed_colors == b.properties.allowed_colors &&
+         a.properties.cooldown == b.properties.cooldown;
+}
+
+// Evaluation ile aynı kural: aynı tip iki kez geçerse ilki geçerli
+std::map<std::string, const PieceConfig*> piecesByType(const GameConfig& config) {
+  std::map<std::string, const PieceConfig*> pieces;
+  for (const auto* list : {&config.pieces, &config.custom_pieces}) {
+    for (const auto& piece : *list) {
+      pieces.emplace(piece.type, &piece);
+    }
+  }
+  return pieces;
+}
+
+std::map<std::string, const PortalConfig*> portalsById(const GameConfig& config) {
+  std::map<std::string, const PortalConfig*> portals;
+  for (const auto& portal : config.portals) {
+    portals.emplace(portal.id, &portal);
+  }
+  return portals;
+}
+
+std::shared_ptr<const ChessBoard::TypeTable> buildTypeTable(const GameConfig& config) {
+  auto table = std::make_shared<ChessBoard::TypeTable>();
+  for (const auto* list : {&config.pieces, &config.custom_pieces}) {
+    for (const auto& piece : *list) {
+      table->add(piece.type, piece.special_abilities.mask);
+    }
+  }
+  return table;
+}
+
+// Ağ yüklenemezse oyun el yapımı değerlendirmeyle sürer
+std::shared_ptr<const NnueNetwork> loadNetwork(const GameConfig& config) {
+  if (config.evaluation.nnue_file.empty()) return nullptr;
+  std::string error;
+  auto network =
+      NnueNetwork::open(config.evaluation.nnue_file, config.game_settings.board_size, error);
+  if (!network) {
+    std::cerr << error << " (tablo değerlendirmesi kullanılıyor)" << std::endl;
+  }
+  return network;
+}
+
+void appendList(std::string& text, const char* label, const std::vector<std::string>& names) {
+  if (names.empty()) return;
+  if (!text.empty()) text += "; ";
+  text += label;
+  for (size_t i = 0; i < names.size(); ++i) {
+    text += (i == 0 ? " " : ", ") + names[i];
+  }
+}
+
+} // namespace
+
+bool ConfigDiff::empty() const {
+  return !full_rebuild && !settings_changed && pieces.empty() && portals.empty();
+}
+
+std::string ConfigDiff::summary() const {
+  std::string text;
+  if (full_rebuild) text = "tüm tablolar";
+  if (settings_changed) text += text.empty() ? "oyun ayarları" : "; oyun ayarları";
+  appendList(text, "taşlar:", pieces);
+  appendList(text, "portallar:", portals);
+  return text.empty() ? "değişiklik yok" : text;
+}
+
+ConfigDiff diffConfigs(const GameConfig& before, const GameConfig& after) {
+  ConfigDiff diff;
+  diff.full_rebuild =
+      before.game_settings.board_size != after.game_settings.board_size ||
+      before.evaluation.portal_entry_bonus != after.evaluation.portal_entry_bonus ||
+      before.evaluation.portal_exit_bonus != after.evaluation.portal_exit_bonus ||
+      before.evaluation.nnue_file != after.evaluation.nnue_file;
+  diff.settings_changed = before.game_settings.name != after.game_settings.name ||
+                          before.game_settings.turn_limit != after.game_settings.turn_limit;
+
+  auto old_pieces = piecesByType(before);
+  auto new_pieces = piecesByType(after);
+  for (const auto& [type, piece] : new_pieces) {
+    auto it = old_pieces.find(type);
+    if (it == old_pieces.end()) {
+      diff.pieces.push_back(type);
+      diff.piece_tables.push_back(type);
+      continue;
+    }
+    const PieceConfig& old = *it->second;
+    bool tables = !sameEvaluation(old.evaluation, piece->evaluation);
+    if (tables || old.count != piece->count || !samePositions(old.positions, piece->positions) ||
+        !sameMovement(old.movement, piece->movement) ||
+        !sameAbilities(old.special_abilities, piece->special_abilities)) {
+      diff.pieces.push_back(type);
+    }
+    if (tables) diff.piece_tables.push_back(type);
+  }
+  for (const auto& [type, piece] : old_pieces) {
+    if (new_pieces.find(type) == new_pieces.end()) {
+      diff.pieces.push_back(type);
+      diff.piece_tables.push_back(type);
+    }
+  }
+
+  auto old_portals = portalsById(before);
+  auto new_portals = portalsById(after);
+  for (const auto& [id, portal] : new_portals) {
+    auto it = old_portals.find(id);
+    if (it == old_portals.end() || !samePortal(*it->second, *portal)) {
+      diff.portals.push_back(id);
+    }
+  }
+  for (const auto& [id, portal] : old_portals) {
+    if (new_portals.find(id) == new_portals.end()) {
+      diff.portals.push_back(id);
+    }
+  }
+  return diff;
+}
+
+ChessBoard Ruleset::createBoard(const std::string& display_format) const {
+  // Özel taşlar da tahtaya yerleşir
+  std::vector<PieceConfig> all_pieces = config.pieces;
+  all_pieces.insert(all_pieces.end(), config.custom_pieces.begin(), config.custom_pieces.end());
+  ChessBoard board(config.game_settings.board_size, piece_types, display_format);
+  board.initializeBoard(all_pieces);
+  board.attachEvaluation(evaluation);
+  board.attachNetwork(network);
+  return board;
+}
+
+std::shared_ptr<const Ruleset> Ruleset::create(GameConfig config) {
+  auto ruleset = std::make_shared<Ruleset>();
+  ruleset->evaluation = std::make_shared<const Evaluation>(config);
+  ruleset->piece_types = buildTypeTable(config);
+  ruleset->portal_rules = std::make_shared<const PortalRules>(config.portals);
+  ruleset->network = loadNetwork(config);
+  ruleset->config = std::move(config);
+  return ruleset;
+}
+
+std::shared_ptr<const Ruleset> Ruleset::update(const Ruleset& live, GameConfig config,
+                                               const ConfigDiff& diff) {
+  auto ruleset = std::make_shared<Ruleset>();
+  ruleset->generation = live.generation + 1;
+  if (diff.full_rebuild) {
+    ruleset->evaluation = std::make_shared<const Evaluation>(config);
+  } else if (diff.piece_tables.empty() && diff.portals.empty()) {
+    // Değerlendirmeyi etkileyen bir şey yok: tablolar paylaşılır
+    ruleset->evaluation = live.evaluation;
+  } else {
+    auto evaluation = std::make_shared<Evaluation>(*live.evaluation);
+    auto old_portals = portalsById(live.config);
+    auto new_portals = portalsById(config);
+    for (const auto& id : diff.portals) {
+      auto before = old_portals.find(id);
+      auto after = new_portals.find(id);
+      evaluation->updatePortal(before != old_portals.end() ? before->second : nullptr,
+                               after != new_portals.end() ? after->second : nullptr);
+    }
+    // Portal bonusları güncellendikten sonra: yeni tablolar güncel bonusla kurulur
+    auto new_pieces = piecesByType(config);
+    for (const auto& type : diff.piece_tables) {
+      auto it = new_pieces.find(type);
+      if (it != new_pieces.end()) {
+        evaluation->updatePieceType(*it->second);
+      } else {
+        // Kaldırılan tip varsayılan değerine döner (terfi taşları için gerekli)
+        PieceConfig removed;
+        removed.type = type;
+        evaluation->updatePieceType(removed);
+      }
+    }
+    ruleset->evaluation = std::move(evaluation);
+  }
+  ruleset->piece_types = diff.pieces.empty() ? live.piece_types : buildTypeTable(config);
+  ruleset->portal_rules = diff.portals.empty() ? live.portal_rules
+                                               : std::make_shared<const PortalRules>(config.portals);
+  // Ağ dosyası değişmediyse eşlenmiş ağırlıklar paylaşılır
+  ruleset->network = diff.full_rebuild ? loadNetwork(config) : live.network;
+  ruleset->config = std::move(config);
+  return ruleset;
+}
@@ -0,0 +1,133 @@
+// Search.cpp
+#include "Search.hpp"
+#include <algorithm>
+
+Search::Search(const Evaluation& evaluation, MoveValidator& validator)
+    : evaluation(evaluation), generator(validator), ordering(evaluation) {}
+
+SearchResult Search::search(const ChessBoard& board, PortalSystem& portal_system, bool is_white,
+                            int depth) {
+  SearchResult result;
+  nodes = 0;
+  aborted = false;
+  limits = nullptr;
+  root_hint = CoordinateMove{{-1, -1}, {-1, -1}, 0};
+  result.score = negamax(board, portal_system, is_white, depth, 0, -kMateScore - 1,
+                         kMateScore + 1, &result.best_move);
+  result.nodes = nodes;
+  result.depth = depth;
+  result.has_move = result.best_move.from.x >= 0;
+  return result;
+}
+
+SearchResult Search::iterate(const ChessBoard& board, PortalSystem& portal_system, bool is_white,
+                             const SearchLimits& search_limits,
+                             const std::function<void(const SearchResult&)>& on_depth) {
+  SearchResult best;
+  nodes = 0;
+  aborted = false;
+  limits = &search_limits;
+  root_hint = search_limits.hint;
+
+  for (int depth = std::max(1, search_limits.start_depth); depth <= search_limits.max_depth;
+       ++depth) {
+    CoordinateMove move{{-1, -1}, {-1, -1}, 0};
+    int score = negamax(board, portal_system, is_white, depth, 0, -kMateScore - 1,
+                        kMateScore + 1, &move);
+    if (aborted) {
+      break;
+    }
+    best.best_move = move;
+    best.score = score;
+    best.depth = depth;
+    best.has_move = move.from.x >= 0;
+    best.nodes = nodes;
+    root_hint = move;
+    if (on_depth) {
+      on_depth(best);
+    }
+    // Zorunlu mat bulunduysa daha derine inmeye gerek yok
+    if (std::abs(score) >= kMateScore - MoveOrdering::kMaxPly) {
+      break;
+    }
+  }
+  best.nodes = nodes;
+  limits = nullptr;
+  return best;
+}
+
+bool Search::shouldStop() {
+  if (limits == nullptr || nodes % kStopCheckInterval != 0) {
+    return false;
+  }
+  if (limits->stop.stop_requested() || std::chrono::steady_clock::now() >= limits->deadline) {
+    aborted = true;
+  }
+  return aborted;
+}
+
+int Search::negamax(const ChessBoard& board, PortalSystem& portal_system, bool is_white,
+                    int depth, int ply, int alpha, int beta, CoordinateMove* best_move) {
+  ++nodes;
+  if (aborted || shouldStop()) {
+    return 0;
+  }
+  if (depth == 0) {
+    int score = board.getEvaluation();
+    return is_white ? score : -score;
+  }
+
+  auto moves = generator.pseudoLegalMoves(board, portal_system, is_white);
+  if (ordering_enabled) {
+    ordering.order(board, portal_system, moves, ply);
+  }
+  if (ply == 0 && root_hint.from.x >= 0) {
+    auto it = std::find_if(moves.begin(), moves.end(), [this](const CoordinateMove& move) {
+      return move.from.x == root_hint.from.x && move.from.y == root_hint.from.y &&
+             move.to.x == root_hint.to.x && move.to.y == root_hint.to.y &&
+             move.promotion == root_hint.promotion;
+    });
+    if (it != moves.end()) {
+      std::rotate(moves.begin(), it, it + 1);
+    }
+  }
+
+  const std::vector<int> saved_cooldowns = portal_system.getCooldownState();
+  bool any_legal = false;
+  for (const auto& move : moves) {
+    ChessBoard next = board;
+    next.setVerbose(false);
+    generator.makeMove(next, portal_system, move);
+    if (generator.inCheck(next, portal_system, is_white)) {
+      portal_system.setCooldownState(saved_cooldowns);
+      continue;
+    }
+    any_legal = true;
+
+    int score = -negamax(next, portal_system, !is_white, depth - 1, ply + 1, -beta, -alpha,
+                         nullptr);
+    portal_system.setCooldownState(saved_cooldowns);
+    if (aborted) {
+      return 0;
+    }
+
+    if (score > alpha) {
+      alpha = score;
+      if (best_move != nullptr) {
+        *best_move = move;
+      }
+    }
+    if (alpha >= beta) {
+      if (ordering_enabled) {
+        ordering.recordCutoff(board, move, ply, depth);
+      }
+      break;
+    }
+  }
+
+  if (!any_legal) {
+    // Mat ya da pat; daha kısa matlar tercih edilir
+    return generator.inCheck(board, portal_system, is_white) ? -kMateScore + ply : 0;
+  }
+  return alpha;
+}
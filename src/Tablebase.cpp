@@ -0,0 +1,285 @@
+// Tablebase.cpp
+#include "Tablebase.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static_assert(sizeof(Tablebase::Header) == 40, "tablebase başlığı sabit boyutlu olmalı");
+
+namespace {
+
+const char kMagic[8] = {'P', 'C', 'T', 'B', '1', '\0', '\0', '\0'};
+
+const std::vector<std::pair<char, std::string>> kStandardLetters = {
+    {'K', "king"}, {'Q', "queen"}, {'R', "rook"},
+    {'B', "bishop"}, {'N', "knight"}, {'P', "pawn"}};
+
+std::string lowerCopy(const std::string& str) {
+  std::string lower = str;
+  std::transform(lower.begin(), lower.end(), lower.begin(),
+                 [](unsigned char c) { return std::tolower(c); });
+  return lower;
+}
+
+// Standart taşlar harf sırasıyla, özel taşlar onlardan sonra isimle
+int typeRank(const std::string& type) {
+  std::string lower = lowerCopy(type);
+  for (size_t i = 0; i < kStandardLetters.size(); ++i) {
+    if (kStandardLetters[i].second == lower) return static_cast<int>(i);
+  }
+  return static_cast<int>(kStandardLetters.size());
+}
+
+bool pieceBefore(const Tablebase::Piece& a, const Tablebase::Piece& b) {
+  if (a.is_white != b.is_white) return a.is_white;
+  int rank_a = typeRank(a.type);
+  int rank_b = typeRank(b.type);
+  if (rank_a != rank_b) return rank_a < rank_b;
+  return a.type < b.type;
+}
+
+bool samePiece(const Tablebase::Piece& a, const Tablebase::Piece& b) {
+  return a.is_white == b.is_white && a.type == b.type;
+}
+
+} // namespace
+
+Tablebase::Tablebase(const GameConfig& config, const std::string& directory)
+    : config(config), directory(directory) {}
+
+Tablebase::~Tablebase() {
+  for (auto& entry : tables) {
+    if (entry.second && entry.second->mapping != nullptr) {
+      munmap(entry.second->mapping, entry.second->mapping_size);
+    }
+  }
+}
+
+void Tablebase::canonicalize(Material& material) {
+  std::stable_sort(material.begin(), material.end(), pieceBefore);
+}
+
+bool Tablebase::parseSignature(const std::string& text, const GameConfig& config,
+                               Material& material) {
+  material.clear();
+  auto findType = [&config](const std::string& name, std::string& type) {
+    for (const auto* list : {&config.pieces, &config.custom_pieces}) {
+      for (const auto& piece : *list) {
+        if (lowerCopy(piece.type) == lowerCopy(name)) {
+          type = piece.type;
+          return true;
+        }
+      }
+    }
+    return false;
+  };
+
+  bool is_white = true;
+  for (size_t i = 0; i < text.size(); ++i) {
+    char c = text[i];
+    if (c == 'v') {
+      if (!is_white) return false;
+      is_white = false;
+      continue;
+    }
+    std::string name;
+    if (c == '[') {
+      size_t close = text.find(']', i);
+      if (close == std::string::npos) return false;
+      name = text.substr(i + 1, close - i - 1);
+      i = close;
+    } else {
+      for (const auto& standard : kStandardLetters) {
+        if (standard.first == c) name = standard.second;
+      }
+      if (name.empty()) return false;
+    }
+    std::string type;
+    if (!findType(name, type)) {
+      // Terfi taşları config'de olmasa da oyunda olabilir
+      if (c == '[') return false;
+      type = name;
+      type[0] = static_cast<char>(std::toupper(static_cast<unsigned char>(type[0])));
+    }
+    material.push_back({type, is_white});
+  }
+  if (is_white || material.empty()) return false;
+  canonicalize(material);
+  return true;
+}
+
+std::string Tablebase::signatureOf(const Material& material) {
+  std::string signature;
+  bool in_black = false;
+  for (const auto& piece : material) {
+    if (!piece.is_white && !in_black) {
+      signature += 'v';
+      in_black = true;
+    }
+    char letter = 0;
+    for (const auto& standard : kStandardLetters) {
+      if (standard.second == lowerCopy(piece.type)) letter = standard.first;
+    }
+    if (letter != 0) {
+      signature += letter;
+    } else {
+      signature += "[" + piece.type + "]";
+    }
+  }
+  if (!in_black) signature += 'v';
+  return signature;
+}
+
+uint64_t Tablebase::cooldownStateCount(const GameConfig& config) {
+  uint64_t states = 1;
+  for (const auto& portal : config.portals) {
+    states *= static_cast<uint64_t>(std::max(0, portal.properties.cooldown)) + 1;
+  }
+  return states;
+}
+
+uint64_t Tablebase::entryCount(const GameConfig& config, const Material& material) {
+  uint64_t square_count = static_cast<uint64_t>(config.game_settings.board_size) *
+                          config.game_settings.board_size;
+  uint64_t count = 2 * cooldownStateCount(config);
+  for (size_t i = 0; i < material.size(); ++i) {
+    count *= square_count;
+  }
+  return count;
+}
+
+void Tablebase::placementOf(const ChessBoard& board, Placement& placement) {
+  struct Found {
+    Piece piece;
+    int square;
+  };
+  std::vector<Found> found;
+  for (bool is_white : {true, false}) {
+    const auto& pieces = board.getPieces(is_white);
+    for (size_t i = 0; i < pieces.size(); ++i) {
+      found.push_back({{board.typeName(pieces.types[i]), is_white}, pieces.squares[i]});
+    }
+  }
+  // Aynı taşlar kare sırasıyla: aynı pozisyon hep aynı indekse düşer
+  std::stable_sort(found.begin(), found.end(), [](const Found& a, const Found& b) {
+    if (!samePiece(a.piece, b.piece)) return pieceBefore(a.piece, b.piece);
+    return a.square < b.square;
+  });
+  placement.material.clear();
+  placement.squares.clear();
+  for (const auto& f : found) {
+    placement.material.push_back(f.piece);
+    placement.squares.push_back(f.square);
+  }
+}
+
+uint64_t Tablebase::indexOf(const GameConfig& config, const std::vector<int>& squares,
+                            const std::vector<int>& cooldowns, bool is_white_turn) {
+  uint64_t square_count = static_cast<uint64_t>(config.game_settings.board_size) *
+                          config.game_settings.board_size;
+  uint64_t index = is_white_turn ? 0 : 1;
+  for (size_t i = 0; i < config.portals.size(); ++i) {
+    uint64_t radix = static_cast<uint64_t>(std::max(0, config.portals[i].properties.cooldown)) + 1;
+    uint64_t value = i < cooldowns.size() ? static_cast<uint64_t>(std::max(0, cooldowns[i])) : 0;
+    index = index * radix + std::min(value, radix - 1);
+  }
+  for (int square : squares) {
+    index = index * square_count + static_cast<uint64_t>(square);
+  }
+  return index;
+}
+
+uint8_t Tablebase::encode(const TablebaseResult& result) {
+  if (result.outcome == TablebaseResult::Outcome::Draw) {
+    return kDraw;
+  }
+  return static_cast<uint8_t>(result.plies_to_mate + 1);
+}
+
+bool Tablebase::decode(uint8_t value, TablebaseResult& result) {
+  if (value == kInvalid) {
+    return false;
+  }
+  if (value == kDraw) {
+    result.outcome = TablebaseResult::Outcome::Draw;
+    result.plies_to_mate = 0;
+    return true;
+  }
+  result.plies_to_mate = value - 1;
+  result.outcome = (result.plies_to_mate % 2 == 1) ? TablebaseResult::Outcome::Win
+                                                   : TablebaseResult::Outcome::Loss;
+  return true;
+}
+
+const Tablebase::MappedTable* Tablebase::table(const std::string& signature) const {
+  std::lock_guard<std::mutex> lock(tables_mutex);
+  auto it = tables.find(signature);
+  if (it != tables.end()) {
+    return it->second.get(); // bulunamayan tablolar da nullptr olarak önbellekte
+  }
+
+  std::unique_ptr<MappedTable> mapped;
+  std::string path = directory + "/" + signature + ".tb";
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd >= 0) {
+    struct stat info;
+    if (fstat(fd, &info) == 0 && static_cast<size_t>(info.st_size) >= sizeof(Header)) {
+      void* data = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (data != MAP_FAILED) {
+        const auto* header = static_cast<const Header*>(data);
+        bool valid = std::memcmp(header->magic, kMagic, sizeof(kMagic)) == 0 &&
+                     header->version == kVersion &&
+                     header->config_hash == config.config_hash &&
+                     sizeof(Header) + header->entry_count == static_cast<size_t>(info.st_size);
+        if (valid) {
+          mapped = std::make_unique<MappedTable>();
+          mapped->mapping = data;
+          mapped->mapping_size = info.st_size;
+          mapped->values = static_cast<const uint8_t*>(data) + sizeof(Header);
+          mapped->entry_count = header->entry_count;
+        } else {
+          std::cerr << "Tablebase dosyası bu config ile uyumsuz: " << path << std::endl;
+          munmap(data, info.st_size);
+        }
+      }
+    }
+    ::close(fd);
+  }
+  const MappedTable* result = mapped.get();
+  tables[signature] = std::move(mapped);
+  return result;
+}
+
+bool Tablebase::probe(const ChessBoard& board, const PortalSystem& portal_system,
+                      bool is_white_turn, TablebaseResult& result) const {
+  Placement placement;
+  placementOf(board, placement);
+  if (placement.material.size() > static_cast<size_t>(kMaxPieces)) {
+    return false;
+  }
+
+  // Sadece şahlar kaldıysa kimse şah çekemez: beraberlik
+  bool only_kings = std::all_of(placement.material.begin(), placement.material.end(),
+                                [](const Piece& piece) { return typeRank(piece.type) == 0; });
+  if (only_kings) {
+    result.outcome = TablebaseResult::Outcome::Draw;
+    result.plies_to_mate = 0;
+    return true;
+  }
+
+  const MappedTable* mapped = table(signatureOf(placement.material));
+  if (mapped == nullptr) {
+    return false;
+  }
+  uint64_t index = indexOf(config, placement.squares, portal_system.getCooldownState(),
+                           is_white_turn);
+  if (index >= mapped->entry_count) {
+    return false;
+  }
+  return decode(mapped->values[index], result);
+}
@@ -0,0 +1,416 @@
+// TablebaseGenerator.cpp
+#include "TablebaseGenerator.hpp"
+#include "MoveGenerator.hpp"
+#include "Ruleset.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+namespace {
+
+// Üretim sırasında kullanılan kodlar; dosyada 0 (bilinmeyen) beraberlik olur
+constexpr uint8_t kUnknown = 0;
+constexpr uint8_t kKnownDraw = 254;
+constexpr uint8_t kMaxCode = 253; // mata 252 yarım hamle
+constexpr uint32_t kFixedFlag = 1u << 31; // ardıl alt tabloda: düşük bayt kod
+constexpr size_t kChunkSize = 4096;
+
+struct Chunk {
+  std::vector<uint32_t> offsets; // chunk içi pozisyon başına ardıl başlangıcı
+  std::vector<uint32_t> successors;
+};
+
+// İş parçacıkları bir sonraki parçayı ortak sayaçtan alır
+template <typename Work>
+void parallelChunks(size_t chunk_count, unsigned thread_count, Work&& work) {
+  std::atomic<size_t> next{0};
+  auto worker = [&](unsigned thread_index) {
+    for (;;) {
+      size_t chunk = next.fetch_add(1);
+      if (chunk >= chunk_count) break;
+      work(thread_index, chunk);
+    }
+  };
+  std::vector<std::thread> pool;
+  for (unsigned t = 1; t < thread_count; ++t) {
+    pool.emplace_back(worker, t);
+  }
+  worker(0);
+  for (auto& thread : pool) {
+    thread.join();
+  }
+}
+
+struct ThreadContext {
+  MoveValidator validator;
+  PortalSystem portal_system;
+  MoveGenerator generator;
+  ChessBoard empty_board;
+
+  ThreadContext(const Ruleset& ruleset)
+      : portal_system(ruleset.createPortals()), generator(validator),
+        empty_board(ruleset.config.game_settings.board_size, ruleset.piece_types) {
+    validator.setVerbose(false);
+    portal_system.setVerbose(false);
+    empty_board.setVerbose(false);
+  }
+};
+
+bool sameMaterial(const Tablebase::Material& a, const Tablebase::Material& b) {
+  if (a.size() != b.size()) return false;
+  for (size_t i = 0; i < a.size(); ++i) {
+    if (a[i].type != b[i].type || a[i].is_white != b[i].is_white) return false;
+  }
+  return true;
+}
+
+// Config'te olmayan tip için isimden varsayılan (ChessBoard::TypeTable::add gibi)
+abilities::Mask abilitiesOf(const ChessBoard::TypeTable& types, const std::string& type) {
+  int type_id = types.find(type);
+  return type_id >= 0 ? types.abilities[type_id] : abilities::defaultsFor(type);
+}
+
+bool isRoyal(const ChessBoard::TypeTable& types, const std::string& type) {
+  return abilities::has(abilitiesOf(types, type), abilities::Royal);
+}
+
+bool hasBothKings(const ChessBoard::TypeTable& types, const Tablebase::Material& material) {
+  bool white = false;
+  bool black = false;
+  for (const auto& piece : material) {
+    if (isRoyal(types, piece.type)) {
+      (piece.is_white ? white : black) = true;
+    }
+  }
+  return white && black;
+}
+
+bool promotes(const ChessBoard::TypeTable& types, const std::string& type) {
+  return abilities::has(abilitiesOf(types, type), abilities::Promotion);
+}
+
+// Oyun şahı şah çeken saymaz (GameManager::isInCheck); tabloda şah da saldırır,
+// yoksa şah yalnız kaleyle mat edilemez. Yan yana şahlar: hamle yapan şahını
+// rakip şaha vermiş demektir
+bool kingsTouch(const ChessBoard& board) {
+  Position white, black;
+  if (!board.findRoyal(true, white) || !board.findRoyal(false, black)) return false;
+  return std::abs(white.x - black.x) <= 1 && std::abs(white.y - black.y) <= 1;
+}
+
+} // namespace
+
+TablebaseGenerator::TablebaseGenerator(const GameConfig& config, const std::string& directory,
+                                       unsigned thread_count)
+    : config(config), directory(directory), ruleset(Ruleset::create(config)),
+      thread_count(thread_count != 0 ? thread_count
+                                     : std::max(1u, std::thread::hardware_concurrency())) {}
+
+bool TablebaseGenerator::generate(const Tablebase::Material& material) {
+  Tablebase::Material canonical = material;
+  Tablebase::canonicalize(canonical);
+  if (canonical.size() > static_cast<size_t>(Tablebase::kMaxPieces)) {
+    std::cerr << "Tablebase en fazla " << Tablebase::kMaxPieces << " taş destekler\n";
+    return false;
+  }
+  if (!hasBothKings(*ruleset->piece_types, canonical)) {
+    std::cerr << "Malzemede iki şah da olmalı: " << Tablebase::signatureOf(canonical) << "\n";
+    return false;
+  }
+  std::filesystem::create_directories(directory);
+  return ensureSubTables(canonical) && generateTable(canonical);
+}
+
+bool TablebaseGenerator::ensureSubTables(const Tablebase::Material& material) {
+  std::vector<Tablebase::Material> needed;
+  for (size_t i = 0; i < material.size(); ++i) {
+    if (isRoyal(*ruleset->piece_types, material[i].type)) continue;
+    // Alma (portal çıkışında kendi taşının üzerine düşme dahil)
+    Tablebase::Material captured = material;
+    captured.erase(captured.begin() + i);
+    needed.push_back(captured);
+    // Terfi
+    if (promotes(*ruleset->piece_types, material[i].type)) {
+      for (const char* promoted : {"Queen", "Rook", "Bishop", "Knight"}) {
+        Tablebase::Material promotion = material;
+        promotion[i].type = promoted;
+        needed.push_back(promotion);
+      }
+    }
+  }
+
+  for (auto& sub : needed) {
+    Tablebase::canonicalize(sub);
+    bool only_kings = std::all_of(sub.begin(), sub.end(), [this](const Tablebase::Piece& piece) {
+      return isRoyal(*ruleset->piece_types, piece.type);
+    });
+    if (only_kings) continue;
+    std::string path = directory + "/" + Tablebase::signatureOf(sub) + ".tb";
+    if (std::filesystem::exists(path)) continue;
+    if (!ensureSubTables(sub) || !generateTable(sub)) return false;
+  }
+  return true;
+}
+
+bool TablebaseGenerator::generateTable(const Tablebase::Material& material) {
+  using Clock = std::chrono::steady_clock;
+  const std::string signature = Tablebase::signatureOf(material);
+  const int board_size = config.game_settings.board_size;
+  const uint64_t square_count = static_cast<uint64_t>(board_size) * board_size;
+  const uint64_t cooldown_states = Tablebase::cooldownStateCount(config);
+  const uint64_t entry_count = Tablebase::entryCount(config, material);
+
+  if (entry_count >= kFixedFlag) {
+    std::cerr << signature << ": " << entry_count << " pozisyon indekslenemeyecek kadar çok\n";
+    return false;
+  }
+  // Ortalama ardıl sayısı için kaba tahmin; pozisyon başına değer ve dosya baytı
+  // ile chunk ofseti kesin, ardıllar 1. aşamada sayılıp sınırda durulur
+  const uint64_t fixed_memory = entry_count * (2 + sizeof(uint32_t));
+  uint64_t estimated_memory = fixed_memory + entry_count * material.size() * 6 * sizeof(uint32_t);
+  if (estimated_memory > memory_limit) {
+    std::cerr << signature << ": tahmini bellek " << (estimated_memory >> 20)
+              << " MB, sınır " << (memory_limit >> 20) << " MB\n";
+    return false;
+  }
+  const uint64_t successor_limit = (memory_limit - fixed_memory) / sizeof(uint32_t);
+
+  std::cout << signature << ": " << entry_count << " pozisyon, " << thread_count
+            << " iş parçacığı" << std::endl;
+
+  std::vector<std::unique_ptr<ThreadContext>> contexts;
+  for (unsigned t = 0; t < thread_count; ++t) {
+    contexts.push_back(std::make_unique<ThreadContext>(*ruleset));
+  }
+  Tablebase sub_tables(config, directory);
+
+  std::vector<std::atomic<uint8_t>> values(entry_count);
+  size_t chunk_count = static_cast<size_t>((entry_count + kChunkSize - 1) / kChunkSize);
+  std::vector<Chunk> chunks(chunk_count);
+  std::atomic<int> max_fixed_plies{0};
+  std::atomic<uint64_t> successor_count{0};
+  std::atomic<bool> over_limit{false};
+
+  // 1. aşama: pozisyonları çöz, terminalleri işaretle, ardılları sakla
+  auto phase1_start = Clock::now();
+  parallelChunks(chunk_count, thread_count, [&](unsigned thread_index, size_t chunk_index) {
+    if (over_limit.load(std::memory_order_relaxed)) return;
+    ThreadContext& ctx = *contexts[thread_index];
+    Chunk& chunk = chunks[chunk_index];
+    uint64_t first = static_cast<uint64_t>(chunk_index) * kChunkSize;
+    uint64_t last = std::min<uint64_t>(first + kChunkSize, entry_count);
+    chunk.offsets.reserve(last - first + 1);
+    std::vector<int> squares(material.size());
+    std::vector<int> cooldowns(config.portals.size());
+    Tablebase::Placement placement;
+
+    for (uint64_t index = first; index < last; ++index) {
+      chunk.offsets.push_back(static_cast<uint32_t>(chunk.successors.size()));
+
+      // İndeksi çöz
+      uint64_t rest = index;
+      for (size_t i = material.size(); i-- > 0;) {
+        squares[i] = static_cast<int>(rest % square_count);
+        rest /= square_count;
+      }
+      uint64_t cooldown_index = rest % cooldown_states;
+      bool is_white_turn = (rest / cooldown_states) == 0;
+      for (size_t i = config.portals.size(); i-- > 0;) {
+        uint64_t radix = static_cast<uint64_t>(std::max(0, config.portals[i].properties.cooldown)) + 1;
+        cooldowns[i] = static_cast<int>(cooldown_index % radix);
+        cooldown_index /= radix;
+      }
+
+      // Geçerlilik: ayrı kareler, son sırada piyon yok, aynı taşlar kare sırasında
+      bool valid = true;
+      for (size_t i = 0; i < material.size() && valid; ++i) {
+        for (size_t j = i + 1; j < material.size() && valid; ++j) {
+          if (squares[i] == squares[j]) valid = false;
+          if (material[i].type == material[j].type &&
+              material[i].is_white == material[j].is_white && squares[i] > squares[j]) {
+            valid = false;
+          }
+        }
+        int y = squares[i] / board_size;
+        if (promotes(*ruleset->piece_types, material[i].type) &&
+            ((material[i].is_white && y == 7) || (!material[i].is_white && y == 0))) {
+          valid = false;
+        }
+      }
+      if (!valid) {
+        values[index].store(Tablebase::kInvalid, std::memory_order_relaxed);
+        continue;
+      }
+
+      ChessBoard board = ctx.empty_board;
+      for (size_t i = 0; i < material.size(); ++i) {
+        board.placePiece(material[i].type, material[i].is_white, squares[i] % board_size,
+                         squares[i] / board_size);
+      }
+      ctx.portal_system.setCooldownState(cooldowns);
+
+      // Sırası olmayan taraf şahtaysa şah alınabilir: geçersiz pozisyon
+      if (kingsTouch(board) || ctx.generator.inCheck(board, ctx.portal_system, !is_white_turn)) {
+        values[index].store(Tablebase::kInvalid, std::memory_order_relaxed);
+        continue;
+      }
+
+      bool has_move = false;
+      for (const auto& move : ctx.generator.legalMoves(board, ctx.portal_system, is_white_turn)) {
+        ChessBoard next = board;
+        ctx.portal_system.setCooldownState(cooldowns);
+        ctx.generator.makeMove(next, ctx.portal_system, move);
+        if (kingsTouch(next)) continue;
+        has_move = true;
+        Tablebase::placementOf(next, placement);
+
+        if (sameMaterial(placement.material, material)) {
+          chunk.successors.push_back(static_cast<uint32_t>(Tablebase::indexOf(
+              config, placement.squares, ctx.portal_system.getCooldownState(), !is_white_turn)));
+          continue;
+        }
+
+        // Malzeme değişti: sonuç alt tablodan; şahı kalmayan taraf mat edilemez
+        uint8_t code = kKnownDraw;
+        TablebaseResult result;
+        if (hasBothKings(*ruleset->piece_types, placement.material) &&
+            sub_tables.probe(next, ctx.portal_system, !is_white_turn, result) &&
+            result.outcome != TablebaseResult::Outcome::Draw) {
+          code = static_cast<uint8_t>(result.plies_to_mate + 1);
+          int plies = result.plies_to_mate;
+          int seen = max_fixed_plies.load();
+          while (plies > seen && !max_fixed_plies.compare_exchange_weak(seen, plies)) {
+          }
+        }
+        chunk.successors.push_back(kFixedFlag | code);
+      }
+      if (!has_move) {
+        ctx.portal_system.setCooldownState(cooldowns);
+        bool mated = ctx.generator.inCheck(board, ctx.portal_system, is_white_turn);
+        values[index].store(mated ? 1 : kKnownDraw, std::memory_order_relaxed);
+        continue;
+      }
+      values[index].store(kUnknown, std::memory_order_relaxed);
+    }
+    chunk.offsets.push_back(static_cast<uint32_t>(chunk.successors.size()));
+    if (successor_count.fetch_add(chunk.successors.size()) + chunk.successors.size() >
+        successor_limit) {
+      over_limit = true;
+    }
+  });
+  if (over_limit) {
+    std::cerr << signature << ": ardıl listeleri bellek sınırını (" << (memory_limit >> 20)
+              << " MB) aştı\n";
+    return false;
+  }
+  double phase1_seconds = std::chrono::duration<double>(Clock::now() - phase1_start).count();
+
+  // 2. aşama: n. turda sadece mata tam n yarım hamle olan pozisyonlar
+  // işaretlenir; böylece yerinde güncelleme sonucu değiştirmez
+  auto phase2_start = Clock::now();
+  int passes = 0;
+  for (int n = 1; n < kMaxCode; ++n) {
+    std::atomic<bool> changed{false};
+    parallelChunks(chunk_count, thread_count, [&](unsigned, size_t chunk_index) {
+      const Chunk& chunk = chunks[chunk_index];
+      uint64_t first = static_cast<uint64_t>(chunk_index) * kChunkSize;
+      for (size_t local = 0; local + 1 < chunk.offsets.size(); ++local) {
+        uint64_t index = first + local;
+        if (values[index].load(std::memory_order_relaxed) != kUnknown) continue;
+
+        int min_loss = -1; // ardılda sıradaki taraf kaybediyor: bizim için kazanç
+        int max_win = -1;
+        bool all_wins = true;
+        for (uint32_t s = chunk.offsets[local]; s < chunk.offsets[local + 1]; ++s) {
+          uint32_t successor = chunk.successors[s];
+          uint8_t code = (successor & kFixedFlag)
+                             ? static_cast<uint8_t>(successor & 0xFF)
+                             : values[successor].load(std::memory_order_relaxed);
+          if (code == kUnknown || code == kKnownDraw || code == Tablebase::kInvalid) {
+            all_wins = false;
+            continue;
+          }
+          int plies = code - 1;
+          if (plies % 2 == 0) {
+            all_wins = false;
+            if (min_loss < 0 || plies < min_loss) min_loss = plies;
+          } else {
+            max_win = std::max(max_win, plies);
+          }
+        }
+
+        if (min_loss >= 0 && min_loss + 1 == n) {
+          values[index].store(static_cast<uint8_t>(n + 1), std::memory_order_relaxed);
+          changed = true;
+        } else if (min_loss < 0 && all_wins && max_win + 1 == n) {
+          values[index].store(static_cast<uint8_t>(n + 1), std::memory_order_relaxed);
+          changed = true;
+        }
+      }
+    });
+    passes = n;
+    if (!changed && n > max_fixed_plies.load() + 1) break;
+  }
+  double phase2_seconds = std::chrono::duration<double>(Clock::now() - phase2_start).count();
+
+  // Dosyaya yaz: bilinmeyenler beraberlik
+  std::vector<uint8_t> bytes(entry_count);
+  uint64_t wins = 0, losses = 0, draws = 0, invalid = 0;
+  int longest = 0;
+  for (uint64_t i = 0; i < entry_count; ++i) {
+    uint8_t code = values[i].load(std::memory_order_relaxed);
+    if (code == kUnknown || code == kKnownDraw) {
+      bytes[i] = Tablebase::kDraw;
+      ++draws;
+    } else if (code == Tablebase::kInvalid) {
+      bytes[i] = Tablebase::kInvalid;
+      ++invalid;
+    } else {
+      bytes[i] = code;
+      int plies = code - 1;
+      (plies % 2 == 1 ? wins : losses)++;
+      longest = std::max(longest, plies);
+    }
+  }
+
+  Tablebase::Header header{};
+  std::memcpy(header.magic, "PCTB1", 5);
+  header.version = Tablebase::kVersion;
+  header.board_size = static_cast<uint32_t>(board_size);
+  header.config_hash = config.config_hash;
+  header.entry_count = entry_count;
+  header.piece_count = static_cast<uint32_t>(material.size());
+  header.cooldown_states = static_cast<uint32_t>(cooldown_states);
+
+  std::string path = directory + "/" + signature + ".tb";
+  std::string temp_path = path + ".tmp";
+  {
+    std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+      std::cerr << "Tablebase yazılamadı: " << path << "\n";
+      return false;
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(bytes.data()),
+              static_cast<std::streamsize>(bytes.size()));
+    if (!out) {
+      std::cerr << "Tablebase yazılamadı: " << path << "\n";
+      return false;
+    }
+  }
+  std::filesystem::rename(temp_path, path);
+
+  std::cout << signature << ": " << wins << " kazanç, " << losses << " kayıp, " << draws
+            << " beraberlik, " << invalid << " geçersiz; en uzun mat " << longest
+            << " yarım hamle; ardıl üretimi " << phase1_seconds << " s ("
+            << ((successor_count.load() * sizeof(uint32_t)) >> 20) << " MB), " << passes
+            << " tur geri yayılım " << phase2_seconds << " s" << std::endl;
+  return true;
+}
@@ -1,8 +1,20 @@
+#include "Analyzer.hpp"
+#include "BatchAnalyzer.hpp"
 #include "ChessBoard.hpp"
 #include "ConfigReader.hpp"
 #include "MoveValidator.hpp"
 #include "PortalSystem.hpp"
 #include "GameManager.hpp"
+#include "BoardRenderer.hpp"
+#include "ConfigWatcher.hpp"
+#include "EngineProtocol.hpp"
+#include "Evaluation.hpp"
+#include "GameDatabase.hpp"
+#include "MateSolver.hpp"
+#include "OpeningBook.hpp"
+#include "Tablebase.hpp"
+#include "Zobrist.hpp"
+#include <fstream>
 #include <iostream>
 #include <string>
 #include <sstream>
@@ -37,7 +49,8 @@ bool parsePosition(const std::string& pos_str, Position& pos, int board_size) {
 // Komut satırı girişi
 bool processMoveCommand(const std::string& command, ChessBoard& board, 
                         MoveValidator& validator, PortalSystem& portal_system, 
-                        GameManager& game_manager, bool is_white_turn) {
+                        GameManager& game_manager, BoardRenderer& renderer,
+                        bool is_white_turn) {
   std::istringstream iss(command);
   std::string cmd, start_str, end_str, piece;
   iss >> cmd >> start_str >> end_str >> piece;
@@ -80,7 +93,7 @@ bool processMoveCommand(const std::string& command, ChessBoard& board,
   if (validator.isValidMove(piece, start, end, start_square.is_white, board, portal_system)) {
     board.movePiece(start, end, validator, portal_system, game_manager);
     std::cout << "Hareket başarılı: " << start_str << " -> " << end_str << "\n";
-    board.printBoard();
+    renderer.render(board);
     return true;
   } else {
     std::cout << "Geçersiz hareket: " << piece << " için " << start_str << " -> " << end_str << "\n";
@@ -94,14 +107,63 @@ int main(int argc, char* argv[]) {
     return 1;
   }
 
-  std::string config_file = (argc > 1) ? argv[1] : "data/chess_pieces.json";
+  // Konumsal argümanlar: config dosyası, gösterim; seçenekler: --book, --tablebase, --games,
+  // --ponder, --watch (config değişince yeni oyunlar yeni kurallarla başlar), toplu analiz
+  // için --batch <dosya> [--depth N] [--movetime ms] [--threads N], GUI'ler için --protocol
+  // (UCI benzeri satır protokolü)
+  std::vector<std::string> positional;
+  std::string batch_file;
+  BatchAnalyzer::Options batch_options;
+  std::string book_file;
+  std::string games_file;
+  std::string tablebase_dir;
+  bool ponder_enabled = false;
+  bool watch_config = false;
+  bool protocol_mode = false;
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg == "--ponder") {
+      ponder_enabled = true;
+    } else if (arg == "--watch") {
+      watch_config = true;
+    } else if (arg == "--protocol") {
+      protocol_mode = true;
+    } else if (arg == "--book" && i + 1 < argc) {
+      book_file = argv[++i];
+    } else if (arg == "--tablebase" && i + 1 < argc) {
+      tablebase_dir = argv[++i];
+    } else if (arg == "--games" && i + 1 < argc) {
+      games_file = argv[++i];
+    } else if (arg == "--batch" && i + 1 < argc) {
+      batch_file = argv[++i];
+    } else if ((arg == "--depth" || arg == "--movetime" || arg == "--threads") && i + 1 < argc) {
+      int value = 0;
+      try {
+        value = std::stoi(argv[++i]);
+      } catch (...) {
+        value = -1;
+      }
+      if (value < 0) {
+        std::cerr << "Geçersiz değer: " << arg << " " << argv[i] << "\n";
+        return 1;
+      }
+      if (arg == "--depth") batch_options.depth = value;
+      if (arg == "--movetime") batch_options.movetime = std::chrono::milliseconds(value);
+      if (arg == "--threads") batch_options.threads = static_cast<unsigned>(value);
+    } else {
+      positional.push_back(arg);
+    }
+  }
+
+  std::string config_file = !positional.empty() ? positional[0] : "data/chess_pieces.json";
   ConfigReader config_reader;
   if (!config_reader.loadFromFile(config_file)) {
     std::cerr << "Yapılandırma dosyası yüklenemedi\n";
     return 1;
   }
 
-  std::string display_format = (argc > 2 && std::string(argv[2]) == "simple") ? "simple" : "detailed";
+  // Gösterim: detailed (varsayılan), simple, ansi (sadece değişen kareler), none (headless)
+  std::string display_format = positional.size() > 1 ? positional[1] : "detailed";
   int board_size = config_reader.getConfig().game_settings.board_size;
   
   if (board_size <= 0 || board_size > 26) {
@@ -109,50 +171,319 @@ int main(int argc, char* argv[]) {
     return 1;
   }
 
-  ChessBoard board(board_size, display_format);
-  board.initializeBoard(config_reader.getConfig().pieces);
+  // Toplu analiz: pozisyon başına bir JSON satırı stdout'a, özet stderr'e
+  if (!batch_file.empty()) {
+    std::ifstream batch_input(batch_file);
+    if (!batch_input.is_open()) {
+      std::cerr << "Pozisyon dosyası açılamadı: " << batch_file << "\n";
+      return 1;
+    }
+    std::shared_ptr<const Ruleset> batch_rules = Ruleset::create(config_reader.getConfig());
+    BatchAnalyzer batch(batch_rules->config, batch_rules->evaluation, batch_rules->network);
+    auto stats = batch.run(batch_input, std::cout, batch_options);
+    std::cerr << stats.positions << " pozisyon (" << stats.errors << " hatalı), "
+              << stats.threads << " thread, " << stats.elapsed_ms << " ms; bekleme: okuma "
+              << stats.reader_blocked_ms << " ms, analiz boşta " << stats.workers_idle_ms
+              << " ms, analiz çıktıda " << stats.workers_blocked_ms << " ms, yazma "
+              << stats.writer_idle_ms << " ms\n";
+    return stats.errors == 0 ? 0 : 1;
+  }
+
+  // Oyun, başladığı andaki kural setini bitene kadar kullanır
+  std::shared_ptr<const Ruleset> ruleset = Ruleset::create(config_reader.getConfig());
+
+  // Motor protokolü: stdout yalnızca protokol satırları taşır
+  if (protocol_mode) {
+    EngineProtocol protocol(config_file, ruleset);
+    return protocol.run();
+  }
+  ChessBoard board = ruleset->createBoard(display_format);
   MoveValidator validator;
-  PortalSystem portal_system(config_reader.getConfig().portals);
+  PortalSystem portal_system = ruleset->createPortals();
   GameManager game_manager(board, validator, portal_system);
+  game_manager.setTurnLimit(ruleset->config.game_settings.turn_limit);
+  BoardRenderer renderer(BoardRenderer::modeFromString(display_format));
+  renderer.registerPieceTypes(ruleset->config);
+
+  // İsteğe bağlı açılış kitabı
+  OpeningBook book;
+  if (!book_file.empty() && book.open(book_file, ruleset->config.config_hash)) {
+    std::cout << "Açılış kitabı yüklendi (" << book.size() << " giriş)\n";
+  }
+
+  // İsteğe bağlı oyun sonu tabloları: kapsanan pozisyonlarda oyun anında sonuçlanır
+  std::unique_ptr<Tablebase> tablebase;
+  if (!tablebase_dir.empty()) {
+    tablebase = std::make_unique<Tablebase>(ruleset->config, tablebase_dir);
+    game_manager.setTablebase(tablebase.get());
+  }
+
+  // İsteğe bağlı oyun deposu: biten (veya yarıda bırakılan) oyun sona eklenir
+  GameDatabase::Writer game_writer(1);
+  if (!games_file.empty()) {
+    game_writer.open(games_file);
+  }
+  auto recordGame = [&](GameDatabase::Result result, const std::string& termination) {
+    std::vector<CoordinateMove> moves = GameDatabase::movesFromHistory(game_manager);
+    if (!game_writer.isOpen() || moves.empty()) return;
+    GameDatabase::GameRecord record;
+    record.config_hash = ruleset->config.config_hash;
+    record.board_size = ruleset->config.game_settings.board_size;
+    record.result = result;
+    record.moves = std::move(moves);
+    record.metadata = {{"Event", ruleset->config.game_settings.name},
+                       {"Termination", termination}};
+    game_writer.append(record);
+  };
+
+  // Arka plan analizi: girdi beklenirken düşünür, go/stop ile sorgulanır
+  Analyzer analyzer(ruleset->evaluation);
+  auto startPondering = [&](bool is_white) {
+    if (ponder_enabled) {
+      analyzer.ponder(board, portal_system, is_white);
+    } else {
+      analyzer.cancel();
+    }
+  };
+
+  // Config izleme: yeni kurallar çalışan oyunu etkilemez, "new" ile başlayan oyunda geçerli
+  ConfigWatcher watcher(config_file, ruleset);
+  if (watch_config) {
+    watcher.start([](const std::shared_ptr<const Ruleset>& next, const ConfigDiff& diff,
+                     const std::string& error) {
+      std::ostringstream out;
+      if (!next) {
+        out << "\n" << error << "\n";
+      } else {
+        out << "\nConfig yeniden yüklendi (sürüm " << next->generation
+            << "): " << diff.summary() << ". Yeni kurallar \"new\" ile başlayan oyunda geçerli.\n";
+      }
+      std::cout << out.str();
+      std::cout.flush();
+    });
+  }
+
+  // Yeni oyun en son yayınlanan kural setiyle başlar; kurallar değiştiyse
+  // başka bir config'e bağlı kitap ve tablolar bırakılır
+  auto startNewGame = [&]() {
+    std::shared_ptr<const Ruleset> next = watcher.current();
+    int next_size = next->config.game_settings.board_size;
+    if (next_size <= 0 || next_size > 26) {
+      std::cout << "Yeni config'in tahta boyutu geçersiz; önceki kurallarla devam ediliyor.\n";
+      next = ruleset;
+    }
+    if (next->config.config_hash != ruleset->config.config_hash) {
+      if (book.isOpen()) {
+        book.close();
+        std::cout << "Açılış kitabı eski config için; kapatıldı.\n";
+      }
+      if (tablebase) {
+        game_manager.setTablebase(nullptr);
+        tablebase.reset();
+        std::cout << "Oyun sonu tabloları eski config için; kapatıldı.\n";
+      }
+    }
+    ruleset = next;
+    board = ruleset->createBoard(display_format);
+    portal_system = ruleset->createPortals();
+    game_manager.clearHistory();
+    game_manager.setTurnLimit(ruleset->config.game_settings.turn_limit);
+    game_manager.evaluateStatus(true);
+    renderer.registerPieceTypes(ruleset->config);
+    renderer.invalidate();
+    analyzer.setEvaluation(ruleset->evaluation);
+  };
 
   std::cout << "Başlangıç tahtası:\n";
-  board.printBoard();
-  std::cout << "Komutlar: move <başlangıç> <hedef> <taş> (ör. move a1 b2 king), undo, quit\n";
+  renderer.render(board);
+  std::cout << "Komutlar: move <başlangıç> <hedef> <taş> (ör. move a1 b2 king), undo, eval, book, "
+               "go [movetime <ms>], stop, mate <N> [ms], new, quit\n";
 
   bool is_white_turn = true;
+  // Başlangıç pozisyonu da tekrar sayımına girer
+  game_manager.evaluateStatus(is_white_turn);
+  startPondering(is_white_turn);
   std::string command;
   while (true) {
     std::cout << (is_white_turn ? "Beyaz" : "Siyah") << " oyuncunun sırası > ";
     std::cout.flush();
     
     if (!std::getline(std::cin, command)) {
+      recordGame(GameDatabase::Result::Unknown, "unterminated");
       break;
     }
 
     if (command == "quit") {
+      analyzer.cancel();
+      recordGame(GameDatabase::Result::Unknown, "abandoned");
       std::cout << "Oyun sona erdi.\n";
       break;
     }
 
+    if (command == "new") {
+      analyzer.cancel();
+      recordGame(GameDatabase::Result::Unknown, "abandoned");
+      startNewGame();
+      std::cout << "Yeni oyun:\n";
+      renderer.render(board);
+      is_white_turn = true;
+      startPondering(is_white_turn);
+      continue;
+    }
+
+    if (command.rfind("go", 0) == 0 && (command.size() == 2 || command[2] == ' ')) {
+      std::istringstream iss(command.substr(2));
+      std::string option;
+      long long movetime = 0;
+      if (iss >> option && (option != "movetime" || !(iss >> movetime) || movetime < 0)) {
+        std::cout << "Geçersiz komut. Örnek: go movetime 1000\n";
+        continue;
+      }
+      ChessBoard position = board;
+      analyzer.go(board, portal_system, is_white_turn, std::chrono::milliseconds(movetime),
+                  [position, &validator](const SearchResult& result, bool from_cache) {
+                    std::ostringstream out;
+                    if (!result.has_move) {
+                      out << "\nAnaliz: yasal hamle bulunamadı.\n";
+                    } else {
+                      out << "\nEn iyi hamle: " << formatCoordinateMove(result.best_move)
+                          << " (derinlik " << result.depth << ", skor " << result.score << ", "
+                          << result.nodes << " düğüm" << (from_cache ? ", önbellekten" : "")
+                          << ")\nÖneri: move " << squareToText(result.best_move.from) << " "
+                          << squareToText(result.best_move.to) << " "
+                          << validator.toLowerCase(position.getSquare(result.best_move.from).piece)
+                          << "\n";
+                    }
+                    std::cout << out.str();
+                    std::cout.flush();
+                  });
+      if (movetime == 0) {
+        std::cout << "Analiz başladı; durdurmak için stop.\n";
+      }
+      continue;
+    }
+
+    if (command == "stop") {
+      if (!analyzer.isSearching()) {
+        std::cout << "Çalışan analiz yok.\n";
+        continue;
+      }
+      analyzer.stop();
+      startPondering(is_white_turn);
+      continue;
+    }
+
+    if (command.rfind("mate", 0) == 0 && (command.size() == 4 || command[4] == ' ')) {
+      std::istringstream iss(command.substr(4));
+      int moves = 0;
+      long long movetime = 0;
+      if (!(iss >> moves) || moves <= 0 || ((iss >> movetime) && movetime < 0)) {
+        std::cout << "Geçersiz komut. Örnek: mate 3 [5000]\n";
+        continue;
+      }
+      // Çözücü aynı thread'de koşar; analiz bu sürede durur
+      analyzer.cancel();
+      MateSolver::Limits limits;
+      if (movetime > 0) {
+        limits.deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(movetime);
+      }
+      MateSolver solver;
+      MateSolver::Result result = solver.solve(board, portal_system, is_white_turn, moves, limits);
+      if (result.outcome == MateSolver::Outcome::Mate) {
+        std::cout << result.moves << " hamlede mat:";
+        for (const auto& move : result.line) std::cout << " " << formatCoordinateMove(move);
+        std::cout << "\n";
+      } else if (result.outcome == MateSolver::Outcome::NoMate) {
+        std::cout << moves << " hamlede şah çekerek mat yok.\n";
+      } else {
+        std::cout << "Süre doldu; " << result.moves << " hamleye kadar mat yok.\n";
+      }
+      std::cout << "(" << result.nodes << " düğüm, " << static_cast<long long>(result.elapsed_ms)
+                << " ms)\n";
+      startPondering(is_white_turn);
+      continue;
+    }
+
+    if (command == "eval") {
+      std::cout << "Değerlendirme (beyazın bakışıyla): " << board.getEvaluation() << "\n";
+      continue;
+    }
+
+    if (command == "book") {
+      if (!book.isOpen()) {
+        std::cout << "Açılış kitabı yüklü değil.\n";
+        continue;
+      }
+      uint64_t key = zobrist::positionKey(board.getHash(), portal_system.stateHash(), is_white_turn);
+      auto entries = book.lookup(key);
+      if (entries.empty()) {
+        std::cout << "Bu pozisyon kitapta yok.\n";
+        continue;
+      }
+      std::cout << "Kitap hamleleri:";
+      for (const auto& entry : entries) {
+        std::cout << " " << formatCoordinateMove(book.toMove(entry)) << " (" << entry.count << ")";
+      }
+      CoordinateMove best = book.toMove(entries.front());
+      std::cout << "\nÖneri: move " << squareToText(best.from) << " " << squareToText(best.to)
+                << " " << validator.toLowerCase(board.getSquare(best.from).piece) << "\n";
+      continue;
+    }
+
     if (command == "undo") {
+      analyzer.cancel();
       game_manager.undoMove();
-      board.printBoard();
+      renderer.render(board);
       is_white_turn = !is_white_turn;
+      startPondering(is_white_turn);
       continue;
     }
 
     if (!command.empty()) {
-      if (processMoveCommand(command, board, validator, portal_system, game_manager, is_white_turn)) {
-        if (game_manager.isCheckmate(!is_white_turn)) {
+      // Tahta değişeceği için çalışan analiz sonucu yazılmadan iptal edilir
+      analyzer.cancel();
+      if (processMoveCommand(command, board, validator, portal_system, game_manager, renderer,
+                             is_white_turn)) {
+        GameDatabase::Result mover_result =
+            is_white_turn ? GameDatabase::Result::WhiteWins : GameDatabase::Result::BlackWins;
+        using Outcome = GameManager::GameStatus::Outcome;
+        const auto& status = game_manager.evaluateStatus(!is_white_turn);
+        if (status.outcome == Outcome::Checkmate) {
+          recordGame(mover_result, "checkmate");
           std::cout << (is_white_turn ? "Beyaz" : "Siyah") << " şah mat yaptı! Oyun bitti.\n";
           break;
         }
-        if (game_manager.isStalemate(!is_white_turn)) {
+        if (status.isOver()) {
+          const char* reason = status.outcome == Outcome::Stalemate    ? "stalemate"
+                               : status.outcome == Outcome::Repetition ? "repetition"
+                                                                       : "turn limit";
+          recordGame(GameDatabase::Result::Draw, reason);
+          if (status.outcome == Outcome::Repetition) {
+            std::cout << "Aynı pozisyon üç kez tekrarlandı. ";
+          } else if (status.outcome == Outcome::TurnLimit) {
+            std::cout << "Tur sınırına ulaşıldı. ";
+          }
           std::cout << "Oyun berabere bitti.\n";
           break;
         }
+        TablebaseResult tb_result;
+        if (game_manager.probeTablebase(!is_white_turn, tb_result)) {
+          bool mover_wins = tb_result.outcome == TablebaseResult::Outcome::Loss;
+          if (tb_result.outcome == TablebaseResult::Outcome::Draw) {
+            recordGame(GameDatabase::Result::Draw, "tablebase");
+            std::cout << "Oyun sonu tablosu: pozisyon berabere. Oyun berabere bitti.\n";
+          } else {
+            recordGame(is_white_turn == mover_wins ? GameDatabase::Result::WhiteWins
+                                                   : GameDatabase::Result::BlackWins,
+                       "tablebase");
+            std::cout << "Oyun sonu tablosu: " << ((is_white_turn == mover_wins) ? "Beyaz" : "Siyah")
+                      << " " << tb_result.plies_to_mate << " yarım hamlede mat eder. Oyun bitti.\n";
+          }
+          break;
+        }
         is_white_turn = !is_white_turn;
       }
+      startPondering(is_white_turn);
     } else {
       std::cout << "Boş komut. Örnek: move a1 b2 king\n";
     }
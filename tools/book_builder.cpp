@@ -0,0 +1,117 @@
+// book_builder.cpp
+// Kayıtlı hamle listelerinden ikili açılış kitabı üretir.
+// Kullanım: book_builder <config.json> <oyunlar.txt> <çıktı.book> [maksimum yarım hamle]
+// Oyun dosyası: her satır bir oyun, hamleler koordinat notasyonunda
+// ("e2e4 e7e5 g1f3"), '#' ile başlayan satırlar yok sayılır.
+#include "ChessBoard.hpp"
+#include "ConfigReader.hpp"
+#include "GameManager.hpp"
+#include "MoveNotation.hpp"
+#include "MoveValidator.hpp"
+#include "OpeningBook.hpp"
+#include "PortalSystem.hpp"
+#include "Zobrist.hpp"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace {
+
+// Oyunu baştan oynatır, her pozisyon için bir kitap girişi ekler.
+// Geçersiz hamlede durur ve o ana kadarki girişleri tutar.
+int replayGame(const GameConfig& config, const std::string& line, int max_ply,
+               int line_number, std::vector<OpeningBook::Entry>& entries) {
+  int size = config.game_settings.board_size;
+  std::vector<PieceConfig> all_pieces = config.pieces;
+  all_pieces.insert(all_pieces.end(), config.custom_pieces.begin(), config.custom_pieces.end());
+
+  ChessBoard board(size);
+  board.initializeBoard(all_pieces);
+  board.setVerbose(false);
+  MoveValidator validator;
+  validator.setVerbose(false);
+  PortalSystem portal_system(config.portals);
+  portal_system.setVerbose(false);
+  GameManager game_manager(board, validator, portal_system);
+
+  std::istringstream iss(line);
+  std::string token;
+  bool is_white_turn = true;
+  int ply = 0;
+  while (ply < max_ply && iss >> token) {
+    CoordinateMove move;
+    if (!parseCoordinateMove(token, size, move)) {
+      std::cerr << "Satır " << line_number << ": hamle okunamadı: " << token << "\n";
+      break;
+    }
+    const auto& square = board.getSquare(move.from);
+    if (square.is_empty() || square.is_white != is_white_turn ||
+        !validator.isValidMove(square.piece, move.from, move.to, is_white_turn, board,
+                               portal_system)) {
+      std::cerr << "Satır " << line_number << ": geçersiz hamle: " << token << "\n";
+      break;
+    }
+
+    OpeningBook::Entry entry{};
+    entry.key = zobrist::positionKey(board.getHash(), portal_system.stateHash(), is_white_turn);
+    entry.from = static_cast<uint16_t>(move.from.y * size + move.from.x);
+    entry.to = static_cast<uint16_t>(move.to.y * size + move.to.x);
+    entry.count = 1;
+    entry.promotion = move.promotion;
+    entries.push_back(entry);
+
+    std::string promotion = promotionPieceName(move.promotion);
+    board.movePiece(move.from, move.to, validator, portal_system, game_manager,
+                    promotion.empty() ? "Queen" : promotion);
+    is_white_turn = !is_white_turn;
+    ++ply;
+  }
+  return ply;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  if (argc < 4) {
+    std::cerr << "Kullanım: " << argv[0]
+              << " <config.json> <oyunlar.txt> <çıktı.book> [maksimum yarım hamle]\n";
+    return 1;
+  }
+  int max_ply = (argc > 4) ? std::stoi(argv[4]) : 24;
+
+  ConfigReader config_reader;
+  if (!config_reader.loadFromFile(argv[1])) {
+    std::cerr << "Yapılandırma dosyası yüklenemedi\n";
+    return 1;
+  }
+  const GameConfig& config = config_reader.getConfig();
+
+  std::ifstream games(argv[2]);
+  if (!games.is_open()) {
+    std::cerr << "Oyun dosyası açılamadı: " << argv[2] << "\n";
+    return 1;
+  }
+
+  std::vector<OpeningBook::Entry> entries;
+  std::string line;
+  int line_number = 0;
+  int game_count = 0;
+  while (std::getline(games, line)) {
+    ++line_number;
+    if (line.empty() || line[0] == '#') continue;
+    replayGame(config, line, max_ply, line_number, entries);
+    ++game_count;
+  }
+
+  if (!OpeningBook::write(argv[3], config.config_hash, config.game_settings.board_size,
+                          entries)) {
+    return 1;
+  }
+  OpeningBook book;
+  if (!book.open(argv[3], config.config_hash)) {
+    return 1;
+  }
+  std::cout << game_count << " oyundan " << entries.size() << " pozisyon okundu, "
+            << book.size() << " kitap girişi yazıldı: " << argv[3] << "\n";
+  return 0;
+}
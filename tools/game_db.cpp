@@ -0,0 +1,203 @@
+// game_db.cpp
+// Oyun deposu aracı: metin kayıtlarını içe aktarır, pozisyon indeksini kurar,
+// pozisyona ulaşan oyunları bulur ve PGN biçiminde dışa aktarır.
+// Kullanım:
+//   game_db import <config.json> <oyunlar.txt> <depo.games>
+//   game_db index  <config.json> <depo.games> [indeks]
+//   game_db find   <config.json> <depo.games> [hamleler...]
+//   game_db export <depo.games> [oyun numarası]
+// İndeks dosyası verilmezse "<depo.games>.idx" kullanılır. Oyun dosyası
+// book_builder ile aynı biçimdedir: her satır bir oyun, koordinat notasyonu.
+#include "ChessBoard.hpp"
+#include "ConfigReader.hpp"
+#include "GameDatabase.hpp"
+#include "MoveGenerator.hpp"
+#include "MoveNotation.hpp"
+#include "MoveValidator.hpp"
+#include "PortalSystem.hpp"
+#include "Zobrist.hpp"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace {
+
+void usage(const char* program) {
+  std::cerr << "Kullanım:\n"
+            << "  " << program << " import <config.json> <oyunlar.txt> <depo.games>\n"
+            << "  " << program << " index <config.json> <depo.games> [indeks]\n"
+            << "  " << program << " find <config.json> <depo.games> [hamleler...]\n"
+            << "  " << program << " export <depo.games> [oyun numarası]\n";
+}
+
+bool loadConfig(const char* path, ConfigReader& reader) {
+  if (!reader.loadFromFile(path)) {
+    std::cerr << "Yapılandırma dosyası yüklenemedi\n";
+    return false;
+  }
+  return true;
+}
+
+int importGames(const GameConfig& config, const std::string& games_path,
+                const std::string& db_path) {
+  std::ifstream games(games_path);
+  if (!games.is_open()) {
+    std::cerr << "Oyun dosyası açılamadı: " << games_path << "\n";
+    return 1;
+  }
+  GameDatabase::Writer writer(1024);
+  if (!writer.open(db_path)) {
+    return 1;
+  }
+
+  int size = config.game_settings.board_size;
+  std::string line;
+  int line_number = 0;
+  int imported = 0;
+  while (std::getline(games, line)) {
+    ++line_number;
+    if (line.empty() || line[0] == '#') continue;
+    GameDatabase::GameRecord record;
+    record.config_hash = config.config_hash;
+    record.board_size = size;
+    record.metadata = {{"Event", config.game_settings.name},
+                       {"Source", games_path + ":" + std::to_string(line_number)}};
+    std::istringstream iss(line);
+    std::string token;
+    while (iss >> token) {
+      CoordinateMove move;
+      if (!parseCoordinateMove(token, size, move)) {
+        std::cerr << "Satır " << line_number << ": hamle okunamadı: " << token << "\n";
+        break;
+      }
+      record.moves.push_back(move);
+    }
+    if (!writer.append(record)) {
+      return 1;
+    }
+    ++imported;
+  }
+  if (!writer.flush()) {
+    return 1;
+  }
+  std::cout << imported << " oyun eklendi: " << db_path << "\n";
+  return 0;
+}
+
+int findGames(const GameConfig& config, GameDatabase& database, int argc, char* argv[]) {
+  int size = config.game_settings.board_size;
+  std::vector<PieceConfig> all_pieces = config.pieces;
+  all_pieces.insert(all_pieces.end(), config.custom_pieces.begin(), config.custom_pieces.end());
+  ChessBoard board(size);
+  board.initializeBoard(all_pieces);
+  board.setVerbose(false);
+  MoveValidator validator;
+  validator.setVerbose(false);
+  PortalSystem portal_system(config.portals);
+  portal_system.setVerbose(false);
+  MoveGenerator generator(validator);
+
+  bool is_white_turn = true;
+  for (int i = 0; i < argc; ++i) {
+    CoordinateMove move;
+    if (!parseCoordinateMove(argv[i], size, move) ||
+        board.getSquare(move.from).is_empty() ||
+        board.getSquare(move.from).is_white != is_white_turn) {
+      std::cerr << "Geçersiz hamle: " << argv[i] << "\n";
+      return 1;
+    }
+    if (!generator.tryMakeMove(board, portal_system, move)) {
+      std::cerr << "Geçersiz hamle: " << argv[i] << "\n";
+      return 1;
+    }
+    is_white_turn = !is_white_turn;
+  }
+
+  uint64_t key = zobrist::positionKey(board.getHash(), portal_system.stateHash(), is_white_turn);
+  auto games = database.gamesReaching(key);
+  std::cout << games.size() << " oyun bu pozisyona ulaştı\n";
+  for (const auto& entry : games) {
+    auto view = database.game(entry.game);
+    std::cout << "oyun " << entry.game << ", yarım hamle " << entry.ply << ", sonuç "
+              << GameDatabase::resultText(static_cast<GameDatabase::Result>(view.header->result));
+    if (entry.ply < view.moves.size()) {
+      std::cout << ", devam "
+                << formatCoordinateMove(GameDatabase::unpackMove(view.moves[entry.ply], size));
+    }
+    std::cout << "\n";
+  }
+  return 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  if (argc < 3) {
+    usage(argv[0]);
+    return 1;
+  }
+  std::string command = argv[1];
+
+  if (command == "export") {
+    GameDatabase database;
+    if (!database.open(argv[2])) {
+      return 1;
+    }
+    if (argc > 3) {
+      size_t id = std::stoul(argv[3]);
+      if (id >= database.size()) {
+        std::cerr << "Depoda " << database.size() << " oyun var\n";
+        return 1;
+      }
+      std::cout << database.toPgn(id);
+      return 0;
+    }
+    for (size_t id = 0; id < database.size(); ++id) {
+      if (id > 0) std::cout << "\n";
+      std::cout << database.toPgn(id);
+    }
+    return 0;
+  }
+
+  if (argc < 4) {
+    usage(argv[0]);
+    return 1;
+  }
+  ConfigReader config_reader;
+  if (!loadConfig(argv[2], config_reader)) {
+    return 1;
+  }
+  const GameConfig& config = config_reader.getConfig();
+
+  if (command == "import") {
+    if (argc < 5) {
+      usage(argv[0]);
+      return 1;
+    }
+    return importGames(config, argv[3], argv[4]);
+  }
+
+  GameDatabase database;
+  if (!database.open(argv[3])) {
+    return 1;
+  }
+
+  if (command == "index") {
+    std::string index_path = argc > 4 ? argv[4] : std::string(argv[3]) + ".idx";
+    if (!database.writeIndex(index_path, config) || !database.openIndex(index_path)) {
+      return 1;
+    }
+    std::cout << database.size() << " oyun indekslendi: " << index_path << "\n";
+    return 0;
+  }
+
+  if (command == "find") {
+    if (!database.openIndex(std::string(argv[3]) + ".idx")) {
+      return 1;
+    }
+    return findGames(config, database, argc - 4, argv + 4);
+  }
+
+  usage(argv[0]);
+  return 1;
+}
@@ -0,0 +1,51 @@
+// nnue_build.cpp
+// Config'in taş tipleri ve tahta boyutu için NNUE ağ dosyası üretir. Taş-kare
+// kısmı config'in değerlendirme tablolarından alınır, yoğun katmanlar seed'den
+// küçük rastgele değerlerle doldurulur. Çıkış ölçeği 0 iken ağ el yapımı
+// değerlendirmeyi birebir verir: eğitim için başlangıç noktasıdır.
+// Config'e "evaluation": {"nnue": "<dosya>"} eklenince oyun ve motor bu ağı kullanır.
+// Kullanım: nnue_build <config.json> <çıktı.nnue> [hidden] [dense] [seed] [çıkış ölçeği]
+#include "ConfigReader.hpp"
+#include "Nnue.hpp"
+#include "Ruleset.hpp"
+#include <iostream>
+#include <string>
+
+int main(int argc, char* argv[]) {
+  if (argc < 3) {
+    std::cerr << "Kullanım: nnue_build <config.json> <çıktı.nnue> [hidden] [dense] [seed] "
+                 "[çıkış ölçeği]\n";
+    return 1;
+  }
+  int hidden = (argc > 3) ? std::stoi(argv[3]) : 256;
+  int dense = (argc > 4) ? std::stoi(argv[4]) : 32;
+  uint64_t seed = (argc > 5) ? std::stoull(argv[5]) : 1;
+  int output_scale = (argc > 6) ? std::stoi(argv[6]) : 0;
+
+  ConfigReader config_reader;
+  if (!config_reader.loadFromFile(argv[1])) {
+    std::cerr << "Yapılandırma dosyası yüklenemedi\n";
+    return 1;
+  }
+  GameConfig config = config_reader.getConfig();
+  // Üretilen dosya bu config'te zaten adı geçen ağı değiştirebilir; yüklenmez
+  config.evaluation.nnue_file.clear();
+  std::shared_ptr<const Ruleset> ruleset = Ruleset::create(config);
+
+  auto weights = NnueNetwork::initialWeights(*ruleset->evaluation, ruleset->piece_types->names,
+                                             hidden, dense, seed, output_scale);
+  std::string error;
+  if (!NnueNetwork::write(argv[2], weights, error)) {
+    std::cerr << error << "\n";
+    return 1;
+  }
+  auto network = NnueNetwork::open(argv[2], config.game_settings.board_size, error);
+  if (!network) {
+    std::cerr << error << "\n";
+    return 1;
+  }
+  std::cout << argv[2] << ": " << weights.types.size() << " tip, " << network->inputCount()
+            << " girdi, " << hidden << " birikeç, " << dense << "x" << dense << " yoğun, "
+            << network->fileSize() / 1024 << " KB\n";
+  return 0;
+}
@@ -0,0 +1,55 @@
+// tb_generate.cpp
+// Portal varyantları için oyun sonu tabloları üretir.
+// Kullanım: tb_generate <config.json> <çıktı dizini> <malzeme>... [--threads N] [--memory-mb M]
+// Malzeme örnekleri: KQvK, KRvK, KPvK, K[Wizard]vK
+#include "ConfigReader.hpp"
+#include "Tablebase.hpp"
+#include "TablebaseGenerator.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main(int argc, char* argv[]) {
+  if (argc < 4) {
+    std::cerr << "Kullanım: " << argv[0]
+              << " <config.json> <çıktı dizini> <malzeme>... [--threads N] [--memory-mb M]\n";
+    return 1;
+  }
+
+  ConfigReader config_reader;
+  if (!config_reader.loadFromFile(argv[1])) {
+    std::cerr << "Yapılandırma dosyası yüklenemedi\n";
+    return 1;
+  }
+  const GameConfig& config = config_reader.getConfig();
+
+  unsigned threads = 0;
+  uint64_t memory_mb = 0;
+  std::vector<std::string> signatures;
+  for (int i = 3; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg == "--threads" && i + 1 < argc) {
+      threads = static_cast<unsigned>(std::stoul(argv[++i]));
+    } else if (arg == "--memory-mb" && i + 1 < argc) {
+      memory_mb = std::stoull(argv[++i]);
+    } else {
+      signatures.push_back(arg);
+    }
+  }
+
+  TablebaseGenerator generator(config, argv[2], threads);
+  if (memory_mb != 0) {
+    generator.setMemoryLimit(memory_mb << 20);
+  }
+  for (const auto& signature : signatures) {
+    Tablebase::Material material;
+    if (!Tablebase::parseSignature(signature, config, material)) {
+      std::cerr << "Malzeme okunamadı: " << signature << "\n";
+      return 1;
+    }
+    if (!generator.generate(material)) {
+      return 1;
+    }
+  }
+  return 0;
+}